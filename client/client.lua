@@ -28,6 +28,7 @@ project "client"
     links
     {
         "common",
+        "common_networking",
         "DearImGui",
         "GLFW",
         "GLAD"
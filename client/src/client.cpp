@@ -14,9 +14,11 @@
 #include <common/assets/asset_manager.h>
 
 #include <common/graphics/screen_manager.h>
+#include <common/graphics/window.h>
 
 #include <common/networking/core.h>
 #include <common/networking/packet.h>
+#include <common/networking/packet_stats.h>
 
 #include <common/ui/ui_manager.h>
 
@@ -232,11 +234,19 @@ void Client::PollIncomingMessages() const
             break;
         }
 
-        auto packet_received = *static_cast<Packet*>(p_incoming_message->m_pData);
+        Packet packet_received{};
+        if (packet_received.Decode(p_incoming_message->m_pData, p_incoming_message->m_cbSize) != PacketCode_Success)
+        {
+            SCX_CORE_WARN("Dropping malformed packet of {0} bytes from the server.", p_incoming_message->m_cbSize);
+        }
+        else
+        {
+            PacketStats::RecordReceived(packet_received.GetType(), p_incoming_message->m_cbSize);
 
-        // We use 0 for the 'from_client' parameter because on the client side we know
-        // every packet comes from the server.
-        m_handler.Handle(0, packet_received, &m_dispatcher);
+            // We use 0 for the 'from_client' parameter because on the client side we know
+            // every packet comes from the server.
+            m_handler.Handle(0, packet_received, &m_dispatcher);
+        }
 
         p_incoming_message->Release();
     }
@@ -249,8 +259,11 @@ void Client::PollConnectionStateChanges() const
 
 void Client::SendToServer(const Packet& data) const
 {
-    m_interface->SendMessageToConnection(m_connection, &data, sizeof(Packet),
-                                         k_nSteamNetworkingSend_Reliable, nullptr);
+    unsigned char buffer[MAX_ENCODED_PACKET_SIZE];
+    const int size = data.Encode(buffer, sizeof(buffer));
+
+    m_interface->SendMessageToConnection(m_connection, buffer, size, GetSendFlags(data.GetType()), nullptr);
+    PacketStats::RecordSent(data.GetType(), size);
 }
 
 
@@ -11,6 +11,7 @@
 
 #include <steam/steamnetworkingsockets.h>
 
+#include <memory>
 #include <string>
 
 class Window;
@@ -51,6 +52,7 @@ public:
     static [[nodiscard]] unsigned int GetClientId();
 
 private:
+    std::unique_ptr<Window> m_window;
     ClientPacketHandler m_handler;
     ClientPacketDispatcher m_dispatcher;
     ClientInfo m_client_info;
@@ -72,3 +72,13 @@ void ClientPacketDispatcher::SendChatMessage(const std::string& input) const
 
     client_handle->SendToServer(pckt);
 };
+
+void ClientPacketDispatcher::SnapshotAck(const uint32_t sequence) const
+{
+    const auto client_handle = dynamic_cast<const Client*>(m_handle);
+
+    Packet pckt{ PacketType::SnapshotAck };
+    pckt.Write(sequence);
+
+    client_handle->SendToServer(pckt);
+}
@@ -2,6 +2,9 @@
 
 #include <common/interface/ipacket_dispatcher.h>
 
+#include <cstdint>
+#include <string>
+
 class Client;
 
 /**
@@ -46,4 +49,10 @@ public:
      * \param input The message to send.
      */
     void SendChatMessage(const std::string& input) const;
+
+    /**
+     * \brief Sends an acknowledgement that a snapshot has been reconstructed.
+     * \param sequence The sequence of the snapshot.
+     */
+    void SnapshotAck(uint32_t sequence) const;
 };
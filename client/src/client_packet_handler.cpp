@@ -5,6 +5,8 @@
 
 #include "game/game.h"
 
+#include <common/networking/snapshot.h>
+
 #include <common/utils/logging.h>
 #include <common/utils/uuid.h>
 
@@ -13,6 +15,11 @@
 
 #include <chrono>
 
+/**
+ * \brief Reassembles the snapshots sent by the server.
+ */
+static SnapshotReceiver s_snapshot_receiver;
+
 void Welcome(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
 {
     (void)from;
@@ -52,21 +59,21 @@ void PlayerConnected(const unsigned int from, Packet& packet, const IPacketDispa
     glm::vec2 scale;
     packet.Read(scale);
 
+    // The players of other clients are spawned once they enter the local player's region of
+    // interest.
+    if (client_id != Client::GetClientId())
+    {
+        SCX_CORE_INFO("{0} has connected to the server ({1}).", username, client_id);
+        return;
+    }
+
     Transform player_transform{};
     player_transform.position = position;
     player_transform.scale = scale;
     player_transform.rotation = 0.0f;
 
-    if (client_id == Client::GetClientId())
-    {
-        SCX_CORE_INFO("You have connected to the server with username {0}.", username);
-        Game::SpawnLocalPlayer(username, player_transform);
-    }
-    else
-    {
-        SCX_CORE_INFO("{0} has connected to the server ({1}).", username, client_id);
-        Game::SpawnPlayer(client_id, username, player_transform);
-    }
+    SCX_CORE_INFO("You have connected to the server with username {0}.", username);
+    Game::SpawnLocalPlayer(username, player_transform);
 }
 
 void PlayerDisconnected(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
@@ -79,27 +86,11 @@ void PlayerDisconnected(const unsigned int from, Packet& packet, const IPacketDi
     std::string username;
     packet.Read(username);
 
-    Game::RemovePlayer(id);
-
+    // The player has already been despawned if it was within the local player's region of
+    // interest.
     SCX_CORE_INFO("{0} has disconnected.", username);
 }
 
-void PlayerMovement(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
-{
-    (void)from;
-
-    unsigned int id;
-    packet.Read(id);
-
-    glm::vec2 position;
-    packet.Read(position);
-
-    if (id == Client::GetClientId())
-        id = 0;
-
-    Game::SetPlayerPosition(id, position);
-}
-
 void PlayerHealthUpdate(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
 {
     (void)from;
@@ -141,10 +132,45 @@ void PlayerRespawn(const unsigned int from, Packet& packet, const IPacketDispatc
     player_transform.scale = scale;
     player_transform.rotation = 0.0f;
 
-    if (client_id == Client::GetClientId())
-        Game::SpawnLocalPlayer(username, player_transform);
-    else
-        Game::SpawnPlayer(client_id, username, player_transform);
+    Game::SpawnLocalPlayer(username, player_transform);
+}
+
+void PlayerSpawn(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+{
+    (void)from;
+
+    unsigned int client_id;
+    packet.Read(client_id);
+
+    std::string username;
+    packet.Read(username);
+
+    glm::vec2 position;
+    packet.Read(position);
+
+    glm::vec2 scale;
+    packet.Read(scale);
+
+    float weapon_rotation;
+    packet.Read(weapon_rotation);
+
+    Transform player_transform{};
+    player_transform.position = position;
+    player_transform.scale = scale;
+    player_transform.rotation = 0.0f;
+
+    Game::SpawnPlayer(client_id, username, player_transform);
+    Game::SetPlayerWeaponRotation(client_id, weapon_rotation);
+}
+
+void PlayerDespawn(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+{
+    (void)from;
+
+    unsigned int client_id;
+    packet.Read(client_id);
+
+    Game::RemovePlayer(client_id);
 }
 
 void PlayerWeaponRotation(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
@@ -160,30 +186,40 @@ void PlayerWeaponRotation(const unsigned int from, Packet& packet, const IPacket
     Game::SetPlayerWeaponRotation(id, rotation);
 }
 
-void ProjectileUpdate(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+void ProjectileDestroy(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
 {
     (void)from;
 
     UUID projectile_id;
     packet.Read(projectile_id);
 
-    glm::vec2 projectile_position;
-    packet.Read(projectile_position);
-
-    float projectile_rotation;
-    packet.Read(projectile_rotation);
-
-    Game::UpdateProjectile(projectile_id, projectile_position, projectile_rotation);
+    Game::DestroyProjectile(projectile_id);
 }
 
-void ProjectileDestroy(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+void SnapshotDeltaReceive(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
 {
     (void)from;
 
-    UUID projectile_id;
-    packet.Read(projectile_id);
+    SnapshotDelta changes{};
+    if (!s_snapshot_receiver.Receive(packet, changes))
+        return;
 
-    Game::DestroyProjectile(projectile_id);
+    // Acknowledge the snapshot so the server can send the next delta against it.
+    dynamic_cast<const ClientPacketDispatcher*>(dispatcher)->SnapshotAck(changes.sequence);
+
+    for (const auto& [id, position] : changes.updated_players)
+    {
+        // The local player is identified by 0 within the game.
+        Game::SetPlayerPosition(id == Client::GetClientId() ? 0 : id, position);
+    }
+
+    for (const auto& [id, position, rotation] : changes.updated_projectiles)
+        Game::UpdateProjectile(id, position, rotation);
+
+    // Projectiles which left the local player's region of interest may return to it, so they
+    // are despawned rather than destroyed.
+    for (const auto& id : changes.removed_projectiles)
+        Game::DespawnProjectile(id);
 }
 
 void ChatMessageReceive(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
@@ -216,13 +252,14 @@ ClientPacketHandler::ClientPacketHandler()
         { PacketType::Welcome, &Welcome },
         { PacketType::PlayerConnected, &PlayerConnected },
         { PacketType::PlayerDisconnected, &PlayerDisconnected },
-        { PacketType::PlayerMovement, &PlayerMovement },
         { PacketType::PlayerHealthUpdate, &PlayerHealthUpdate },
         { PacketType::PlayerDeath, &PlayerDeath },
         { PacketType::PlayerRespawn, &PlayerRespawn },
+        { PacketType::PlayerSpawn, &PlayerSpawn },
+        { PacketType::PlayerDespawn, &PlayerDespawn },
         { PacketType::PlayerWeaponRotation, &PlayerWeaponRotation },
-        { PacketType::ProjectileUpdate, &ProjectileUpdate },
         { PacketType::ProjectileDestroy, &ProjectileDestroy },
-        { PacketType::ChatMessageInbound, &ChatMessageReceive }
+        { PacketType::ChatMessageInbound, &ChatMessageReceive },
+        { PacketType::SnapshotDelta, &SnapshotDeltaReceive }
     };
 }
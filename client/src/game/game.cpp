@@ -238,6 +238,10 @@ float Game::GetLocalPlayerWeaponRotation()
 
 void Game::UpdateProjectile(const UUID id, const glm::vec2 position, const float rotation)
 {
+    // A late update must not spawn the projectile again once it has been destroyed.
+    if (Get().m_destroyed_projectiles.contains(id))
+        return;
+
     // Check if a projectile with this identifier exists. If it doesn't
     // spawn one in.
     const auto it = Get().m_projectiles.find(id);
@@ -255,9 +259,27 @@ void Game::UpdateProjectile(const UUID id, const glm::vec2 position, const float
 }
 
 void Game::DestroyProjectile(const UUID id)
+{
+    // Remember the most recently destroyed projectiles, so that updates which arrive after
+    // their destruction can be ignored.
+    if (Get().m_destroyed_projectiles.insert(id).second)
+    {
+        Get().m_destroyed_projectile_history.push_back(id);
+
+        if (Get().m_destroyed_projectile_history.size() > DESTROYED_PROJECTILE_HISTORY)
+        {
+            Get().m_destroyed_projectiles.erase(Get().m_destroyed_projectile_history.front());
+            Get().m_destroyed_projectile_history.pop_front();
+        }
+    }
+
+    DespawnProjectile(id);
+}
+
+void Game::DespawnProjectile(const UUID id)
 {
     // Check if a projectile with this identifier exists. If it doesn't
-    // ignore the destruction of it.
+    // ignore the removal of it.
     const auto it = Get().m_projectiles.find(id);
     if (it == Get().m_projectiles.end())
         return;
@@ -11,12 +11,19 @@
 
 #include <glm/vec2.hpp>
 
+#include <deque>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
 
 class UUID;
 
+/**
+ * \brief The number of recently destroyed projectiles remembered by the client.
+ */
+constexpr size_t DESTROYED_PROJECTILE_HISTORY = 256;
+
 /**
  * \brief The client game class.
  */
@@ -111,6 +118,8 @@ public:
 
     /**
      * \brief Updates a projectile with the given identifier with the given position and rotation.
+     * Updates for a projectile which has already been destroyed are ignored, since they are sent
+     * unreliably and may arrive after the destruction.
      * \param id The identifier of the projectile to update.
      * \param position The new position to update the projectile with.
      * \param rotation The new rotation to update the projectile with.
@@ -123,6 +132,13 @@ public:
      */
     static void DestroyProjectile(UUID id);
 
+    /**
+     * \brief Removes an instance of a projectile which has left the local player's region of
+     * interest. Unlike a destroyed projectile, it is spawned again by its next update.
+     * \param id The identifier of the projectile to remove.
+     */
+    static void DespawnProjectile(UUID id);
+
     /**
      * \brief Gets a reference to the game's camera.
      * \return The game's camera reference.
@@ -142,6 +158,8 @@ private:
     std::unordered_map<unsigned int, Entity> m_players;
     std::unordered_map<unsigned int, Entity> m_player_weapons;
     std::unordered_map<UUID, Entity> m_projectiles;
+    std::unordered_set<UUID> m_destroyed_projectiles;
+    std::deque<UUID> m_destroyed_projectile_history;
     std::vector<Entity> m_level_content;
     int m_local_player_current_health;
     bool m_is_local_player_alive;
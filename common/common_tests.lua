@@ -16,10 +16,15 @@ project "common_tests"
         "include",
         "../thirdparty/clove-unit",
         "../thirdparty/spdlog/include",
-        "../thirdparty/game-networking/include"
+        "../thirdparty/game-networking/include",
+        "../thirdparty/glm"
     }
 
-    links "common"
+    links
+    {
+        "common",
+        "common_networking"
+    }
 
     filter { "configurations:Debug" }
         runtime "Debug"
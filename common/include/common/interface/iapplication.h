@@ -1,9 +1,5 @@
 #pragma once
 
-#include "common/graphics/window.h"
-
-#include <memory>
-
 class IApplication
 {
 public:
@@ -20,7 +16,4 @@ public:
     virtual void Initialise() = 0;
     virtual void Run() = 0;
     virtual void Dispose() = 0;
-
-protected:
-    std::unique_ptr<Window> m_window;
 };
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "common/networking/packet.h"
+#include "common/networking/packet_stats.h"
 #include "common/utils/logging.h"
 #include "common/interface/ipacket_dispatcher.h"
 
+#include <chrono>
 #include <unordered_map>
 
 class IPacketHandler
@@ -25,8 +27,13 @@ public:
 
         if (it != m_handlers.end())
         {
+            const PacketType type = packet.GetType();
+            const auto start = std::chrono::steady_clock::now();
+
             // Call packet handler associated with this packet type.
             it->second(client_id, packet, dispatcher);
+
+            PacketStats::RecordHandled(type, std::chrono::steady_clock::now() - start);
         }
         else
             SCX_CORE_ERROR("No handlers exist for this packet.");
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/assets/asset.h"
+#include "common/static_geometry.h"
 
 #include <glm/vec2.hpp>
 
@@ -62,6 +63,12 @@ public:
      */
     [[nodiscard]] std::vector<LevelContent>& GetByType(LevelContent::Type type);
 
+    /**
+     * \brief Gets the static geometry of the level, which holds its platforms and walls.
+     * \return The level's static geometry.
+     */
+    [[nodiscard]] const StaticGeometry& GetStaticGeometry() const;
+
 private:
     std::string m_path;
     std::string m_name;
@@ -69,5 +76,6 @@ private:
     std::vector<LevelContent> m_renderable;
     bool m_renderable_checked;
     std::unordered_map<LevelContent::Type, LevelContentCache> m_type_contents;
+    StaticGeometry m_static_geometry;
 };
 
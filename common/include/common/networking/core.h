@@ -1,6 +1,15 @@
 #pragma once
 
+#include "packet.h"
+
 #include <steam/steamnetworkingsockets.h>
 
 void InitialiseSteamDatagramConnectionSockets();
 void ShutdownSteamDatagramConnectionSockets();
+
+/**
+ * \brief Gets the send flags which deliver a packet according to its delivery class.
+ * \param type The type of packet being sent.
+ * \return The \code k_nSteamNetworkingSend\endcode flags to send the packet with.
+ */
+int GetSendFlags(PacketType type);
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <string>
 #include <functional>
+#include <iterator>
 
 constexpr int PACKET_SIZE = 128;
 
@@ -24,17 +27,136 @@ enum class PacketType
     ProjectileDestroy,
     ServerShutdown,
     ChatMessageOutbound,
-    ChatMessageInbound
+    ChatMessageInbound,
+    SnapshotDelta,
+    SnapshotAck,
+    PlayerSpawn,
+    PlayerDespawn,
+    Count
 };
 
+/**
+ * \brief Determines how a packet is delivered over the network.
+ */
+enum class PacketDelivery
+{
+    // Delivered in order, with lost packets retransmitted. Used for events.
+    Reliable,
+    // Never retransmitted, and may arrive out of order. Used for state which is
+    // superseded by the next packet of the same type.
+    Unreliable,
+    // As unreliable, but dropped rather than queued if it cannot be sent straight away.
+    // Used for state which is sent every tick, where a delayed packet is already stale.
+    UnreliableNoDelay
+};
+
+/**
+ * \brief The delivery class of each packet type, indexed by \code PacketType\endcode.
+ */
+constexpr PacketDelivery PACKET_DELIVERY[] =
+{
+    PacketDelivery::Reliable,          // Unspecified
+    PacketDelivery::Reliable,          // Welcome
+    PacketDelivery::Reliable,          // WelcomeReceived
+    PacketDelivery::Reliable,          // PlayerConnected
+    PacketDelivery::Reliable,          // PlayerDisconnected
+    PacketDelivery::Reliable,          // PlayerInput
+    PacketDelivery::UnreliableNoDelay, // PlayerMovement
+    PacketDelivery::Reliable,          // PlayerHealthUpdate
+    PacketDelivery::Reliable,          // PlayerDeath
+    PacketDelivery::Reliable,          // PlayerRespawnRequest
+    PacketDelivery::Reliable,          // PlayerRespawn
+    PacketDelivery::Unreliable,        // PlayerWeaponRotation
+    PacketDelivery::UnreliableNoDelay, // ProjectileUpdate
+    PacketDelivery::Reliable,          // ProjectileDestroy
+    PacketDelivery::Reliable,          // ServerShutdown
+    PacketDelivery::Reliable,          // ChatMessageOutbound
+    PacketDelivery::Reliable,          // ChatMessageInbound
+    PacketDelivery::Unreliable,        // SnapshotDelta
+    PacketDelivery::Unreliable,        // SnapshotAck
+    PacketDelivery::Reliable,          // PlayerSpawn
+    PacketDelivery::Reliable           // PlayerDespawn
+};
+
+static_assert(std::size(PACKET_DELIVERY) == static_cast<size_t>(PacketType::Count),
+              "Each packet type must have a delivery class.");
+
+/**
+ * \brief Gets the delivery class of a packet type.
+ * \param type The type of packet.
+ * \return The delivery class used to send packets of the given type.
+ */
+constexpr PacketDelivery GetPacketDelivery(const PacketType type)
+{
+    return PACKET_DELIVERY[static_cast<size_t>(type)];
+}
+
+/**
+ * \brief The name of each packet type, indexed by \code PacketType\endcode.
+ */
+constexpr const char* PACKET_TYPE_NAMES[] =
+{
+    "Unspecified",
+    "Welcome",
+    "WelcomeReceived",
+    "PlayerConnected",
+    "PlayerDisconnected",
+    "PlayerInput",
+    "PlayerMovement",
+    "PlayerHealthUpdate",
+    "PlayerDeath",
+    "PlayerRespawnRequest",
+    "PlayerRespawn",
+    "PlayerWeaponRotation",
+    "ProjectileUpdate",
+    "ProjectileDestroy",
+    "ServerShutdown",
+    "ChatMessageOutbound",
+    "ChatMessageInbound",
+    "SnapshotDelta",
+    "SnapshotAck",
+    "PlayerSpawn",
+    "PlayerDespawn"
+};
+
+static_assert(std::size(PACKET_TYPE_NAMES) == static_cast<size_t>(PacketType::Count),
+              "Each packet type must have a name.");
+
+/**
+ * \brief Gets the name of a packet type, such as for logging.
+ * \param type The type of packet.
+ * \return The name of the packet type.
+ */
+constexpr const char* GetPacketTypeName(const PacketType type)
+{
+    return PACKET_TYPE_NAMES[static_cast<size_t>(type)];
+}
+
 // Return codes utilised by packet methods.
 enum PacketCode
 {
     PacketCode_Success = 0,
     PacketCode_FullPacketE = -1,
-    PacketCode_NoDataToReadE = -1
+    PacketCode_NoDataToReadE = -1,
+    PacketCode_MalformedE = -2
+};
+
+/**
+ * \brief The header which precedes the payload of a packet when it is sent over the network.
+ * Only the bytes of the payload which have been written are sent after it.
+ */
+struct PacketHeader
+{
+    uint8_t type;
+    uint8_t size;
 };
 
+constexpr int PACKET_HEADER_SIZE = sizeof(PacketHeader);
+constexpr int MAX_ENCODED_PACKET_SIZE = PACKET_HEADER_SIZE + PACKET_SIZE;
+
+static_assert(static_cast<int>(PacketType::Count) <= UINT8_MAX, "Packet types must fit in the header.");
+static_assert(PACKET_SIZE <= UINT8_MAX, "Packet sizes must fit in the header.");
+
 class Packet
 {
 public:
@@ -74,15 +196,17 @@ public:
      * \param dest A reference to the destination of the read value.
      * \return An error code indicating if the read was successful.
      * \code PacketCode_Success\endcode is returned if the operation performed successfully.
-     * \code PacketCode_FullPacketE\endcode is returned if the packet is empty and cannot be read from.
+     * \code PacketCode_NoDataToReadE\endcode is returned if fewer bytes than the size of the type
+     * are left to be read, in which case nothing is read.
      */
     template <typename T>
     int Read(T &dest)
     {
-        if (m_read_head == m_size)
+        int type_size = sizeof(T);
+
+        if (m_read_head + type_size > m_size)
             return PacketCode_NoDataToReadE;
 
-        int type_size = sizeof(T);
         std::memcpy(&dest, m_buffer + m_read_head, type_size);
         m_read_head += type_size;
 
@@ -107,6 +231,33 @@ public:
      */
     [[nodiscard]] int GetSize() const;
 
+    /**
+     * \brief Gets the size of the packet once it has been encoded for the network.
+     * \return The size of the packet's header and the written part of its payload.
+     */
+    [[nodiscard]] int GetEncodedSize() const;
+
+    /**
+     * \brief Encodes the packet into a compact header followed by the written part of
+     * its payload, ready to be sent over the network.
+     * \param dest The buffer to encode the packet into.
+     * \param capacity The size of the destination buffer.
+     * \return The number of bytes encoded, or \code PacketCode_FullPacketE\endcode if the
+     * destination buffer is too small.
+     */
+    int Encode(void* dest, int capacity) const;
+
+    /**
+     * \brief Decodes a packet which has been received from the network, replacing the
+     * contents of this packet.
+     * \param data The received data.
+     * \param size The size of the received data.
+     * \return \code PacketCode_Success\endcode if the packet was decoded, or
+     * \code PacketCode_MalformedE\endcode if the header is invalid or the length it declares
+     * does not match the size of the received data.
+     */
+    int Decode(const void* data, int size);
+
 private:
     PacketType m_type;
     unsigned int m_size;
@@ -138,12 +289,19 @@ inline int Packet::Read(std::string &dest)
     unsigned int start_pos = m_read_head;
     char buffer[PACKET_SIZE]{};
 
+    if (start_pos >= m_size)
+        return PacketCode_NoDataToReadE;
+
     unsigned int i = start_pos;
-    for (i = start_pos; m_buffer[i] != '\0'; i++)
+    for (i = start_pos; i < m_size && m_buffer[i] != '\0'; i++)
     {
         buffer[i - start_pos] = m_buffer[i];
     }
 
+    // A string which runs to the end of the packet was never terminated.
+    if (i == m_size)
+        return PacketCode_MalformedE;
+
     // Increment the read head to account for the buffer size with null-terminatation character.
     m_read_head += (static_cast<unsigned long long>(i) - start_pos + 1) * sizeof(char);
 
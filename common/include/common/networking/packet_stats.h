@@ -0,0 +1,144 @@
+#pragma once
+
+#include "packet.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+constexpr size_t PACKET_TYPE_COUNT = static_cast<size_t>(PacketType::Count);
+
+/**
+ * \brief The traffic and handling cost of a single packet type. Bytes are the encoded size of
+ * each packet, excluding the networking library's own framing.
+ */
+struct PacketTypeStats
+{
+    uint64_t messages_sent = 0;
+    uint64_t bytes_sent = 0;
+    uint64_t messages_received = 0;
+    uint64_t bytes_received = 0;
+    uint64_t handled = 0;
+    uint64_t handle_ns = 0;
+};
+
+/**
+ * \brief The statistics of every packet type, merged from every thread.
+ */
+struct PacketStatsSnapshot
+{
+    std::array<PacketTypeStats, PACKET_TYPE_COUNT> types{};
+
+    [[nodiscard]] const PacketTypeStats& Get(PacketType type) const;
+
+    /**
+     * \brief Sums the statistics of every packet type.
+     */
+    [[nodiscard]] PacketTypeStats GetTotal() const;
+
+    /**
+     * \brief Gets the statistics which were recorded since an earlier snapshot was taken.
+     * \param earlier The earlier snapshot.
+     */
+    [[nodiscard]] PacketStatsSnapshot Since(const PacketStatsSnapshot& earlier) const;
+};
+
+/**
+ * \brief A data structure implemented as a singleton pattern to count the packets of each type
+ * which are sent, received and handled.
+ *
+ * As with \code TickProfiler\endcode, each thread counts into its own set of counters, which
+ * only that thread writes to, so counting never locks or contends with another thread. The
+ * counters of every thread are merged when a snapshot is taken, which may be done from any
+ * thread while packets are being counted.
+ */
+class PacketStats
+{
+public:
+    PacketStats(const PacketStats&) = delete;
+    PacketStats& operator=(const PacketStats&) = delete;
+
+    PacketStats(PacketStats&&) noexcept = delete;
+    PacketStats& operator=(PacketStats&&) noexcept = delete;
+
+    /**
+     * \brief Counts packets of the same type sent by the calling thread.
+     * \param type The type of the packets.
+     * \param size The encoded size of each packet in bytes.
+     * \param count The number of connections the packet was sent to.
+     */
+    static void RecordSent(PacketType type, int size, size_t count = 1);
+
+    /**
+     * \brief Counts a packet received by the calling thread.
+     * \param type The type of the packet.
+     * \param size The encoded size of the packet in bytes.
+     */
+    static void RecordReceived(PacketType type, int size);
+
+    /**
+     * \brief Counts a packet handled by the calling thread.
+     * \param type The type of the packet.
+     * \param duration How long the packet's handler took.
+     */
+    static void RecordHandled(PacketType type, std::chrono::nanoseconds duration);
+
+    /**
+     * \brief Merges the counters of every thread. May be called from any thread.
+     * \return The packets counted since the application started.
+     */
+    static PacketStatsSnapshot GetSnapshot();
+
+    /**
+     * \brief Logs a line with the total traffic, followed by a line for each packet type which
+     * has been sent, received or handled.
+     * \param snapshot The snapshot to log.
+     * \param title A title describing the period the snapshot covers.
+     * \param seconds The length of that period, used to log rates, or 0 to only log totals.
+     */
+    static void LogSnapshot(const PacketStatsSnapshot& snapshot, const char* title, double seconds = 0.0);
+
+private:
+    /**
+     * \brief The counters of a single thread, updated with a plain load and store as only that
+     * thread writes to them.
+     */
+    struct ThreadCounters
+    {
+        struct Type
+        {
+            std::atomic<uint64_t> messages_sent{ 0 };
+            std::atomic<uint64_t> bytes_sent{ 0 };
+            std::atomic<uint64_t> messages_received{ 0 };
+            std::atomic<uint64_t> bytes_received{ 0 };
+            std::atomic<uint64_t> handled{ 0 };
+            std::atomic<uint64_t> handle_ns{ 0 };
+        };
+
+        std::array<Type, PACKET_TYPE_COUNT> types;
+    };
+
+    /**
+     * \brief The counters of every thread which has counted a packet. Counters are kept after
+     * their thread exits, so that the packets it counted are not lost.
+     */
+    std::vector<std::unique_ptr<ThreadCounters>> m_threads;
+    std::mutex m_threads_guard;
+
+    PacketStats() = default;
+    ~PacketStats() = default;
+
+    static PacketStats s_instance;
+    static PacketStats& Get();
+
+    /**
+     * \brief Gets the counters of the calling thread for a packet type, creating the thread's
+     * counters on its first call.
+     */
+    static ThreadCounters::Type& GetThreadCounters(PacketType type);
+};
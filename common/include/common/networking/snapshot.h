@@ -0,0 +1,159 @@
+#pragma once
+
+#include "packet.h"
+
+#include <common/utils/uuid.h>
+
+#include <glm/vec2.hpp>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * \brief The number of snapshots remembered by the server and each client. The server only
+ * sends a delta against an acknowledged snapshot which is at most this many snapshots old,
+ * otherwise it sends the full snapshot.
+ */
+constexpr uint32_t SNAPSHOT_HISTORY = 32;
+
+/**
+ * \brief The maximum number of packets a single snapshot delta may be split into.
+ */
+constexpr int MAX_SNAPSHOT_FRAGMENTS = UINT8_MAX;
+
+/**
+ * \brief The state of a player within a snapshot.
+ */
+struct PlayerSnapshot
+{
+    unsigned int id;
+    glm::vec2 position;
+};
+
+/**
+ * \brief The state of a projectile within a snapshot.
+ */
+struct ProjectileSnapshot
+{
+    UUID id;
+    glm::vec2 position;
+    float rotation;
+};
+
+/**
+ * \brief The replicated state of the world at a single tick. Entities are sorted by their
+ * identifiers so that two snapshots can be compared in a single pass.
+ */
+struct WorldSnapshot
+{
+    uint32_t sequence{ 0 };
+    std::vector<PlayerSnapshot> players;
+    std::vector<ProjectileSnapshot> projectiles;
+};
+
+/**
+ * \brief The changes which turn one snapshot into another.
+ */
+struct SnapshotDelta
+{
+    uint32_t sequence{ 0 };
+
+    /**
+     * \brief The sequence of the snapshot the delta is relative to, or 0 if it is relative
+     * to an empty world and so holds the full snapshot.
+     */
+    uint32_t baseline{ 0 };
+
+    std::vector<PlayerSnapshot> updated_players;
+    std::vector<unsigned int> removed_players;
+    std::vector<ProjectileSnapshot> updated_projectiles;
+    std::vector<UUID> removed_projectiles;
+};
+
+/**
+ * \brief Sorts the entities of a snapshot by their identifiers.
+ * \param snapshot The snapshot to sort.
+ */
+void SortSnapshot(WorldSnapshot& snapshot);
+
+/**
+ * \brief Computes the changes between two snapshots. Entities whose state is identical in
+ * both snapshots are left out.
+ * \param baseline The snapshot to compare against, or \code nullptr\endcode to compare
+ * against an empty world.
+ * \param current The snapshot to compare.
+ * \return The delta which turns the baseline into the current snapshot.
+ */
+SnapshotDelta ComputeSnapshotDelta(const WorldSnapshot* baseline, const WorldSnapshot& current);
+
+/**
+ * \brief Applies a delta to a snapshot, turning it into the snapshot the delta was computed for.
+ * \param delta The delta to apply.
+ * \param snapshot The baseline snapshot, which is modified in place.
+ */
+void ApplySnapshotDelta(const SnapshotDelta& delta, WorldSnapshot& snapshot);
+
+/**
+ * \brief Removes the records of a delta which do not fit in \code MAX_SNAPSHOT_FRAGMENTS\endcode
+ * packets. Removals are kept first, then player updates, then the projectile updates nearest
+ * to a position. A receiver only applies the records which are kept, so the sender must
+ * remember the baseline with the limited delta applied, and the records which were removed
+ * are sent by later deltas against it.
+ * \param delta The delta to limit, which is modified in place.
+ * \param focus The position the kept projectiles are nearest to, such as the receiver's player.
+ * \return A true or false value indicating whether any records were removed.
+ */
+bool LimitSnapshotDelta(SnapshotDelta& delta, glm::vec2 focus);
+
+/**
+ * \brief Writes a delta into as many \code PacketType::SnapshotDelta\endcode packets as
+ * are needed to hold it. A delta which needs more than \code MAX_SNAPSHOT_FRAGMENTS\endcode
+ * packets is not written, so deltas should be limited first.
+ * \param delta The delta to write.
+ * \param fragments The vector which the packets are appended to.
+ * \return The number of packets written.
+ */
+int WriteSnapshotDelta(const SnapshotDelta& delta, std::vector<Packet>& fragments);
+
+/**
+ * \brief Reassembles the fragments of snapshot deltas received from the server, and
+ * reconstructs the full snapshots from the baselines it has remembered.
+ */
+class SnapshotReceiver
+{
+public:
+    SnapshotReceiver() = default;
+
+    /**
+     * \brief Adds a received fragment. Fragments of older snapshots than the one being
+     * assembled are discarded, as are incomplete snapshots once a newer one starts to arrive.
+     * \param fragment The received \code PacketType::SnapshotDelta\endcode packet.
+     * \param changes Receives the changes since the previously reconstructed snapshot, if
+     * this fragment completed a newer one.
+     * \return A true or false value indicating whether a newer snapshot was reconstructed.
+     */
+    bool Receive(Packet& fragment, SnapshotDelta& changes);
+
+    /**
+     * \brief Gets the most recently reconstructed snapshot.
+     * \return The latest snapshot, whose sequence is 0 if none has been reconstructed.
+     */
+    [[nodiscard]] const WorldSnapshot& GetLatest() const;
+
+private:
+    WorldSnapshot m_history[SNAPSHOT_HISTORY];
+    WorldSnapshot m_latest;
+
+    uint32_t m_pending_sequence{ 0 };
+    uint32_t m_pending_baseline{ 0 };
+    std::vector<Packet> m_pending_fragments;
+    std::vector<bool> m_pending_received;
+    int m_pending_count{ 0 };
+
+    /**
+     * \brief Reconstructs the snapshot whose fragments have all been received.
+     * \param changes Receives the changes since the previously reconstructed snapshot.
+     * \return A true or false value indicating whether the snapshot could be reconstructed.
+     */
+    bool Reconstruct(SnapshotDelta& changes);
+};
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * \brief The width and height of the cells used to index static geometry.
+ */
+constexpr float STATIC_GEOMETRY_CELL_SIZE = 64.0f;
+
+/**
+ * \brief The bounds of a box of static geometry, such as a platform.
+ */
+struct StaticBox
+{
+    glm::vec2 min;
+    glm::vec2 max;
+};
+
+/**
+ * \brief An immutable uniform grid over the static geometry of a level, built once when the
+ * level is loaded, which finds the boxes that overlap a region without testing every box.
+ *
+ * The indices of the boxes in each cell are stored contiguously, with each cell's range found
+ * from an array of offsets, so a query only reads a few small arrays.
+ */
+class StaticGeometry
+{
+public:
+    StaticGeometry();
+
+    /**
+     * \brief Builds the grid over a set of boxes.
+     * \param boxes The bounds of the boxes.
+     * \param cell_size The width and height of each cell.
+     */
+    explicit StaticGeometry(std::vector<StaticBox> boxes, float cell_size = STATIC_GEOMETRY_CELL_SIZE);
+
+    /**
+     * \brief Visits every box which overlaps a box, including boxes which only touch it.
+     * \param min The lower corner of the box.
+     * \param max The upper corner of the box.
+     * \param visit The function called with each overlapping box, which is called once per box.
+     */
+    template <typename F>
+    void QueryBox(const glm::vec2 min, const glm::vec2 max, F&& visit) const
+    {
+        ForEachCandidate(min, max, [&](const StaticBox& box)
+        {
+            if (box.min.x <= max.x && box.max.x >= min.x && box.min.y <= max.y && box.max.y >= min.y)
+                visit(box);
+        });
+    }
+
+    /**
+     * \brief Visits every box which a line segment passes through or touches.
+     * \param start The start of the segment.
+     * \param end The end of the segment.
+     * \param visit The function called with each box, which is called once per box.
+     */
+    template <typename F>
+    void QuerySegment(const glm::vec2 start, const glm::vec2 end, F&& visit) const
+    {
+        const glm::vec2 min = { std::min(start.x, end.x), std::min(start.y, end.y) };
+        const glm::vec2 max = { std::max(start.x, end.x), std::max(start.y, end.y) };
+
+        ForEachCandidate(min, max, [&](const StaticBox& box)
+        {
+            if (IntersectsSegment(box, start, end))
+                visit(box);
+        });
+    }
+
+    /**
+     * \brief Gets every box of the static geometry.
+     * \return The bounds of the boxes.
+     */
+    [[nodiscard]] std::span<const StaticBox> GetBoxes() const;
+
+private:
+    std::vector<StaticBox> m_boxes;
+    glm::vec2 m_origin;
+    float m_cell_size;
+    int m_columns;
+    int m_rows;
+
+    /**
+     * \brief The offset of each cell's first index within the cell indices, followed by the
+     * total number of indices.
+     */
+    std::vector<uint32_t> m_cell_offsets;
+    std::vector<uint32_t> m_cell_indices;
+
+    /**
+     * \brief Gets the column or row of the grid which contains a coordinate, which may be
+     * outside of the grid.
+     */
+    [[nodiscard]] int ToCell(const float coordinate, const float origin) const
+    {
+        return static_cast<int>(std::floor((coordinate - origin) / m_cell_size));
+    }
+
+    /**
+     * \brief Visits each box in the cells which overlap a region. A box which spans several of
+     * those cells is only visited from the first of them.
+     */
+    template <typename F>
+    void ForEachCandidate(const glm::vec2 min, const glm::vec2 max, F&& visit) const
+    {
+        if (m_boxes.empty())
+            return;
+
+        const int min_x = std::max(ToCell(min.x, m_origin.x), 0);
+        const int min_y = std::max(ToCell(min.y, m_origin.y), 0);
+        const int max_x = std::min(ToCell(max.x, m_origin.x), m_columns - 1);
+        const int max_y = std::min(ToCell(max.y, m_origin.y), m_rows - 1);
+
+        for (int y = min_y; y <= max_y; y++)
+        {
+            for (int x = min_x; x <= max_x; x++)
+            {
+                const size_t cell = static_cast<size_t>(y) * m_columns + x;
+
+                for (uint32_t i = m_cell_offsets[cell]; i < m_cell_offsets[cell + 1]; i++)
+                {
+                    const StaticBox& box = m_boxes[m_cell_indices[i]];
+
+                    // Only visit the box from the first cell it shares with the region.
+                    if (x == std::max(ToCell(box.min.x, m_origin.x), min_x) &&
+                        y == std::max(ToCell(box.min.y, m_origin.y), min_y))
+                    {
+                        visit(box);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * \brief Determines whether a line segment passes through or touches a box.
+     */
+    static bool IntersectsSegment(const StaticBox& box, glm::vec2 start, glm::vec2 end);
+};
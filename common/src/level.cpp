@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <sstream>
+#include <utility>
 
 static std::vector<std::string> SplitString(const std::string& string, char delimiter);
 
@@ -104,6 +105,19 @@ void Level::Load()
             content_exists = true;
     }
 
+    // Compile the collidable contents into a structure which can be queried quickly.
+    std::vector<StaticBox> static_boxes;
+    for (const auto& content : m_contents)
+    {
+        if (content.type != LevelContent::Type::Platform && content.type != LevelContent::Type::Wall)
+            continue;
+
+        static_boxes.push_back({ .min = content.position - content.scale / 2.0f,
+                                 .max = content.position + content.scale / 2.0f });
+    }
+
+    m_static_geometry = StaticGeometry{ std::move(static_boxes) };
+
     SCX_CORE_INFO("Successfully loaded level '{0}' at '{1}'.", m_name, m_path);
 }
 
@@ -145,6 +159,11 @@ std::vector<LevelContent>& Level::GetByType(const LevelContent::Type type)
     return cache.content;
 }
 
+const StaticGeometry& Level::GetStaticGeometry() const
+{
+    return m_static_geometry;
+}
+
 std::vector<std::string> SplitString(const std::string& string, const char delimiter)
 {
     std::stringstream stream{ string };
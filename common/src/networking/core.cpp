@@ -23,3 +23,17 @@ void ShutdownSteamDatagramConnectionSockets()
     std::this_thread::sleep_for(std::chrono::milliseconds(CLEANUP_TIME));
     GameNetworkingSockets_Kill();
 }
+
+int GetSendFlags(const PacketType type)
+{
+    switch (GetPacketDelivery(type))
+    {
+    case PacketDelivery::Unreliable:
+        return k_nSteamNetworkingSend_Unreliable;
+    case PacketDelivery::UnreliableNoDelay:
+        return k_nSteamNetworkingSend_UnreliableNoDelay;
+    case PacketDelivery::Reliable:
+    default:
+        return k_nSteamNetworkingSend_Reliable;
+    }
+}
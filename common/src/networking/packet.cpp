@@ -27,3 +27,52 @@ bool Packet::IsPacketFull(const int new_data_size) const
 {
     return m_size + new_data_size >= PACKET_SIZE;
 }
+
+int Packet::GetEncodedSize() const
+{
+    return PACKET_HEADER_SIZE + static_cast<int>(m_size);
+}
+
+int Packet::Encode(void* dest, const int capacity) const
+{
+    const int encoded_size = GetEncodedSize();
+
+    if (encoded_size > capacity)
+        return PacketCode_FullPacketE;
+
+    const PacketHeader header{
+        .type = static_cast<uint8_t>(m_type),
+        .size = static_cast<uint8_t>(m_size)
+    };
+
+    auto* p_dest = static_cast<unsigned char*>(dest);
+    std::memcpy(p_dest, &header, PACKET_HEADER_SIZE);
+    std::memcpy(p_dest + PACKET_HEADER_SIZE, m_buffer, m_size);
+
+    return encoded_size;
+}
+
+int Packet::Decode(const void* data, const int size)
+{
+    if (!data || size < PACKET_HEADER_SIZE)
+        return PacketCode_MalformedE;
+
+    PacketHeader header{};
+    std::memcpy(&header, data, PACKET_HEADER_SIZE);
+
+    // The payload must be exactly as long as the header declares, and short enough to
+    // leave the null-terminator which string reads rely upon.
+    if (header.type >= static_cast<uint8_t>(PacketType::Count) ||
+        header.size >= PACKET_SIZE ||
+        header.size != size - PACKET_HEADER_SIZE)
+        return PacketCode_MalformedE;
+
+    m_type = static_cast<PacketType>(header.type);
+    m_size = header.size;
+    m_read_head = 0;
+
+    std::memcpy(m_buffer, static_cast<const unsigned char*>(data) + PACKET_HEADER_SIZE, m_size);
+    std::memset(m_buffer + m_size, 0, PACKET_SIZE - m_size);
+
+    return PacketCode_Success;
+}
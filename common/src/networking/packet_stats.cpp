@@ -0,0 +1,165 @@
+#include "common/networking/packet_stats.h"
+
+#include "common/utils/logging.h"
+
+#include <algorithm>
+
+PacketStats PacketStats::s_instance;
+
+/**
+ * \brief Adds to a counter which only the calling thread writes to, so a relaxed load and
+ * store is enough to increment it.
+ */
+static void Increment(std::atomic<uint64_t>& counter, const uint64_t amount)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+const PacketTypeStats& PacketStatsSnapshot::Get(const PacketType type) const
+{
+    return types[static_cast<size_t>(type)];
+}
+
+PacketTypeStats PacketStatsSnapshot::GetTotal() const
+{
+    PacketTypeStats total{};
+
+    for (const PacketTypeStats& stats : types)
+    {
+        total.messages_sent += stats.messages_sent;
+        total.bytes_sent += stats.bytes_sent;
+        total.messages_received += stats.messages_received;
+        total.bytes_received += stats.bytes_received;
+        total.handled += stats.handled;
+        total.handle_ns += stats.handle_ns;
+    }
+
+    return total;
+}
+
+PacketStatsSnapshot PacketStatsSnapshot::Since(const PacketStatsSnapshot& earlier) const
+{
+    PacketStatsSnapshot difference{};
+
+    for (size_t i = 0; i < PACKET_TYPE_COUNT; i++)
+    {
+        const PacketTypeStats& now = types[i];
+        const PacketTypeStats& then = earlier.types[i];
+
+        difference.types[i] = {
+            .messages_sent = now.messages_sent - then.messages_sent,
+            .bytes_sent = now.bytes_sent - then.bytes_sent,
+            .messages_received = now.messages_received - then.messages_received,
+            .bytes_received = now.bytes_received - then.bytes_received,
+            .handled = now.handled - then.handled,
+            .handle_ns = now.handle_ns - then.handle_ns
+        };
+    }
+
+    return difference;
+}
+
+void PacketStats::RecordSent(const PacketType type, const int size, const size_t count)
+{
+    ThreadCounters::Type& counters = GetThreadCounters(type);
+
+    Increment(counters.messages_sent, count);
+    Increment(counters.bytes_sent, static_cast<uint64_t>(std::max(size, 0)) * count);
+}
+
+void PacketStats::RecordReceived(const PacketType type, const int size)
+{
+    ThreadCounters::Type& counters = GetThreadCounters(type);
+
+    Increment(counters.messages_received, 1);
+    Increment(counters.bytes_received, static_cast<uint64_t>(std::max(size, 0)));
+}
+
+void PacketStats::RecordHandled(const PacketType type, const std::chrono::nanoseconds duration)
+{
+    ThreadCounters::Type& counters = GetThreadCounters(type);
+
+    Increment(counters.handled, 1);
+    Increment(counters.handle_ns, static_cast<uint64_t>(std::max<int64_t>(0, duration.count())));
+}
+
+PacketStatsSnapshot PacketStats::GetSnapshot()
+{
+    PacketStatsSnapshot snapshot{};
+
+    std::scoped_lock threads_lock{ Get().m_threads_guard };
+
+    for (const auto& thread : Get().m_threads)
+    {
+        for (size_t i = 0; i < PACKET_TYPE_COUNT; i++)
+        {
+            const ThreadCounters::Type& source = thread->types[i];
+            PacketTypeStats& dest = snapshot.types[i];
+
+            dest.messages_sent += source.messages_sent.load(std::memory_order_relaxed);
+            dest.bytes_sent += source.bytes_sent.load(std::memory_order_relaxed);
+            dest.messages_received += source.messages_received.load(std::memory_order_relaxed);
+            dest.bytes_received += source.bytes_received.load(std::memory_order_relaxed);
+            dest.handled += source.handled.load(std::memory_order_relaxed);
+            dest.handle_ns += source.handle_ns.load(std::memory_order_relaxed);
+        }
+    }
+
+    return snapshot;
+}
+
+void PacketStats::LogSnapshot(const PacketStatsSnapshot& snapshot, const char* title, const double seconds)
+{
+    const PacketTypeStats total = snapshot.GetTotal();
+
+    if (seconds > 0.0)
+    {
+        SCX_CORE_INFO("{0}: sent {1} msgs ({2:.1f} KB/s), received {3} msgs ({4:.1f} KB/s), handled {5} msgs "
+                      "in {6:.1f} ms", title, total.messages_sent,
+                      static_cast<double>(total.bytes_sent) / 1024.0 / seconds, total.messages_received,
+                      static_cast<double>(total.bytes_received) / 1024.0 / seconds, total.handled,
+                      static_cast<double>(total.handle_ns) / 1'000'000.0);
+    }
+    else
+    {
+        SCX_CORE_INFO("{0}: sent {1} msgs ({2} bytes), received {3} msgs ({4} bytes), handled {5} msgs in {6:.1f} ms",
+                      title, total.messages_sent, total.bytes_sent, total.messages_received, total.bytes_received,
+                      total.handled, static_cast<double>(total.handle_ns) / 1'000'000.0);
+    }
+
+    for (size_t i = 0; i < PACKET_TYPE_COUNT; i++)
+    {
+        const PacketTypeStats& stats = snapshot.types[i];
+        if (stats.messages_sent == 0 && stats.messages_received == 0 && stats.handled == 0)
+            continue;
+
+        const double handle_us = stats.handled > 0
+            ? static_cast<double>(stats.handle_ns) / static_cast<double>(stats.handled) / 1000.0
+            : 0.0;
+
+        SCX_CORE_INFO("  {0:<20} sent {1:>9} msgs {2:>11} B  received {3:>9} msgs {4:>11} B  handler {5:>8.2f} us",
+                      GetPacketTypeName(static_cast<PacketType>(i)), stats.messages_sent, stats.bytes_sent,
+                      stats.messages_received, stats.bytes_received, handle_us);
+    }
+}
+
+PacketStats& PacketStats::Get()
+{
+    return s_instance;
+}
+
+PacketStats::ThreadCounters::Type& PacketStats::GetThreadCounters(const PacketType type)
+{
+    thread_local ThreadCounters* t_p_counters = nullptr;
+
+    if (t_p_counters == nullptr)
+    {
+        auto counters = std::make_unique<ThreadCounters>();
+        t_p_counters = counters.get();
+
+        std::scoped_lock threads_lock{ Get().m_threads_guard };
+        Get().m_threads.push_back(std::move(counters));
+    }
+
+    return t_p_counters->types[static_cast<size_t>(type)];
+}
@@ -0,0 +1,433 @@
+#include "common/networking/snapshot.h"
+#include "common/utils/logging.h"
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+/**
+ * \brief The kinds of record which make up a snapshot delta, each preceded on the wire by
+ * its kind.
+ */
+enum class SnapshotRecord : uint8_t
+{
+    PlayerUpdate,
+    PlayerRemove,
+    ProjectileUpdate,
+    ProjectileRemove
+};
+
+constexpr int FRAGMENT_HEADER_SIZE = 2 * sizeof(uint32_t) + 2 * sizeof(uint8_t);
+
+// A packet's payload must leave space for its null-terminator.
+constexpr int FRAGMENT_CAPACITY = PACKET_SIZE - 1 - FRAGMENT_HEADER_SIZE;
+
+constexpr int PLAYER_UPDATE_SIZE = sizeof(SnapshotRecord) + sizeof(unsigned int) + sizeof(glm::vec2),
+              PLAYER_REMOVE_SIZE = sizeof(SnapshotRecord) + sizeof(unsigned int),
+              PROJECTILE_UPDATE_SIZE = sizeof(SnapshotRecord) + sizeof(UUID) + sizeof(glm::vec2) + sizeof(float),
+              PROJECTILE_REMOVE_SIZE = sizeof(SnapshotRecord) + sizeof(UUID);
+
+static_assert(PROJECTILE_UPDATE_SIZE >= PLAYER_UPDATE_SIZE && PROJECTILE_UPDATE_SIZE >= PROJECTILE_REMOVE_SIZE,
+              "Projectile updates must be the largest records.");
+
+/**
+ * \brief The number of bytes of records which always fit in the maximum number of fragments.
+ * Every fragment but the last is filled to within one record of its capacity, so this many
+ * bytes can never need more fragments than the maximum.
+ */
+constexpr int MAX_SNAPSHOT_RECORD_BYTES = MAX_SNAPSHOT_FRAGMENTS * (FRAGMENT_CAPACITY - PROJECTILE_UPDATE_SIZE + 1);
+
+static uint64_t GetEntityId(unsigned int player_id);
+static uint64_t GetEntityId(UUID projectile_id);
+static uint64_t GetEntityId(const PlayerSnapshot& player);
+static uint64_t GetEntityId(const ProjectileSnapshot& projectile);
+static bool operator==(const PlayerSnapshot& a, const PlayerSnapshot& b);
+static bool operator==(const ProjectileSnapshot& a, const ProjectileSnapshot& b);
+
+/**
+ * \brief Compares two sorted lists of entities, collecting the entities which are new or
+ * have changed, and the identifiers of those which have been removed.
+ */
+template <typename T, typename Id>
+static void DiffEntities(const std::vector<T>& baseline, const std::vector<T>& current, std::vector<T>& updated,
+                         std::vector<Id>& removed)
+{
+    size_t b = 0, c = 0;
+
+    while (b < baseline.size() || c < current.size())
+    {
+        if (c == current.size() || (b < baseline.size() && GetEntityId(baseline[b]) < GetEntityId(current[c])))
+        {
+            removed.push_back(baseline[b].id);
+            b++;
+        }
+        else if (b == baseline.size() || GetEntityId(current[c]) < GetEntityId(baseline[b]))
+        {
+            updated.push_back(current[c]);
+            c++;
+        }
+        else
+        {
+            if (!(baseline[b] == current[c]))
+                updated.push_back(current[c]);
+
+            b++;
+            c++;
+        }
+    }
+}
+
+/**
+ * \brief Applies updates and removals to a sorted list of entities, keeping it sorted.
+ */
+template <typename T, typename Id>
+static void PatchEntities(std::vector<T>& entities, const std::vector<T>& updated, const std::vector<Id>& removed)
+{
+    const auto by_id = [](const T& entity, const uint64_t id) { return GetEntityId(entity) < id; };
+
+    for (const auto& entity : updated)
+    {
+        const auto it = std::lower_bound(entities.begin(), entities.end(), GetEntityId(entity), by_id);
+
+        if (it != entities.end() && GetEntityId(*it) == GetEntityId(entity))
+            *it = entity;
+        else
+            entities.insert(it, entity);
+    }
+
+    for (const auto& id : removed)
+    {
+        const auto it = std::lower_bound(entities.begin(), entities.end(), GetEntityId(id), by_id);
+
+        if (it != entities.end() && GetEntityId(*it) == GetEntityId(id))
+            entities.erase(it);
+    }
+}
+
+/**
+ * \brief Calls \code visit\endcode with the size of each record of a delta and a function
+ * which writes the record to a packet.
+ */
+template <typename F>
+static void ForEachRecord(const SnapshotDelta& delta, F&& visit)
+{
+    for (const auto& player : delta.updated_players)
+    {
+        visit(PLAYER_UPDATE_SIZE, [&player](Packet& packet)
+        {
+            packet.Write(SnapshotRecord::PlayerUpdate);
+            packet.Write(player.id);
+            packet.Write(player.position);
+        });
+    }
+
+    for (const auto& id : delta.removed_players)
+    {
+        visit(PLAYER_REMOVE_SIZE, [id](Packet& packet)
+        {
+            packet.Write(SnapshotRecord::PlayerRemove);
+            packet.Write(id);
+        });
+    }
+
+    for (const auto& projectile : delta.updated_projectiles)
+    {
+        visit(PROJECTILE_UPDATE_SIZE, [&projectile](Packet& packet)
+        {
+            packet.Write(SnapshotRecord::ProjectileUpdate);
+            packet.Write(projectile.id);
+            packet.Write(projectile.position);
+            packet.Write(projectile.rotation);
+        });
+    }
+
+    for (const auto& id : delta.removed_projectiles)
+    {
+        visit(PROJECTILE_REMOVE_SIZE, [id](Packet& packet)
+        {
+            packet.Write(SnapshotRecord::ProjectileRemove);
+            packet.Write(id);
+        });
+    }
+}
+
+void SortSnapshot(WorldSnapshot& snapshot)
+{
+    const auto by_id = [](const auto& a, const auto& b) { return GetEntityId(a) < GetEntityId(b); };
+
+    std::ranges::sort(snapshot.players, by_id);
+    std::ranges::sort(snapshot.projectiles, by_id);
+}
+
+SnapshotDelta ComputeSnapshotDelta(const WorldSnapshot* baseline, const WorldSnapshot& current)
+{
+    static const WorldSnapshot empty{};
+    const WorldSnapshot& from = baseline ? *baseline : empty;
+
+    SnapshotDelta delta{};
+    delta.sequence = current.sequence;
+    delta.baseline = from.sequence;
+
+    DiffEntities(from.players, current.players, delta.updated_players, delta.removed_players);
+    DiffEntities(from.projectiles, current.projectiles, delta.updated_projectiles, delta.removed_projectiles);
+
+    return delta;
+}
+
+void ApplySnapshotDelta(const SnapshotDelta& delta, WorldSnapshot& snapshot)
+{
+    PatchEntities(snapshot.players, delta.updated_players, delta.removed_players);
+    PatchEntities(snapshot.projectiles, delta.updated_projectiles, delta.removed_projectiles);
+
+    snapshot.sequence = delta.sequence;
+}
+
+bool LimitSnapshotDelta(SnapshotDelta& delta, const glm::vec2 focus)
+{
+    int budget = MAX_SNAPSHOT_RECORD_BYTES;
+
+    // Keeps as many of a list of records as the remaining budget allows.
+    const auto keep = [&budget](auto& records, const int size)
+    {
+        const size_t count = std::min(records.size(), static_cast<size_t>(budget / size));
+        const bool is_limited = count < records.size();
+
+        records.erase(records.begin() + static_cast<ptrdiff_t>(count), records.end());
+        budget -= static_cast<int>(count) * size;
+
+        return is_limited;
+    };
+
+    // Removals are the smallest records, and the players matter more than the projectiles.
+    bool is_limited = keep(delta.removed_players, PLAYER_REMOVE_SIZE);
+    is_limited |= keep(delta.removed_projectiles, PROJECTILE_REMOVE_SIZE);
+    is_limited |= keep(delta.updated_players, PLAYER_UPDATE_SIZE);
+
+    // Only the projectiles nearest to the focus are kept when they do not all fit.
+    std::vector<ProjectileSnapshot>& projectiles = delta.updated_projectiles;
+    const size_t count = static_cast<size_t>(budget / PROJECTILE_UPDATE_SIZE);
+
+    if (count < projectiles.size())
+    {
+        const auto by_distance = [focus](const ProjectileSnapshot& a, const ProjectileSnapshot& b)
+        {
+            return glm::distance(a.position, focus) < glm::distance(b.position, focus);
+        };
+
+        std::nth_element(projectiles.begin(), projectiles.begin() + static_cast<ptrdiff_t>(count), projectiles.end(),
+                         by_distance);
+        projectiles.erase(projectiles.begin() + static_cast<ptrdiff_t>(count), projectiles.end());
+
+        is_limited = true;
+    }
+
+    return is_limited;
+}
+
+int WriteSnapshotDelta(const SnapshotDelta& delta, std::vector<Packet>& fragments)
+{
+    // Pack the records greedily, first to count the fragments which every fragment
+    // declares, then to write them.
+    int fragment_count = 1, used = 0;
+    ForEachRecord(delta, [&fragment_count, &used](const int size, auto&&)
+    {
+        if (used + size > FRAGMENT_CAPACITY)
+        {
+            fragment_count++;
+            used = 0;
+        }
+
+        used += size;
+    });
+
+    if (fragment_count > MAX_SNAPSHOT_FRAGMENTS)
+    {
+        SCX_CORE_ERROR("Snapshot {0} needs {1} fragments, which exceeds the maximum of {2}.", delta.sequence,
+                       fragment_count, MAX_SNAPSHOT_FRAGMENTS);
+        return 0;
+    }
+
+    const auto begin_fragment = [&delta, &fragments, fragment_count](const int index)
+    {
+        Packet& fragment = fragments.emplace_back(PacketType::SnapshotDelta);
+        fragment.Write(delta.sequence);
+        fragment.Write(delta.baseline);
+        fragment.Write(static_cast<uint8_t>(index));
+        fragment.Write(static_cast<uint8_t>(fragment_count));
+    };
+
+    int index = 0;
+    used = 0;
+    begin_fragment(index);
+
+    ForEachRecord(delta, [&](const int size, auto&& write)
+    {
+        if (used + size > FRAGMENT_CAPACITY)
+        {
+            begin_fragment(++index);
+            used = 0;
+        }
+
+        write(fragments.back());
+        used += size;
+    });
+
+    return fragment_count;
+}
+
+bool SnapshotReceiver::Receive(Packet& fragment, SnapshotDelta& changes)
+{
+    uint32_t sequence, baseline;
+    uint8_t index, count;
+
+    if (fragment.Read(sequence) != PacketCode_Success || fragment.Read(baseline) != PacketCode_Success ||
+        fragment.Read(index) != PacketCode_Success || fragment.Read(count) != PacketCode_Success)
+        return false;
+
+    if (count == 0 || index >= count)
+        return false;
+
+    // Snapshots which are no newer than the latest one are no longer of any use.
+    if (sequence <= m_latest.sequence || sequence < m_pending_sequence)
+        return false;
+
+    if (sequence != m_pending_sequence)
+    {
+        // A newer snapshot has started to arrive, so abandon the one being assembled.
+        m_pending_sequence = sequence;
+        m_pending_baseline = baseline;
+        m_pending_fragments.assign(count, Packet{});
+        m_pending_received.assign(count, false);
+        m_pending_count = 0;
+    }
+
+    if (count != static_cast<uint8_t>(m_pending_fragments.size()) || baseline != m_pending_baseline || m_pending_received[index])
+        return false;
+
+    // The header has already been read, so only the records are read from the stored fragment.
+    m_pending_fragments[index] = fragment;
+    m_pending_received[index] = true;
+
+    if (++m_pending_count < count)
+        return false;
+
+    return Reconstruct(changes);
+}
+
+const WorldSnapshot& SnapshotReceiver::GetLatest() const
+{
+    return m_latest;
+}
+
+bool SnapshotReceiver::Reconstruct(SnapshotDelta& changes)
+{
+    SnapshotDelta delta{};
+    delta.sequence = m_pending_sequence;
+    delta.baseline = m_pending_baseline;
+
+    bool is_valid = true;
+
+    for (auto& fragment : m_pending_fragments)
+    {
+        // Every field must be read in full, so a truncated record invalidates the snapshot
+        // rather than being read past the end of the fragment.
+        const auto read = [&fragment, &is_valid](auto& dest)
+        {
+            is_valid = is_valid && fragment.Read(dest) == PacketCode_Success;
+        };
+
+        SnapshotRecord record;
+        while (is_valid && fragment.Read(record) == PacketCode_Success)
+        {
+            switch (record)
+            {
+            case SnapshotRecord::PlayerUpdate:
+                {
+                    PlayerSnapshot& player = delta.updated_players.emplace_back();
+                    read(player.id);
+                    read(player.position);
+                    break;
+                }
+            case SnapshotRecord::PlayerRemove:
+                read(delta.removed_players.emplace_back());
+                break;
+            case SnapshotRecord::ProjectileUpdate:
+                {
+                    ProjectileSnapshot& projectile = delta.updated_projectiles.emplace_back();
+                    read(projectile.id);
+                    read(projectile.position);
+                    read(projectile.rotation);
+                    break;
+                }
+            case SnapshotRecord::ProjectileRemove:
+                read(delta.removed_projectiles.emplace_back());
+                break;
+            default:
+                is_valid = false;
+                break;
+            }
+        }
+    }
+
+    m_pending_sequence = 0;
+    m_pending_baseline = 0;
+    m_pending_fragments.clear();
+    m_pending_received.clear();
+    m_pending_count = 0;
+
+    if (!is_valid)
+        return false;
+
+    WorldSnapshot snapshot{};
+
+    if (delta.baseline != 0)
+    {
+        // The server only uses a baseline which has been acknowledged, so it can only be
+        // missing if the snapshot is too old to be of use.
+        const WorldSnapshot& baseline = m_history[delta.baseline % SNAPSHOT_HISTORY];
+        if (baseline.sequence != delta.baseline)
+            return false;
+
+        snapshot = baseline;
+    }
+
+    ApplySnapshotDelta(delta, snapshot);
+
+    changes = ComputeSnapshotDelta(&m_latest, snapshot);
+
+    m_history[snapshot.sequence % SNAPSHOT_HISTORY] = snapshot;
+    m_latest = std::move(snapshot);
+
+    return true;
+}
+
+uint64_t GetEntityId(const unsigned int player_id)
+{
+    return player_id;
+}
+
+uint64_t GetEntityId(const UUID projectile_id)
+{
+    return static_cast<uint64_t>(projectile_id);
+}
+
+uint64_t GetEntityId(const PlayerSnapshot& player)
+{
+    return GetEntityId(player.id);
+}
+
+uint64_t GetEntityId(const ProjectileSnapshot& projectile)
+{
+    return GetEntityId(projectile.id);
+}
+
+bool operator==(const PlayerSnapshot& a, const PlayerSnapshot& b)
+{
+    return a.id == b.id && a.position == b.position;
+}
+
+bool operator==(const ProjectileSnapshot& a, const ProjectileSnapshot& b)
+{
+    return a.id == b.id && a.position == b.position && a.rotation == b.rotation;
+}
@@ -0,0 +1,100 @@
+#include "common/static_geometry.h"
+
+#include <utility>
+
+StaticGeometry::StaticGeometry()
+    : m_origin{ 0.0f, 0.0f },
+      m_cell_size{ STATIC_GEOMETRY_CELL_SIZE },
+      m_columns{ 0 },
+      m_rows{ 0 }
+{
+}
+
+StaticGeometry::StaticGeometry(std::vector<StaticBox> boxes, const float cell_size)
+    : m_boxes{ std::move(boxes) },
+      m_origin{ 0.0f, 0.0f },
+      m_cell_size{ cell_size },
+      m_columns{ 0 },
+      m_rows{ 0 }
+{
+    if (m_boxes.empty())
+        return;
+
+    // The grid only needs to cover the boxes themselves.
+    glm::vec2 max = m_boxes[0].max;
+    m_origin = m_boxes[0].min;
+
+    for (const auto& box : m_boxes)
+    {
+        m_origin = { std::min(m_origin.x, box.min.x), std::min(m_origin.y, box.min.y) };
+        max = { std::max(max.x, box.max.x), std::max(max.y, box.max.y) };
+    }
+
+    m_columns = ToCell(max.x, m_origin.x) + 1;
+    m_rows = ToCell(max.y, m_origin.y) + 1;
+
+    // Count the boxes in each cell, then turn the counts into the offset of each cell.
+    m_cell_offsets.assign(static_cast<size_t>(m_columns) * m_rows + 1, 0);
+
+    const auto for_each_cell = [this](const StaticBox& box, auto&& visit)
+    {
+        for (int y = ToCell(box.min.y, m_origin.y); y <= ToCell(box.max.y, m_origin.y); y++)
+        {
+            for (int x = ToCell(box.min.x, m_origin.x); x <= ToCell(box.max.x, m_origin.x); x++)
+                visit(static_cast<size_t>(y) * m_columns + x);
+        }
+    };
+
+    for (const auto& box : m_boxes)
+        for_each_cell(box, [this](const size_t cell) { m_cell_offsets[cell + 1]++; });
+
+    for (size_t i = 1; i < m_cell_offsets.size(); i++)
+        m_cell_offsets[i] += m_cell_offsets[i - 1];
+
+    m_cell_indices.resize(m_cell_offsets.back());
+
+    std::vector<uint32_t> next_index{ m_cell_offsets.begin(), m_cell_offsets.end() - 1 };
+
+    for (uint32_t i = 0; i < m_boxes.size(); i++)
+        for_each_cell(m_boxes[i], [&](const size_t cell) { m_cell_indices[next_index[cell]++] = i; });
+}
+
+std::span<const StaticBox> StaticGeometry::GetBoxes() const
+{
+    return m_boxes;
+}
+
+bool StaticGeometry::IntersectsSegment(const StaticBox& box, const glm::vec2 start, const glm::vec2 end)
+{
+    // Clip the segment against the slab between each pair of opposite sides of the box.
+    const glm::vec2 direction = end - start;
+
+    float enter = 0.0f;
+    float exit = 1.0f;
+
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (direction[axis] == 0.0f)
+        {
+            // A segment parallel to the slab must start within it.
+            if (start[axis] < box.min[axis] || start[axis] > box.max[axis])
+                return false;
+
+            continue;
+        }
+
+        float near_time = (box.min[axis] - start[axis]) / direction[axis];
+        float far_time = (box.max[axis] - start[axis]) / direction[axis];
+
+        if (near_time > far_time)
+            std::swap(near_time, far_time);
+
+        enter = std::max(enter, near_time);
+        exit = std::min(exit, far_time);
+
+        if (enter > exit)
+            return false;
+    }
+
+    return true;
+}
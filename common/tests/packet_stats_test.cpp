@@ -0,0 +1,57 @@
+#define CLOVE_SUITE_NAME PacketStatsTests
+#include <clove-unit.h>
+
+#include <common/networking/packet_stats.h>
+
+#include <thread>
+
+// Test 1
+CLOVE_TEST(TestCountsEachPacketType)
+{
+    /**
+     * This test ensures that sent, received and handled packets are counted against their own
+     * packet type, and that a broadcast is counted once for each connection.
+     */
+
+    const PacketStatsSnapshot before = PacketStats::GetSnapshot();
+
+    PacketStats::RecordSent(PacketType::SnapshotDelta, 40, 3);
+    PacketStats::RecordReceived(PacketType::PlayerInput, 6);
+    PacketStats::RecordHandled(PacketType::PlayerInput, std::chrono::microseconds{ 5 });
+
+    const PacketStatsSnapshot window = PacketStats::GetSnapshot().Since(before);
+    const PacketTypeStats& snapshots = window.Get(PacketType::SnapshotDelta);
+    const PacketTypeStats& inputs = window.Get(PacketType::PlayerInput);
+
+    CLOVE_UINT_EQ(3u, static_cast<unsigned int>(snapshots.messages_sent));
+    CLOVE_UINT_EQ(120u, static_cast<unsigned int>(snapshots.bytes_sent));
+    CLOVE_UINT_EQ(0u, static_cast<unsigned int>(snapshots.messages_received));
+
+    CLOVE_UINT_EQ(1u, static_cast<unsigned int>(inputs.messages_received));
+    CLOVE_UINT_EQ(6u, static_cast<unsigned int>(inputs.bytes_received));
+    CLOVE_UINT_EQ(1u, static_cast<unsigned int>(inputs.handled));
+    CLOVE_UINT_EQ(5000u, static_cast<unsigned int>(inputs.handle_ns));
+}
+
+// Test 2
+CLOVE_TEST(TestMergesThreads)
+{
+    /**
+     * This test ensures that the packets counted by several threads are merged into a single
+     * snapshot, including those of threads which have exited.
+     */
+
+    const PacketStatsSnapshot before = PacketStats::GetSnapshot();
+
+    std::thread first{ [] { PacketStats::RecordReceived(PacketType::ChatMessageOutbound, 20); } };
+    std::thread second{ [] { PacketStats::RecordReceived(PacketType::ChatMessageOutbound, 30); } };
+    first.join();
+    second.join();
+
+    const PacketStatsSnapshot window = PacketStats::GetSnapshot().Since(before);
+    const PacketTypeStats total = window.GetTotal();
+
+    CLOVE_UINT_EQ(2u, static_cast<unsigned int>(window.Get(PacketType::ChatMessageOutbound).messages_received));
+    CLOVE_UINT_EQ(50u, static_cast<unsigned int>(total.bytes_received));
+    CLOVE_UINT_EQ(0u, static_cast<unsigned int>(total.messages_sent));
+}
@@ -295,3 +295,147 @@ CLOVE_TEST(TestWriteReadTwoStrings)
     CLOVE_STRING_EQ(write_value1.c_str(), read_value1.c_str());
     CLOVE_STRING_EQ(write_value2.c_str(), read_value2.c_str());
 }
+
+// Test 13
+CLOVE_TEST(TestEncodeOnlyWrittenBytes)
+{
+    /**
+     * This test ensures that an encoded packet only contains its header and the bytes
+     * of its payload which have been written.
+     */
+
+    Packet test_packet{ PacketType::PlayerMovement };
+
+    test_packet.Write(1u);
+    test_packet.Write(2.0f);
+    test_packet.Write(3.0f);
+
+    unsigned char buffer[MAX_ENCODED_PACKET_SIZE];
+    const int encoded_size = test_packet.Encode(buffer, sizeof(buffer));
+
+    CLOVE_INT_EQ(PACKET_HEADER_SIZE + 12, encoded_size);
+    CLOVE_INT_EQ(test_packet.GetEncodedSize(), encoded_size);
+}
+
+// Test 14
+CLOVE_TEST(TestDecodeAfterEncode)
+{
+    /**
+     * This test ensures that a decoded packet has the same type and contents as the packet
+     * which was encoded.
+     */
+
+    Packet test_packet{ PacketType::ChatMessageInbound };
+
+    const std::string write_value1 = "this is a test packet";
+    constexpr int write_value2 = 7;
+
+    test_packet.Write(write_value1);
+    test_packet.Write(write_value2);
+
+    unsigned char buffer[MAX_ENCODED_PACKET_SIZE];
+    const int encoded_size = test_packet.Encode(buffer, sizeof(buffer));
+
+    Packet decoded_packet{};
+    const int i_result = decoded_packet.Decode(buffer, encoded_size);
+
+    std::string read_value1;
+    decoded_packet.Read(read_value1);
+
+    int read_value2;
+    decoded_packet.Read(read_value2);
+
+    CLOVE_INT_EQ(PacketCode_Success, i_result);
+    CLOVE_IS_TRUE(decoded_packet.GetType() == PacketType::ChatMessageInbound);
+    CLOVE_INT_EQ(test_packet.GetSize(), decoded_packet.GetSize());
+    CLOVE_STRING_EQ(write_value1.c_str(), read_value1.c_str());
+    CLOVE_INT_EQ(write_value2, read_value2);
+}
+
+// Test 15
+CLOVE_TEST(TestDecodeMismatchedLength)
+{
+    /**
+     * This test ensures that a packet whose declared payload length does not match the size
+     * of the received data is rejected.
+     */
+
+    Packet test_packet{ PacketType::PlayerInput };
+    test_packet.Write(5);
+
+    unsigned char buffer[MAX_ENCODED_PACKET_SIZE];
+    const int encoded_size = test_packet.Encode(buffer, sizeof(buffer));
+
+    Packet decoded_packet{};
+
+    CLOVE_INT_EQ(PacketCode_MalformedE, decoded_packet.Decode(buffer, encoded_size - 1));
+    CLOVE_INT_EQ(PacketCode_MalformedE, decoded_packet.Decode(buffer, encoded_size + 1));
+    CLOVE_INT_EQ(PacketCode_MalformedE, decoded_packet.Decode(buffer, PACKET_HEADER_SIZE - 1));
+}
+
+// Test 16
+CLOVE_TEST(TestDecodeInvalidHeader)
+{
+    /**
+     * This test ensures that a packet with an unknown type or an oversized payload is rejected.
+     */
+
+    unsigned char buffer[MAX_ENCODED_PACKET_SIZE]{};
+
+    Packet decoded_packet{};
+
+    const PacketHeader invalid_type{ .type = static_cast<uint8_t>(PacketType::Count), .size = 0 };
+    std::memcpy(buffer, &invalid_type, PACKET_HEADER_SIZE);
+
+    CLOVE_INT_EQ(PacketCode_MalformedE, decoded_packet.Decode(buffer, PACKET_HEADER_SIZE));
+
+    const PacketHeader oversized{ .type = static_cast<uint8_t>(PacketType::PlayerInput), .size = PACKET_SIZE };
+    std::memcpy(buffer, &oversized, PACKET_HEADER_SIZE);
+
+    CLOVE_INT_EQ(PacketCode_MalformedE, decoded_packet.Decode(buffer, MAX_ENCODED_PACKET_SIZE));
+}
+
+// Test 17
+CLOVE_TEST(TestPacketDelivery)
+{
+    /**
+     * This test ensures that continuous state is sent unreliably, while events are sent reliably.
+     */
+
+    CLOVE_IS_TRUE(GetPacketDelivery(PacketType::PlayerMovement) != PacketDelivery::Reliable);
+    CLOVE_IS_TRUE(GetPacketDelivery(PacketType::PlayerWeaponRotation) != PacketDelivery::Reliable);
+    CLOVE_IS_TRUE(GetPacketDelivery(PacketType::ProjectileUpdate) != PacketDelivery::Reliable);
+
+    CLOVE_IS_TRUE(GetPacketDelivery(PacketType::Welcome) == PacketDelivery::Reliable);
+    CLOVE_IS_TRUE(GetPacketDelivery(PacketType::PlayerDeath) == PacketDelivery::Reliable);
+    CLOVE_IS_TRUE(GetPacketDelivery(PacketType::ProjectileDestroy) == PacketDelivery::Reliable);
+    CLOVE_IS_TRUE(GetPacketDelivery(PacketType::ChatMessageInbound) == PacketDelivery::Reliable);
+}
+
+// Test 18
+CLOVE_TEST(TestReadPastEndOfPacket)
+{
+    /**
+     * This test ensures that a read of a value larger than what is left of a packet fails
+     * without reading anything, and that an unterminated string is reported as malformed.
+     */
+
+    Packet test_packet{};
+    test_packet.Write(uint16_t{ 7 });
+
+    int read_value = -1;
+    CLOVE_INT_EQ(PacketCode_NoDataToReadE, test_packet.Read(read_value));
+    CLOVE_INT_EQ(-1, read_value);
+
+    uint16_t short_value = 0;
+    CLOVE_INT_EQ(PacketCode_Success, test_packet.Read(short_value));
+    CLOVE_INT_EQ(7, short_value);
+
+    Packet string_packet{};
+    string_packet.Write('a');
+    string_packet.Write('b');
+
+    std::string read_string = "unchanged";
+    CLOVE_INT_EQ(PacketCode_MalformedE, string_packet.Read(read_string));
+    CLOVE_IS_TRUE(read_string == "unchanged");
+}
@@ -0,0 +1,306 @@
+#define CLOVE_SUITE_NAME SnapshotTests
+#include <clove-unit.h>
+
+#include <common/networking/snapshot.h>
+
+#include <vector>
+
+/**
+ * \brief Creates a snapshot with the given number of players and projectiles, each placed
+ * at a position derived from its index.
+ */
+static WorldSnapshot CreateSnapshot(const uint32_t sequence, const int player_count, const int projectile_count)
+{
+    WorldSnapshot snapshot{};
+    snapshot.sequence = sequence;
+
+    for (int i = 0; i < player_count; i++)
+        snapshot.players.push_back({ .id = static_cast<unsigned int>(i + 1), .position = { i * 10.0f, 0.0f } });
+
+    for (int i = 0; i < projectile_count; i++)
+    {
+        snapshot.projectiles.push_back({
+            .id = UUID{ static_cast<uint64_t>(i + 1) }, .position = { 0.0f, i * 10.0f }, .rotation = 0.5f
+        });
+    }
+
+    SortSnapshot(snapshot);
+
+    return snapshot;
+}
+
+/**
+ * \brief Passes every fragment of a delta to a receiver.
+ */
+static bool Deliver(SnapshotReceiver& receiver, const SnapshotDelta& delta, SnapshotDelta& changes)
+{
+    std::vector<Packet> fragments;
+    WriteSnapshotDelta(delta, fragments);
+
+    bool is_reconstructed = false;
+    for (auto& fragment : fragments)
+        is_reconstructed = receiver.Receive(fragment, changes);
+
+    return is_reconstructed;
+}
+
+// Test 1
+CLOVE_TEST(TestFullSnapshotRoundTrip)
+{
+    /**
+     * This test ensures that a snapshot sent without a baseline is reconstructed exactly.
+     */
+
+    const WorldSnapshot snapshot = CreateSnapshot(1, 4, 3);
+
+    SnapshotReceiver receiver{};
+    SnapshotDelta changes{};
+
+    CLOVE_IS_TRUE(Deliver(receiver, ComputeSnapshotDelta(nullptr, snapshot), changes));
+
+    const WorldSnapshot& latest = receiver.GetLatest();
+
+    CLOVE_INT_EQ(1, static_cast<int>(latest.sequence));
+    CLOVE_INT_EQ(4, static_cast<int>(latest.players.size()));
+    CLOVE_INT_EQ(3, static_cast<int>(latest.projectiles.size()));
+    CLOVE_FLOAT_EQ(30.0f, latest.players[3].position.x);
+    CLOVE_IS_TRUE(latest.projectiles[2].id == UUID{ 3 });
+    CLOVE_FLOAT_EQ(20.0f, latest.projectiles[2].position.y);
+}
+
+// Test 2
+CLOVE_TEST(TestDeltaOnlyHoldsChangedEntities)
+{
+    /**
+     * This test ensures that entities which have not changed since the baseline are left
+     * out of a delta.
+     */
+
+    const WorldSnapshot baseline = CreateSnapshot(1, 16, 16);
+
+    WorldSnapshot current = baseline;
+    current.sequence = 2;
+    current.players[5].position.y = 25.0f;
+
+    const SnapshotDelta delta = ComputeSnapshotDelta(&baseline, current);
+
+    CLOVE_INT_EQ(1, static_cast<int>(delta.updated_players.size()));
+    CLOVE_INT_EQ(6, static_cast<int>(delta.updated_players[0].id));
+    CLOVE_IS_TRUE(delta.removed_players.empty());
+    CLOVE_IS_TRUE(delta.updated_projectiles.empty());
+    CLOVE_IS_TRUE(delta.removed_projectiles.empty());
+
+    std::vector<Packet> fragments;
+    CLOVE_INT_EQ(1, WriteSnapshotDelta(delta, fragments));
+}
+
+// Test 3
+CLOVE_TEST(TestDeltaAgainstAcknowledgedBaseline)
+{
+    /**
+     * This test ensures that a delta against a baseline the receiver holds reconstructs the
+     * full snapshot, including removed and newly added entities.
+     */
+
+    SnapshotReceiver receiver{};
+    SnapshotDelta changes{};
+
+    const WorldSnapshot baseline = CreateSnapshot(1, 3, 2);
+    Deliver(receiver, ComputeSnapshotDelta(nullptr, baseline), changes);
+
+    WorldSnapshot current = CreateSnapshot(2, 2, 3);
+    current.players[0].position.x = -5.0f;
+
+    CLOVE_IS_TRUE(Deliver(receiver, ComputeSnapshotDelta(&baseline, current), changes));
+
+    const WorldSnapshot& latest = receiver.GetLatest();
+
+    CLOVE_INT_EQ(2, static_cast<int>(latest.sequence));
+    CLOVE_INT_EQ(2, static_cast<int>(latest.players.size()));
+    CLOVE_FLOAT_EQ(-5.0f, latest.players[0].position.x);
+    CLOVE_INT_EQ(3, static_cast<int>(latest.projectiles.size()));
+
+    // The changes reported to the game are relative to the previous snapshot.
+    CLOVE_INT_EQ(1, static_cast<int>(changes.removed_players.size()));
+    CLOVE_INT_EQ(3, static_cast<int>(changes.removed_players[0]));
+    CLOVE_INT_EQ(1, static_cast<int>(changes.updated_projectiles.size()));
+}
+
+// Test 4
+CLOVE_TEST(TestMissingBaselineIsRejected)
+{
+    /**
+     * This test ensures that a delta against a baseline the receiver never reconstructed
+     * is rejected.
+     */
+
+    SnapshotReceiver receiver{};
+    SnapshotDelta changes{};
+
+    const WorldSnapshot baseline = CreateSnapshot(1, 2, 0);
+    const WorldSnapshot current = CreateSnapshot(2, 3, 0);
+
+    CLOVE_IS_FALSE(Deliver(receiver, ComputeSnapshotDelta(&baseline, current), changes));
+    CLOVE_INT_EQ(0, static_cast<int>(receiver.GetLatest().sequence));
+}
+
+// Test 5
+CLOVE_TEST(TestFragmentedSnapshotOutOfOrder)
+{
+    /**
+     * This test ensures that a snapshot which is too large for a single packet is split into
+     * fragments, and reconstructed regardless of the order in which they arrive.
+     */
+
+    const WorldSnapshot snapshot = CreateSnapshot(1, 32, 64);
+
+    std::vector<Packet> fragments;
+    const int fragment_count = WriteSnapshotDelta(ComputeSnapshotDelta(nullptr, snapshot), fragments);
+
+    CLOVE_INT_GT(fragment_count, 1);
+    CLOVE_INT_EQ(fragment_count, static_cast<int>(fragments.size()));
+
+    SnapshotReceiver receiver{};
+    SnapshotDelta changes{};
+
+    for (int i = fragment_count - 1; i > 0; i--)
+        CLOVE_IS_FALSE(receiver.Receive(fragments[i], changes));
+
+    CLOVE_IS_TRUE(receiver.Receive(fragments[0], changes));
+    CLOVE_INT_EQ(32, static_cast<int>(receiver.GetLatest().players.size()));
+    CLOVE_INT_EQ(64, static_cast<int>(receiver.GetLatest().projectiles.size()));
+}
+
+// Test 6
+CLOVE_TEST(TestIncompleteSnapshotIsSuperseded)
+{
+    /**
+     * This test ensures that a snapshot with a lost fragment is abandoned once a newer
+     * snapshot arrives, and that older fragments are ignored afterwards.
+     */
+
+    std::vector<Packet> old_fragments;
+    WriteSnapshotDelta(ComputeSnapshotDelta(nullptr, CreateSnapshot(1, 32, 64)), old_fragments);
+
+    SnapshotReceiver receiver{};
+    SnapshotDelta changes{};
+
+    // Lose the last fragment of the first snapshot.
+    for (size_t i = 0; i + 1 < old_fragments.size(); i++)
+        receiver.Receive(old_fragments[i], changes);
+
+    CLOVE_IS_TRUE(Deliver(receiver, ComputeSnapshotDelta(nullptr, CreateSnapshot(2, 1, 0)), changes));
+    CLOVE_IS_FALSE(receiver.Receive(old_fragments.back(), changes));
+    CLOVE_INT_EQ(2, static_cast<int>(receiver.GetLatest().sequence));
+}
+
+// Test 7
+CLOVE_TEST(TestTruncatedFragmentIsRejected)
+{
+    /**
+     * This test ensures that a fragment whose header or last record is cut short is rejected
+     * without being read past its end, and that the snapshot can still be received intact.
+     */
+
+    SnapshotReceiver receiver{};
+    SnapshotDelta changes{};
+
+    Packet header_only{ PacketType::SnapshotDelta };
+    header_only.Write(uint32_t{ 1 });
+    header_only.Write(uint32_t{ 0 });
+
+    CLOVE_IS_FALSE(receiver.Receive(header_only, changes));
+
+    // A player update record which is missing the player's position.
+    Packet truncated{ PacketType::SnapshotDelta };
+    truncated.Write(uint32_t{ 1 });
+    truncated.Write(uint32_t{ 0 });
+    truncated.Write(uint8_t{ 0 });
+    truncated.Write(uint8_t{ 1 });
+    truncated.Write(uint8_t{ 0 });
+    truncated.Write(1u);
+
+    CLOVE_IS_FALSE(receiver.Receive(truncated, changes));
+    CLOVE_INT_EQ(0, static_cast<int>(receiver.GetLatest().sequence));
+
+    CLOVE_IS_TRUE(Deliver(receiver, ComputeSnapshotDelta(nullptr, CreateSnapshot(1, 2, 1)), changes));
+    CLOVE_INT_EQ(2, static_cast<int>(receiver.GetLatest().players.size()));
+}
+
+// Test 8
+CLOVE_TEST(TestMalformedFragmentIsRejected)
+{
+    /**
+     * This test ensures that a fragment holding a record of an unknown kind is rejected, and
+     * that none of its records are applied.
+     */
+
+    std::vector<Packet> fragments;
+    WriteSnapshotDelta(ComputeSnapshotDelta(nullptr, CreateSnapshot(1, 2, 0)), fragments);
+
+    CLOVE_INT_EQ(1, static_cast<int>(fragments.size()));
+
+    fragments[0].Write(uint8_t{ 200 });
+
+    SnapshotReceiver receiver{};
+    SnapshotDelta changes{};
+
+    CLOVE_IS_FALSE(receiver.Receive(fragments[0], changes));
+    CLOVE_INT_EQ(0, static_cast<int>(receiver.GetLatest().sequence));
+    CLOVE_INT_EQ(0, static_cast<int>(receiver.GetLatest().players.size()));
+}
+
+// Test 9
+CLOVE_TEST(TestOversizedSnapshotIsSentOverSeveralTicks)
+{
+    /**
+     * This test ensures that a world too large for one snapshot is still sent every tick, cut
+     * down to the projectiles nearest the focus, and that the rest arrive in the deltas against
+     * the snapshots the receiver has reconstructed.
+     */
+
+    constexpr int projectile_count = 4000;
+
+    SnapshotReceiver receiver{};
+    SnapshotDelta changes{};
+
+    // The snapshot the sender remembers the receiver holding.
+    WorldSnapshot sent{};
+    bool is_complete = false;
+
+    for (uint32_t sequence = 1; sequence <= 8 && !is_complete; sequence++)
+    {
+        const WorldSnapshot current = CreateSnapshot(sequence, 32, projectile_count);
+
+        SnapshotDelta delta = ComputeSnapshotDelta(sequence > 1 ? &sent : nullptr, current);
+        is_complete = !LimitSnapshotDelta(delta, { 0.0f, 0.0f });
+
+        std::vector<Packet> fragments;
+        const int fragment_count = WriteSnapshotDelta(delta, fragments);
+
+        CLOVE_IS_TRUE(fragment_count > 0 && fragment_count <= MAX_SNAPSHOT_FRAGMENTS);
+
+        bool is_reconstructed = false;
+        for (auto& fragment : fragments)
+            is_reconstructed = receiver.Receive(fragment, changes);
+
+        CLOVE_IS_TRUE(is_reconstructed);
+
+        ApplySnapshotDelta(delta, sent);
+
+        const WorldSnapshot& latest = receiver.GetLatest();
+        CLOVE_INT_EQ(static_cast<int>(sent.projectiles.size()), static_cast<int>(latest.projectiles.size()));
+
+        // The first snapshot holds every player and only the nearest projectiles.
+        if (sequence == 1)
+        {
+            CLOVE_IS_FALSE(is_complete);
+            CLOVE_INT_EQ(32, static_cast<int>(latest.players.size()));
+            CLOVE_FLOAT_EQ((static_cast<float>(latest.projectiles.size()) - 1.0f) * 10.0f,
+                           latest.projectiles.back().position.y);
+        }
+    }
+
+    CLOVE_IS_TRUE(is_complete);
+    CLOVE_INT_EQ(projectile_count, static_cast<int>(receiver.GetLatest().projectiles.size()));
+}
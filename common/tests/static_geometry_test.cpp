@@ -0,0 +1,111 @@
+#define CLOVE_SUITE_NAME StaticGeometryTests
+#include <clove-unit.h>
+
+#include <common/static_geometry.h>
+
+#include <random>
+#include <vector>
+
+/**
+ * \brief Counts the boxes visited by a box query.
+ */
+static int CountBoxQuery(const StaticGeometry& geometry, const glm::vec2 min, const glm::vec2 max)
+{
+    int count = 0;
+    geometry.QueryBox(min, max, [&count](const StaticBox&) { count++; });
+
+    return count;
+}
+
+/**
+ * \brief Counts the boxes visited by a segment query.
+ */
+static int CountSegmentQuery(const StaticGeometry& geometry, const glm::vec2 start, const glm::vec2 end)
+{
+    int count = 0;
+    geometry.QuerySegment(start, end, [&count](const StaticBox&) { count++; });
+
+    return count;
+}
+
+// Test 1
+CLOVE_TEST(TestEmptyGeometry)
+{
+    /**
+     * This test ensures that queries of geometry without any boxes visit nothing.
+     */
+
+    const StaticGeometry geometry{};
+
+    CLOVE_INT_EQ(0, CountBoxQuery(geometry, { -100.0f, -100.0f }, { 100.0f, 100.0f }));
+    CLOVE_INT_EQ(0, CountSegmentQuery(geometry, { -100.0f, -100.0f }, { 100.0f, 100.0f }));
+}
+
+// Test 2
+CLOVE_TEST(TestBoxSpanningCellsIsVisitedOnce)
+{
+    /**
+     * This test ensures that a box which spans many cells is visited once by a query which
+     * overlaps several of them.
+     */
+
+    const StaticGeometry geometry{ { { .min = { -200.0f, -10.0f }, .max = { 200.0f, 10.0f } } }, 16.0f };
+
+    CLOVE_INT_EQ(1, CountBoxQuery(geometry, { -100.0f, -50.0f }, { 100.0f, 50.0f }));
+    CLOVE_INT_EQ(1, CountSegmentQuery(geometry, { -150.0f, 0.0f }, { 150.0f, 0.0f }));
+}
+
+// Test 3
+CLOVE_TEST(TestSegmentMissesBoxBesideIt)
+{
+    /**
+     * This test ensures that a segment which passes beside a box, while overlapping its
+     * bounds, does not visit the box.
+     */
+
+    const StaticGeometry geometry{ { { .min = { 0.0f, 0.0f }, .max = { 10.0f, 10.0f } } } };
+
+    CLOVE_INT_EQ(0, CountSegmentQuery(geometry, { -5.0f, 8.0f }, { 5.0f, 30.0f }));
+    CLOVE_INT_EQ(1, CountSegmentQuery(geometry, { -5.0f, 5.0f }, { 5.0f, 5.0f }));
+}
+
+// Test 4
+CLOVE_TEST(TestBoxQueryMatchesEveryBox)
+{
+    /**
+     * This test ensures that a box query visits exactly the boxes which overlap the query, as
+     * found by testing every box.
+     */
+
+    std::mt19937 engine{ 2024 };
+    std::uniform_real_distribution position{ -500.0f, 500.0f };
+    std::uniform_real_distribution size{ 1.0f, 150.0f };
+
+    std::vector<StaticBox> boxes;
+    for (int i = 0; i < 200; i++)
+    {
+        const glm::vec2 min = { position(engine), position(engine) };
+        boxes.push_back({ .min = min, .max = min + glm::vec2{ size(engine), size(engine) } });
+    }
+
+    const StaticGeometry geometry{ boxes };
+
+    int mismatches = 0;
+    for (int i = 0; i < 500; i++)
+    {
+        const glm::vec2 min = { position(engine), position(engine) };
+        const glm::vec2 max = min + glm::vec2{ size(engine), size(engine) };
+
+        int expected = 0;
+        for (const auto& box : boxes)
+        {
+            if (box.min.x <= max.x && box.max.x >= min.x && box.min.y <= max.y && box.max.y >= min.y)
+                expected++;
+        }
+
+        if (CountBoxQuery(geometry, min, max) != expected)
+            mismatches++;
+    }
+
+    CLOVE_INT_EQ(0, mismatches);
+}
@@ -0,0 +1,380 @@
+#include "load_generator.h"
+
+#include <common/networking/core.h>
+#include <common/networking/packet.h>
+#include <common/networking/packet_stats.h>
+
+#include <common/utils/assertion.h>
+#include <common/utils/logging.h>
+
+#include <steam/isteamnetworkingutils.h>
+
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <thread>
+
+/**
+ * \brief The time between the reports of the traffic received.
+ */
+constexpr std::chrono::seconds REPORT_INTERVAL{ 1 };
+
+/**
+ * \brief How long to sleep between polls. Short enough that inputs are sent at up to 1000 Hz.
+ */
+constexpr std::chrono::milliseconds POLL_INTERVAL{ 1 };
+
+LoadGenerator* LoadGenerator::s_p_callback_instance = nullptr;
+
+LoadGenerator::LoadGenerator(const LoadGeneratorSettings& settings)
+    : m_dispatcher{ this },
+      m_settings{ settings },
+      m_interval_packets{ 0 },
+      m_interval_bytes{ 0 },
+      m_poll_group{ k_HSteamNetPollGroup_Invalid },
+      m_interface{ nullptr },
+      m_incoming_messages{}
+{
+    Initialise();
+}
+
+LoadGenerator::~LoadGenerator()
+{
+    Dispose();
+}
+
+void LoadGenerator::Initialise()
+{
+    s_p_callback_instance = this;
+
+#if defined(SCX_LOGGING)
+    Logging::Initialise("LOADGEN");
+#endif
+
+    // Setup SteamGameNetworkingSockets.
+    InitialiseSteamDatagramConnectionSockets();
+    m_interface = SteamNetworkingSockets();
+
+    m_poll_group = m_interface->CreatePollGroup();
+    if (m_poll_group == k_HSteamNetPollGroup_Invalid)
+        SCX_CORE_CRITICAL("Failed to create a poll group.");
+
+    m_clients.reserve(m_settings.clients);
+    for (unsigned int i = 0; i < m_settings.clients; i++)
+        m_clients.emplace_back(i, m_settings.mode, m_settings.seed);
+
+    SCX_CORE_INFO("Load generator initialised with {0} clients.", m_settings.clients);
+}
+
+void LoadGenerator::Run()
+{
+    ConnectClients();
+
+    m_start_time = std::chrono::steady_clock::now();
+    m_next_input_time = m_start_time;
+    m_next_chat_time = m_start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(m_settings.chat_interval));
+    m_next_report_time = m_start_time + REPORT_INTERVAL;
+
+    const auto end_time = m_start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(m_settings.duration));
+
+    while (IsAnyClientConnected())
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (m_settings.duration > 0.0 && now >= end_time)
+            break;
+
+        PollIncomingMessages();
+        PollConnectionStateChanges();
+
+        SendInputs(now);
+
+        if (now >= m_next_report_time)
+            Report(now);
+
+        std::this_thread::sleep_for(POLL_INTERVAL);
+    }
+
+    LogSummary();
+}
+
+SimulatedClient& LoadGenerator::GetClient(const unsigned int index)
+{
+    SCX_ASSERT(index < s_p_callback_instance->m_clients.size(), "There isn't a client with this index.");
+    return s_p_callback_instance->m_clients[index];
+}
+
+void LoadGenerator::Dispose()
+{
+    for (const auto& client : m_clients)
+    {
+        if (client.IsConnected())
+            m_interface->CloseConnection(client.GetConnection(), 0, "Load generator finished", true);
+    }
+
+    m_interface->DestroyPollGroup(m_poll_group);
+    m_poll_group = k_HSteamNetPollGroup_Invalid;
+
+    ShutdownSteamDatagramConnectionSockets();
+}
+
+void LoadGenerator::ConnectClients()
+{
+    SteamNetworkingIPAddr server_address{};
+    server_address.Clear();
+
+    if (!server_address.ParseString(m_settings.ip.c_str()))
+    {
+        SCX_CORE_ERROR("Invalid server address {0}.", m_settings.ip);
+        return;
+    }
+
+    server_address.m_port = m_settings.port;
+
+    char display_address[SteamNetworkingIPAddr::k_cchMaxString];
+    server_address.ToString(display_address, sizeof(display_address), true);
+    SCX_CORE_INFO("Connecting {0} clients to server at {1}.", m_clients.size(), display_address);
+
+    SteamNetworkingConfigValue_t options{};
+    options.SetPtr(k_ESteamNetworkingConfig_Callback_ConnectionStatusChanged,
+                   reinterpret_cast<void*>(SteamConnectionStatusChangedCallback));
+
+    for (auto& client : m_clients)
+    {
+        const HSteamNetConnection connection = m_interface->ConnectByIPAddress(server_address, 1, &options);
+        if (connection == k_HSteamNetConnection_Invalid)
+        {
+            SCX_CORE_ERROR("Failed to create connection for client {0}.", client.GetIndex());
+            continue;
+        }
+
+        // Tag the connection with the index of its client, so that messages and state changes can
+        // be routed to the client without a lookup.
+        m_interface->SetConnectionUserData(connection, client.GetIndex());
+        m_interface->SetConnectionPollGroup(connection, m_poll_group);
+
+        client.SetConnection(connection);
+    }
+}
+
+void LoadGenerator::PollIncomingMessages()
+{
+    while (true)
+    {
+        const int num_msgs = m_interface->ReceiveMessagesOnPollGroup(m_poll_group, m_incoming_messages.data(),
+                                                                     LOADGEN_RECEIVE_BATCH_SIZE);
+        if (num_msgs == 0)
+            break;
+        if (num_msgs < 0)
+        {
+            SCX_CORE_ERROR("An error occurred when checking for messages.");
+            break;
+        }
+
+        for (SteamNetworkingMessage_t* p_incoming_message : std::span{ m_incoming_messages.data(),
+                                                                       static_cast<size_t>(num_msgs) })
+        {
+            const auto index = static_cast<unsigned int>(p_incoming_message->m_nConnUserData);
+
+            SimulatedClientStats& stats = GetClient(index).GetStats();
+            stats.packets_received++;
+            stats.bytes_received += p_incoming_message->m_cbSize;
+
+            m_interval_packets++;
+            m_interval_bytes += p_incoming_message->m_cbSize;
+
+            Packet packet_received{};
+            if (packet_received.Decode(p_incoming_message->m_pData, p_incoming_message->m_cbSize) !=
+                PacketCode_Success)
+            {
+                SCX_CORE_WARN("Client {0} is dropping a malformed packet of {1} bytes.", index,
+                              p_incoming_message->m_cbSize);
+            }
+            else
+            {
+                PacketStats::RecordReceived(packet_received.GetType(), p_incoming_message->m_cbSize);
+
+                // The index of the client which received the packet is passed in place of the
+                // client ID, so that the handlers know which client to act on.
+                m_handler.Handle(index, packet_received, &m_dispatcher);
+            }
+
+            p_incoming_message->Release();
+        }
+    }
+}
+
+void LoadGenerator::PollConnectionStateChanges() const
+{
+    m_interface->RunCallbacks();
+}
+
+void LoadGenerator::SendInputs(const std::chrono::steady_clock::time_point now)
+{
+    if (m_settings.input_rate <= 0 || now < m_next_input_time)
+        return;
+
+    const bool is_chat_due = m_settings.chat_interval > 0.0 && now >= m_next_chat_time;
+    const double time = std::chrono::duration<double>(now - m_start_time).count();
+
+    for (auto& client : m_clients)
+    {
+        if (!client.IsJoined())
+            continue;
+
+        const SimulatedInput input = client.NextInput(time);
+
+        m_dispatcher.PlayerInput(client, input);
+        m_dispatcher.PlayerWeaponRotation(client, input.weapon_rotation);
+
+        if (is_chat_due)
+            m_dispatcher.SendChatMessage(client, "Message from " + client.GetUsername());
+    }
+
+    // Inputs are sent at a fixed rate. If the load generator falls behind, the missed inputs
+    // are skipped rather than sent in a burst.
+    const auto input_interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / m_settings.input_rate));
+    m_next_input_time = std::max(m_next_input_time + input_interval, now);
+
+    if (is_chat_due)
+    {
+        m_next_chat_time += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(m_settings.chat_interval));
+    }
+}
+
+void LoadGenerator::Report(const std::chrono::steady_clock::time_point now)
+{
+    size_t joined = 0;
+    size_t pinged = 0;
+    int min_ping = std::numeric_limits<int>::max();
+    int max_ping = 0;
+    int64_t total_ping = 0;
+
+    for (auto& client : m_clients)
+    {
+        if (!client.IsConnected())
+            continue;
+
+        if (client.IsJoined())
+            joined++;
+
+        SteamNetConnectionRealTimeStatus_t status{};
+        if (m_interface->GetConnectionRealTimeStatus(client.GetConnection(), &status, 0, nullptr) != k_EResultOK ||
+            status.m_eState != k_ESteamNetworkingConnectionState_Connected)
+        {
+            continue;
+        }
+
+        client.GetStats().RecordPing(status.m_nPing);
+        pinged++;
+
+        min_ping = std::min(min_ping, status.m_nPing);
+        max_ping = std::max(max_ping, status.m_nPing);
+        total_ping += status.m_nPing;
+    }
+
+    const auto last_report_time = m_next_report_time - REPORT_INTERVAL;
+    const double seconds = std::chrono::duration<double>(now - last_report_time).count();
+
+    if (pinged > 0)
+    {
+        SCX_CORE_INFO("{0}/{1} clients joined, RTT {2}/{3:.1f}/{4} ms (min/avg/max), "
+                      "{5:.0f} packets/s, {6:.1f} KB/s received.", joined, m_clients.size(), min_ping,
+                      static_cast<double>(total_ping) / static_cast<double>(pinged), max_ping,
+                      static_cast<double>(m_interval_packets) / seconds,
+                      static_cast<double>(m_interval_bytes) / 1024.0 / seconds);
+    }
+    else
+        SCX_CORE_INFO("{0}/{1} clients joined.", joined, m_clients.size());
+
+    m_interval_packets = 0;
+    m_interval_bytes = 0;
+    m_next_report_time = now + REPORT_INTERVAL;
+}
+
+void LoadGenerator::LogSummary() const
+{
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start_time).count();
+
+    SCX_CORE_INFO("Load generator ran for {0:.1f} s.", seconds);
+
+    for (const auto& client : m_clients)
+    {
+        const SimulatedClientStats& stats = client.GetStats();
+
+        if (stats.ping_samples == 0)
+        {
+            SCX_CORE_INFO("{0}: no round-trip times recorded, {1} packets received.", client.GetUsername(),
+                          stats.packets_received);
+            continue;
+        }
+
+        SCX_CORE_INFO("{0}: RTT {1}/{2:.1f}/{3} ms (min/avg/max), {4:.1f} packets/s, {5:.2f} KB/s received, "
+                      "{6} snapshots, {7} packets sent.", client.GetUsername(), stats.min_ping,
+                      stats.GetAveragePing(), stats.max_ping, static_cast<double>(stats.packets_received) / seconds,
+                      static_cast<double>(stats.bytes_received) / 1024.0 / seconds, stats.snapshots_received,
+                      stats.packets_sent);
+    }
+
+    PacketStats::LogSnapshot(PacketStats::GetSnapshot(), "Traffic of every client by packet type", seconds);
+}
+
+bool LoadGenerator::IsAnyClientConnected() const
+{
+    return std::ranges::any_of(m_clients, [](const SimulatedClient& client) { return client.IsConnected(); });
+}
+
+void LoadGenerator::SendToServer(SimulatedClient& client, const Packet& data) const
+{
+    unsigned char buffer[MAX_ENCODED_PACKET_SIZE];
+    const int size = data.Encode(buffer, sizeof(buffer));
+
+    m_interface->SendMessageToConnection(client.GetConnection(), buffer, size, GetSendFlags(data.GetType()), nullptr);
+    client.GetStats().packets_sent++;
+    PacketStats::RecordSent(data.GetType(), size);
+}
+
+void LoadGenerator::OnSteamConnectionStatusChangedCallback(const SteamNetConnectionStatusChangedCallback_t* p_info)
+{
+    const auto index = static_cast<unsigned int>(p_info->m_info.m_nUserData);
+
+    // Determine the state of the client's connection.
+    switch (p_info->m_info.m_eState)
+    {
+    case k_ESteamNetworkingConnectionState_None:
+        break;
+    case k_ESteamNetworkingConnectionState_ClosedByPeer:
+    case k_ESteamNetworkingConnectionState_ProblemDetectedLocally:
+        {
+            // Display appropriate log message.
+            if (p_info->m_eOldState == k_ESteamNetworkingConnectionState_Connecting)
+                SCX_CORE_ERROR("Client {0} failed to connect to the remote host.", index);
+            else if (p_info->m_info.m_eState == k_ESteamNetworkingConnectionState_ProblemDetectedLocally)
+                SCX_CORE_ERROR("Client {0} lost its connection to the remote host.", index);
+            else
+                SCX_CORE_WARN("Client {0} was disconnected by the remote host.", index);
+
+            // Cleanup the connection.
+            m_interface->CloseConnection(p_info->m_hConn, 0, nullptr, false);
+            GetClient(index).Disconnect();
+            break;
+        }
+    case k_ESteamNetworkingConnectionState_Connecting:
+        // This callback happens when the client starts connecting to the server.
+        // This can be ignored.
+        break;
+    case k_ESteamNetworkingConnectionState_Connected:
+        // The client joins once the server welcomes it.
+        break;
+    default:
+        break;
+    }
+}
+
+void LoadGenerator::SteamConnectionStatusChangedCallback(const SteamNetConnectionStatusChangedCallback_t* p_info)
+{
+    s_p_callback_instance->OnSteamConnectionStatusChangedCallback(p_info);
+}
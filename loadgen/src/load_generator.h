@@ -0,0 +1,159 @@
+#pragma once
+
+#include "loadgen_packet_handler.h"
+#include "loadgen_packet_dispatcher.h"
+#include "simulated_client.h"
+
+#include <common/interface/iapplication.h>
+
+#include <steam/steamnetworkingsockets.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * \brief The maximum number of messages received from the server in one call.
+ */
+constexpr int LOADGEN_RECEIVE_BATCH_SIZE = 256;
+
+struct LoadGeneratorSettings
+{
+    std::string ip = "127.0.0.1";
+    uint16_t port = 27565;
+    unsigned int clients = 100;
+
+    // The number of input packets each client sends per second.
+    int input_rate = 60;
+
+    // The number of seconds between the chat messages sent by each client. If 0, no chat
+    // messages are sent.
+    double chat_interval = 0.0;
+
+    // The number of seconds to run for. If 0, runs until every connection has closed.
+    double duration = 60.0;
+
+    InputMode mode = InputMode::Scripted;
+    uint32_t seed = 0;
+};
+
+/**
+ * \brief Implementation of \code IApplication\endcode which simulates many headless clients
+ * playing on a server, in order to load test it.
+ *
+ * Every client connects over its own connection, and the connections share a poll group so
+ * that the messages of every client are received together. The clients send inputs at a fixed
+ * rate, acknowledge the snapshots they receive and respawn when they die, as a player would.
+ * The round-trip time and throughput of each client are reported when the run ends.
+ */
+class LoadGenerator final : public IApplication
+{
+public:
+    explicit LoadGenerator(const LoadGeneratorSettings& settings);
+    ~LoadGenerator() override;
+
+    LoadGenerator(const LoadGenerator&) = delete;
+    LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+    LoadGenerator(LoadGenerator&&) noexcept = delete;
+    LoadGenerator& operator=(LoadGenerator&&) noexcept = delete;
+
+    void Run() override;
+
+    /**
+     * \brief Gets a simulated client.
+     * \param index The index of the client.
+     * \return The client.
+     */
+    static SimulatedClient& GetClient(unsigned int index);
+
+private:
+    LoadgenPacketHandler m_handler;
+    LoadgenPacketDispatcher m_dispatcher;
+    LoadGeneratorSettings m_settings;
+    std::vector<SimulatedClient> m_clients;
+
+    std::chrono::steady_clock::time_point m_start_time;
+    std::chrono::steady_clock::time_point m_next_input_time;
+    std::chrono::steady_clock::time_point m_next_chat_time;
+    std::chrono::steady_clock::time_point m_next_report_time;
+
+    /**
+     * \brief The number of packets and bytes received since the last report.
+     */
+    uint64_t m_interval_packets;
+    uint64_t m_interval_bytes;
+
+    HSteamNetPollGroup m_poll_group;
+    ISteamNetworkingSockets* m_interface;
+
+    std::array<SteamNetworkingMessage_t*, LOADGEN_RECEIVE_BATCH_SIZE> m_incoming_messages;
+
+    void Initialise() override;
+    void Dispose() override;
+
+    /**
+     * \brief Opens a connection to the server for every simulated client.
+     */
+    void ConnectClients();
+
+    /**
+     * \brief Polls incoming messages from the server on every connection.
+     */
+    void PollIncomingMessages();
+
+    /**
+     * \brief Polls connection state changes.
+     */
+    void PollConnectionStateChanges() const;
+
+    /**
+     * \brief Sends the inputs, and chat messages if due, of every client which has joined.
+     * \param now The current time.
+     */
+    void SendInputs(std::chrono::steady_clock::time_point now);
+
+    /**
+     * \brief Records the round-trip time of every connection, and logs the traffic received
+     * since the last report.
+     * \param now The current time.
+     */
+    void Report(std::chrono::steady_clock::time_point now);
+
+    /**
+     * \brief Logs the round-trip time and throughput of every client over the whole run, and
+     * the traffic of each packet type.
+     */
+    void LogSummary() const;
+
+    /**
+     * \brief Gets whether any client is still connected to the server.
+     */
+    [[nodiscard]] bool IsAnyClientConnected() const;
+
+    /**
+     * \brief Sends a packet to the server on the connection of a client.
+     * \param client The client sending the packet.
+     * \param data The packet which will be dispatched to the server.
+     */
+    void SendToServer(SimulatedClient& client, const Packet& data) const;
+
+    /**
+     * \brief The callback used when a connection status has been changed, called on the
+     * application instance.
+     * \param p_info Connection status callback information.
+     */
+    void OnSteamConnectionStatusChangedCallback(const SteamNetConnectionStatusChangedCallback_t* p_info);
+
+    static LoadGenerator* s_p_callback_instance;
+
+    /**
+     * \brief The callback used when a connection status has been changed.
+     * \param p_info Connection status callback information.
+     */
+    static void SteamConnectionStatusChangedCallback(const SteamNetConnectionStatusChangedCallback_t* p_info);
+
+    friend class LoadgenPacketDispatcher;
+};
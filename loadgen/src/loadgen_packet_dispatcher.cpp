@@ -0,0 +1,75 @@
+#include "loadgen_packet_dispatcher.h"
+#include "load_generator.h"
+#include "simulated_client.h"
+
+#include <common/networking/packet.h>
+
+LoadgenPacketDispatcher::LoadgenPacketDispatcher(const LoadGenerator* load_generator)
+    : IPacketDispatcher{ load_generator }
+{
+}
+
+void LoadgenPacketDispatcher::WelcomeReceived(SimulatedClient& client) const
+{
+    const auto load_generator_handle = dynamic_cast<const LoadGenerator*>(m_handle);
+
+    Packet pckt{ PacketType::WelcomeReceived };
+    pckt.Write(client.GetUsername());
+
+    load_generator_handle->SendToServer(client, pckt);
+}
+
+void LoadgenPacketDispatcher::PlayerInput(SimulatedClient& client, const SimulatedInput& input) const
+{
+    const auto load_generator_handle = dynamic_cast<const LoadGenerator*>(m_handle);
+
+    Packet pckt{ PacketType::PlayerInput };
+    pckt.Write(input.jump);
+    pckt.Write(input.left);
+    pckt.Write(input.right);
+    pckt.Write(input.fire);
+
+    load_generator_handle->SendToServer(client, pckt);
+}
+
+void LoadgenPacketDispatcher::PlayerWeaponRotation(SimulatedClient& client, const float rotation) const
+{
+    const auto load_generator_handle = dynamic_cast<const LoadGenerator*>(m_handle);
+
+    Packet pckt{ PacketType::PlayerWeaponRotation };
+    pckt.Write(rotation);
+
+    load_generator_handle->SendToServer(client, pckt);
+}
+
+void LoadgenPacketDispatcher::PlayerRespawnRequest(SimulatedClient& client) const
+{
+    const auto load_generator_handle = dynamic_cast<const LoadGenerator*>(m_handle);
+
+    const unsigned int client_id = client.GetId();
+
+    Packet pckt{ PacketType::PlayerRespawnRequest };
+    pckt.Write(client_id);
+
+    load_generator_handle->SendToServer(client, pckt);
+}
+
+void LoadgenPacketDispatcher::SendChatMessage(SimulatedClient& client, const std::string& input) const
+{
+    const auto load_generator_handle = dynamic_cast<const LoadGenerator*>(m_handle);
+
+    Packet pckt{ PacketType::ChatMessageOutbound };
+    pckt.Write(input);
+
+    load_generator_handle->SendToServer(client, pckt);
+}
+
+void LoadgenPacketDispatcher::SnapshotAck(SimulatedClient& client, const uint32_t sequence) const
+{
+    const auto load_generator_handle = dynamic_cast<const LoadGenerator*>(m_handle);
+
+    Packet pckt{ PacketType::SnapshotAck };
+    pckt.Write(sequence);
+
+    load_generator_handle->SendToServer(client, pckt);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <common/interface/ipacket_dispatcher.h>
+
+#include <cstdint>
+#include <string>
+
+class LoadGenerator;
+class SimulatedClient;
+struct SimulatedInput;
+
+/**
+ * \brief Implementation of \code IPacketDispatcher\endcode for the packets sent by the simulated
+ * clients of the load generator. Each packet is sent on the connection of the given client.
+ */
+class LoadgenPacketDispatcher final : public IPacketDispatcher
+{
+public:
+    explicit LoadgenPacketDispatcher(const LoadGenerator* load_generator);
+
+    LoadgenPacketDispatcher(const LoadgenPacketDispatcher&) = delete;
+    LoadgenPacketDispatcher& operator=(const LoadgenPacketDispatcher&) = delete;
+
+    LoadgenPacketDispatcher(LoadgenPacketDispatcher&&) noexcept = delete;
+    LoadgenPacketDispatcher& operator=(LoadgenPacketDispatcher&&) noexcept = delete;
+
+    ~LoadgenPacketDispatcher() override = default;
+
+    /**
+     * \brief Sends a acknowledgement to the server that the welcome has been received along
+     * with the username of the client.
+     * \param client The client which has been welcomed.
+     */
+    void WelcomeReceived(SimulatedClient& client) const;
+
+    /**
+     * \brief Sends a packet representing the client's current input.
+     * \param client The client sending the input.
+     * \param input The input.
+     */
+    void PlayerInput(SimulatedClient& client, const SimulatedInput& input) const;
+
+    /**
+     * \brief Sends a packet representing the client's current weapon rotation.
+     * \param client The client sending the rotation.
+     * \param rotation The rotation of the client's weapon.
+     */
+    void PlayerWeaponRotation(SimulatedClient& client, float rotation) const;
+
+    /**
+     * \brief Sends a packet representing a player respawn request.
+     * \param client The client whose player has died.
+     */
+    void PlayerRespawnRequest(SimulatedClient& client) const;
+
+    /**
+     * \brief Sends a packet representing a chat message.
+     * \param client The client sending the message.
+     * \param input The message to send.
+     */
+    void SendChatMessage(SimulatedClient& client, const std::string& input) const;
+
+    /**
+     * \brief Sends an acknowledgement that a snapshot has been reconstructed.
+     * \param client The client which reconstructed the snapshot.
+     * \param sequence The sequence of the snapshot.
+     */
+    void SnapshotAck(SimulatedClient& client, uint32_t sequence) const;
+};
@@ -0,0 +1,200 @@
+#include "loadgen_packet_handler.h"
+#include "loadgen_packet_dispatcher.h"
+
+#include "load_generator.h"
+
+#include <common/networking/snapshot.h>
+
+#include <common/utils/logging.h>
+#include <common/utils/uuid.h>
+
+#include <glm/vec2.hpp>
+
+#include <chrono>
+
+// The simulated clients do not keep a copy of the world, so most packets are only read to
+// check that they decode.
+
+void Welcome(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+{
+    std::string msg;
+    packet.Read(msg);
+
+    unsigned int id;
+    packet.Read(id);
+
+    SimulatedClient& client = LoadGenerator::GetClient(from);
+    client.Join(id);
+
+    dynamic_cast<const LoadgenPacketDispatcher*>(dispatcher)->WelcomeReceived(client);
+}
+
+void PlayerConnected(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+{
+    (void)from;
+
+    unsigned int client_id;
+    packet.Read(client_id);
+
+    std::string username;
+    packet.Read(username);
+
+    glm::vec2 position;
+    packet.Read(position);
+
+    glm::vec2 scale;
+    packet.Read(scale);
+}
+
+void PlayerDisconnected(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+{
+    (void)from;
+
+    unsigned int id;
+    packet.Read(id);
+
+    std::string username;
+    packet.Read(username);
+}
+
+void PlayerHealthUpdate(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+{
+    (void)from;
+
+    int health;
+    packet.Read(health);
+}
+
+void PlayerDeath(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+{
+    unsigned int client_id;
+    packet.Read(client_id);
+
+    // Respawn straight away, as a player would once their player has died.
+    SimulatedClient& client = LoadGenerator::GetClient(from);
+    if (client.IsJoined() && client_id == client.GetId())
+        dynamic_cast<const LoadgenPacketDispatcher*>(dispatcher)->PlayerRespawnRequest(client);
+}
+
+void PlayerRespawn(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+{
+    (void)from;
+
+    unsigned int client_id;
+    packet.Read(client_id);
+
+    std::string username;
+    packet.Read(username);
+
+    glm::vec2 position;
+    packet.Read(position);
+
+    glm::vec2 scale;
+    packet.Read(scale);
+}
+
+void PlayerSpawn(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+{
+    (void)from;
+
+    unsigned int client_id;
+    packet.Read(client_id);
+
+    std::string username;
+    packet.Read(username);
+
+    glm::vec2 position;
+    packet.Read(position);
+
+    glm::vec2 scale;
+    packet.Read(scale);
+
+    float weapon_rotation;
+    packet.Read(weapon_rotation);
+}
+
+void PlayerDespawn(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+{
+    (void)from;
+
+    unsigned int client_id;
+    packet.Read(client_id);
+}
+
+void PlayerWeaponRotation(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+{
+    (void)from;
+
+    unsigned int id;
+    packet.Read(id);
+
+    float rotation;
+    packet.Read(rotation);
+}
+
+void ProjectileDestroy(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+{
+    (void)from;
+
+    UUID projectile_id;
+    packet.Read(projectile_id);
+}
+
+void SnapshotDeltaReceive(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+{
+    SimulatedClient& client = LoadGenerator::GetClient(from);
+
+    SnapshotDelta changes{};
+    if (!client.GetSnapshotReceiver().Receive(packet, changes))
+        return;
+
+    client.GetStats().snapshots_received++;
+
+    // Acknowledge the snapshot so the server can send the next delta against it.
+    dynamic_cast<const LoadgenPacketDispatcher*>(dispatcher)->SnapshotAck(client, changes.sequence);
+}
+
+void ChatMessageReceive(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+{
+    (void)from;
+
+    std::chrono::time_point<std::chrono::system_clock> timestamp;
+    packet.Read(timestamp);
+
+    std::string username;
+    packet.Read(username);
+
+    std::string message;
+    packet.Read(message);
+}
+
+void ServerShutdown(const unsigned int from, Packet& packet, const IPacketDispatcher* dispatcher)
+{
+    (void)packet;
+
+    // Only log the shutdown once, rather than once for every client.
+    if (from == 0)
+        SCX_CORE_INFO("The server is shutting down.");
+}
+
+LoadgenPacketHandler::LoadgenPacketHandler()
+    : IPacketHandler{}
+{
+    // Initialise mapping between packets and their handlers.
+    m_handlers =
+    {
+        { PacketType::Welcome, &Welcome },
+        { PacketType::PlayerConnected, &PlayerConnected },
+        { PacketType::PlayerDisconnected, &PlayerDisconnected },
+        { PacketType::PlayerHealthUpdate, &PlayerHealthUpdate },
+        { PacketType::PlayerDeath, &PlayerDeath },
+        { PacketType::PlayerRespawn, &PlayerRespawn },
+        { PacketType::PlayerSpawn, &PlayerSpawn },
+        { PacketType::PlayerDespawn, &PlayerDespawn },
+        { PacketType::PlayerWeaponRotation, &PlayerWeaponRotation },
+        { PacketType::ProjectileDestroy, &ProjectileDestroy },
+        { PacketType::ChatMessageInbound, &ChatMessageReceive },
+        { PacketType::SnapshotDelta, &SnapshotDeltaReceive },
+        { PacketType::ServerShutdown, &ServerShutdown }
+    };
+}
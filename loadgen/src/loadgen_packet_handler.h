@@ -0,0 +1,23 @@
+#pragma once
+
+#include <common/interface/ipacket_handler.h>
+
+/**
+ * \brief Implementation of \code IPacketHandler\endcode for the packets received by the
+ * simulated clients of the load generator.
+ *
+ * Packets are decoded as the client decodes them, but nothing is rendered. Packets are handled
+ * with the index of the simulated client which received them in place of the client ID.
+ */
+class LoadgenPacketHandler final : public IPacketHandler
+{
+public:
+    LoadgenPacketHandler();
+    ~LoadgenPacketHandler() override = default;
+
+    LoadgenPacketHandler(const LoadgenPacketHandler&) = default;
+    LoadgenPacketHandler& operator=(const LoadgenPacketHandler&) = default;
+
+    LoadgenPacketHandler(LoadgenPacketHandler&&) noexcept = default;
+    LoadgenPacketHandler& operator=(LoadgenPacketHandler&&) noexcept = default;
+};
@@ -0,0 +1,86 @@
+#include "load_generator.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+bool FindCommandOption(char* begin[], char* end[], const std::string& option, std::string& value)
+{
+    auto it = std::find(begin, end, option);
+    if (it != end && ++it != end)
+        value = *it;
+    else
+        return false;
+
+    return true;
+}
+
+bool ParseArguments(const int argc, char* argv[], LoadGeneratorSettings& settings)
+{
+    std::string ip_string;
+    std::string port_string;
+    std::string clients_string;
+
+    if (!FindCommandOption(argv + 1, argv + argc, "-ip", ip_string))
+        return false;
+    if (!FindCommandOption(argv + 1, argv + argc, "-port", port_string))
+        return false;
+    if (!FindCommandOption(argv + 1, argv + argc, "-clients", clients_string))
+        return false;
+
+    settings.ip = ip_string;
+    settings.port = static_cast<uint16_t>(std::stoi(port_string));
+    settings.clients = static_cast<unsigned int>(std::stoi(clients_string));
+
+    return true;
+}
+
+void ParseOptionalArguments(const int argc, char* argv[], LoadGeneratorSettings& settings)
+{
+    std::string input_rate_string;
+    std::string chat_interval_string;
+    std::string duration_string;
+    std::string mode_string;
+    std::string seed_string;
+
+    // If the input rate is not specified, each client sends inputs at 60 Hz, as the client does.
+    if (FindCommandOption(argv + 1, argv + argc, "-input-rate", input_rate_string))
+        settings.input_rate = std::stoi(input_rate_string);
+
+    // If the chat interval is not specified, no chat messages are sent.
+    if (FindCommandOption(argv + 1, argv + argc, "-chat-interval", chat_interval_string))
+        settings.chat_interval = std::stod(chat_interval_string);
+
+    // If the duration is not specified, the load generator runs for a minute.
+    if (FindCommandOption(argv + 1, argv + argc, "-duration", duration_string))
+        settings.duration = std::stod(duration_string);
+
+    // If the input mode is not specified, the clients follow the scripted pattern.
+    if (FindCommandOption(argv + 1, argv + argc, "-mode", mode_string))
+        settings.mode = mode_string == "random" ? InputMode::Random : InputMode::Scripted;
+    if (FindCommandOption(argv + 1, argv + argc, "-seed", seed_string))
+        settings.seed = static_cast<uint32_t>(std::stoul(seed_string));
+}
+
+int main(const int argc, char* argv[])
+{
+    LoadGeneratorSettings settings{};
+
+    if (!ParseArguments(argc, argv, settings))
+    {
+        std::cerr <<
+            "Invalid command line arguments. Usage: ./loadgen -ip [address] -port [port] -clients [count] "
+            "[-input-rate [hz]] [-chat-interval [seconds]] [-duration [seconds]] [-mode [scripted|random]] "
+            "[-seed [seed]]\n";
+
+        // If invalid command line arguments have been passed to the program, just use default settings.
+        settings = LoadGeneratorSettings{};
+    }
+
+    ParseOptionalArguments(argc, argv, settings);
+
+    LoadGenerator load_generator{ settings };
+    load_generator.Run();
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include "simulated_client.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+/**
+ * \brief The length of one repetition of the scripted pattern in seconds.
+ */
+constexpr double SCRIPT_PERIOD = 4.0;
+
+/**
+ * \brief The time between the jumps of a scripted client in seconds.
+ */
+constexpr double SCRIPT_JUMP_INTERVAL = 1.5;
+
+/**
+ * \brief The longest time a client in random mode holds the same keys, in seconds.
+ */
+constexpr double RANDOM_MAX_HOLD_TIME = 2.0;
+
+constexpr float RANDOM_JUMP_CHANCE = 0.02f;
+
+void SimulatedClientStats::RecordPing(const int ping)
+{
+    min_ping = std::min(min_ping, ping);
+    max_ping = std::max(max_ping, ping);
+    total_ping += ping;
+    ping_samples++;
+}
+
+double SimulatedClientStats::GetAveragePing() const
+{
+    return ping_samples > 0 ? static_cast<double>(total_ping) / ping_samples : 0.0;
+}
+
+SimulatedClient::SimulatedClient(const unsigned int index, const InputMode mode, const uint32_t seed)
+    : m_index{ index },
+      m_id{ 0 },
+      m_username{ "loadgen_" + std::to_string(index) },
+      m_connection{ k_HSteamNetConnection_Invalid },
+      m_is_joined{ false },
+      m_mode{ mode },
+      m_random{ seed ^ (index * 0x9E3779B9u) },
+      m_held_input{},
+      m_next_change_time{ 0.0 }
+{
+}
+
+SimulatedInput SimulatedClient::NextInput(const double time)
+{
+    return m_mode == InputMode::Scripted ? NextScriptedInput(time) : NextRandomInput(time);
+}
+
+void SimulatedClient::Join(const unsigned int id)
+{
+    m_id = id;
+    m_is_joined = true;
+}
+
+void SimulatedClient::Disconnect()
+{
+    m_connection = k_HSteamNetConnection_Invalid;
+    m_is_joined = false;
+}
+
+void SimulatedClient::SetConnection(const HSteamNetConnection connection)
+{
+    m_connection = connection;
+}
+
+unsigned int SimulatedClient::GetIndex() const
+{
+    return m_index;
+}
+
+unsigned int SimulatedClient::GetId() const
+{
+    return m_id;
+}
+
+HSteamNetConnection SimulatedClient::GetConnection() const
+{
+    return m_connection;
+}
+
+const std::string& SimulatedClient::GetUsername() const
+{
+    return m_username;
+}
+
+bool SimulatedClient::IsConnected() const
+{
+    return m_connection != k_HSteamNetConnection_Invalid;
+}
+
+bool SimulatedClient::IsJoined() const
+{
+    return m_is_joined;
+}
+
+SnapshotReceiver& SimulatedClient::GetSnapshotReceiver()
+{
+    return m_snapshot_receiver;
+}
+
+SimulatedClientStats& SimulatedClient::GetStats()
+{
+    return m_stats;
+}
+
+const SimulatedClientStats& SimulatedClient::GetStats() const
+{
+    return m_stats;
+}
+
+SimulatedInput SimulatedClient::NextScriptedInput(const double time) const
+{
+    // Offset each client within the pattern, so that they do not all move in lockstep.
+    const double offset = static_cast<double>(m_index) / 7.0;
+    const double phase = std::fmod(time + offset, SCRIPT_PERIOD) / SCRIPT_PERIOD;
+
+    SimulatedInput input{};
+    input.left = phase < 0.5;
+    input.right = phase >= 0.5;
+
+    // Jumps are sent for a single input, as the client sends the W key when it is pressed down.
+    const double jump_phase = std::fmod(time + offset, SCRIPT_JUMP_INTERVAL);
+    input.jump = jump_phase < 0.05;
+
+    input.fire = std::fmod(time + offset, 1.0) < 0.25;
+    input.weapon_rotation = static_cast<float>(phase * 2.0 * std::numbers::pi);
+
+    return input;
+}
+
+SimulatedInput SimulatedClient::NextRandomInput(const double time)
+{
+    std::uniform_real_distribution<float> chance{ 0.0f, 1.0f };
+
+    if (time >= m_next_change_time)
+    {
+        const float direction = chance(m_random);
+
+        m_held_input.left = direction < 0.4f;
+        m_held_input.right = direction > 0.6f;
+        m_held_input.fire = chance(m_random) < 0.5f;
+
+        m_next_change_time = time + chance(m_random) * RANDOM_MAX_HOLD_TIME;
+    }
+
+    // The weapon is swung a little every input, as a player moving its mouse would.
+    m_held_input.weapon_rotation += (chance(m_random) - 0.5f) * 0.2f;
+
+    SimulatedInput input = m_held_input;
+    input.jump = chance(m_random) < RANDOM_JUMP_CHANCE;
+
+    return input;
+}
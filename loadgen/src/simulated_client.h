@@ -0,0 +1,138 @@
+#pragma once
+
+#include <common/networking/snapshot.h>
+
+#include <steam/steamnetworkingtypes.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+
+/**
+ * \brief How a simulated client decides which inputs to send.
+ */
+enum class InputMode
+{
+    // Each client follows the same repeating pattern of movement, jumps and shots, offset by
+    // its index, so that runs are repeatable.
+    Scripted,
+    // Each client holds and releases keys at random, seeded by its index.
+    Random
+};
+
+/**
+ * \brief The inputs a simulated client sends in a single input packet.
+ */
+struct SimulatedInput
+{
+    bool jump;
+    bool left;
+    bool right;
+    bool fire;
+    float weapon_rotation;
+};
+
+/**
+ * \brief The traffic a simulated client has received and the round-trip times it has seen.
+ */
+struct SimulatedClientStats
+{
+    uint64_t packets_received = 0;
+    uint64_t bytes_received = 0;
+    uint64_t packets_sent = 0;
+    uint64_t snapshots_received = 0;
+
+    int min_ping = std::numeric_limits<int>::max();
+    int max_ping = 0;
+    int64_t total_ping = 0;
+    int ping_samples = 0;
+
+    /**
+     * \brief Records a sample of the round-trip time to the server.
+     * \param ping The round-trip time in milliseconds.
+     */
+    void RecordPing(int ping);
+
+    /**
+     * \brief Gets the mean of the recorded round-trip times.
+     * \return The mean round-trip time in milliseconds, or 0 if none have been recorded.
+     */
+    [[nodiscard]] double GetAveragePing() const;
+};
+
+/**
+ * \brief A headless client which connects to the server, joins the game and sends inputs
+ * without rendering anything.
+ */
+class SimulatedClient
+{
+public:
+    /**
+     * \brief Creates a client which has not connected yet.
+     * \param index The index of the client, which identifies it within the load generator.
+     * \param mode How the client decides which inputs to send.
+     * \param seed The seed shared by every client, which is combined with the client's index.
+     */
+    SimulatedClient(unsigned int index, InputMode mode, uint32_t seed);
+    ~SimulatedClient() = default;
+
+    SimulatedClient(const SimulatedClient&) = delete;
+    SimulatedClient& operator=(const SimulatedClient&) = delete;
+
+    SimulatedClient(SimulatedClient&&) noexcept = default;
+    SimulatedClient& operator=(SimulatedClient&&) noexcept = default;
+
+    /**
+     * \brief Generates the next inputs to send.
+     * \param time The number of seconds since the load generator started.
+     * \return The inputs.
+     */
+    SimulatedInput NextInput(double time);
+
+    /**
+     * \brief Records that the server has welcomed the client.
+     * \param id The identifier the server assigned to the client.
+     */
+    void Join(unsigned int id);
+
+    /**
+     * \brief Records that the client's connection has closed.
+     */
+    void Disconnect();
+
+    void SetConnection(HSteamNetConnection connection);
+
+    [[nodiscard]] unsigned int GetIndex() const;
+    [[nodiscard]] unsigned int GetId() const;
+    [[nodiscard]] HSteamNetConnection GetConnection() const;
+    [[nodiscard]] const std::string& GetUsername() const;
+    [[nodiscard]] bool IsConnected() const;
+    [[nodiscard]] bool IsJoined() const;
+
+    [[nodiscard]] SnapshotReceiver& GetSnapshotReceiver();
+    [[nodiscard]] SimulatedClientStats& GetStats();
+    [[nodiscard]] const SimulatedClientStats& GetStats() const;
+
+private:
+    unsigned int m_index;
+    unsigned int m_id;
+    std::string m_username;
+    HSteamNetConnection m_connection;
+    bool m_is_joined;
+
+    InputMode m_mode;
+    std::mt19937 m_random;
+
+    /**
+     * \brief The keys held by a client in random mode, and when it next changes them.
+     */
+    SimulatedInput m_held_input;
+    double m_next_change_time;
+
+    SnapshotReceiver m_snapshot_receiver;
+    SimulatedClientStats m_stats;
+
+    SimulatedInput NextScriptedInput(double time) const;
+    SimulatedInput NextRandomInput(double time);
+};
@@ -1,3 +1,9 @@
+newoption
+{
+    trigger = "avx2",
+    description = "Build the server's batch physics kernels with AVX2 instead of SSE2"
+}
+
 workspace "concurrent-server-client"
     configurations { "Debug", "Release", "Dist" }
     architecture "x86_64"
@@ -11,7 +17,9 @@ workspace "concurrent-server-client"
 
 include "server/server.lua"
 include "client/client.lua"
+include "loadgen/loadgen.lua"
 include "common/common.lua"
 
 include "common/common_tests.lua"
 include "server/server_tests.lua"
+include "server/server_bench.lua"
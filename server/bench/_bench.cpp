@@ -0,0 +1,3 @@
+#include "benchmark.h"
+
+SCX_BENCHMARK_RUNNER();
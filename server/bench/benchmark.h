@@ -0,0 +1,242 @@
+#pragma once
+
+#include <common/utils/logging.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * \brief A minimal registry of microbenchmarks. Benchmarks are registered with
+ * \code SCX_BENCHMARK\endcode and report their measurements through \code Report\endcode.
+ *
+ * Measurements are printed as they are made, and can also be written to a JSON file so that
+ * runs can be compared across commits.
+ */
+class Benchmarks
+{
+public:
+    using BenchmarkFunction = void(*)();
+
+    /**
+     * \brief The file the measurements are written to if \code -json\endcode is given without a path.
+     */
+    static constexpr const char* DEFAULT_JSON_PATH = "bench_results.json";
+
+    /**
+     * \brief Registers a benchmark to be run by \code RunAll\endcode.
+     * \param name The name of the benchmark.
+     * \param function The function which performs the benchmark.
+     * \return A dummy value, allowing registration during static initialisation.
+     */
+    static bool Register(const char* name, const BenchmarkFunction function)
+    {
+        GetRegistered().push_back({ name, function });
+        return true;
+    }
+
+    /**
+     * \brief Reports a single measurement made by a benchmark.
+     * \param label A label describing the measurement.
+     * \param operations The number of operations which were performed.
+     * \param elapsed The time taken to perform the operations.
+     */
+    static void Report(const std::string& label, const uint64_t operations,
+                       const std::chrono::duration<double> elapsed)
+    {
+        const double seconds = elapsed.count();
+
+        GetResults().push_back({ GetCurrent(), label, operations, seconds });
+
+        std::printf("%-48s %12llu ops %10.3f ms %14.0f ops/s %10.2f ns/op\n", label.c_str(),
+                    static_cast<unsigned long long>(operations), seconds * 1000.0,
+                    static_cast<double>(operations) / seconds,
+                    seconds * 1e9 / static_cast<double>(operations));
+    }
+
+    /**
+     * \brief Runs every registered benchmark, optionally only those whose name contains
+     * \code filter\endcode.
+     * \param filter The filter to apply to benchmark names.
+     * \param json_path The path of the file to write the measurements to as JSON. If empty, the
+     * measurements are only printed.
+     * \return The process exit code.
+     */
+    static int RunAll(const std::string& filter = "", const std::string& json_path = "")
+    {
+        for (const auto& [name, function] : GetRegistered())
+        {
+            if (!filter.empty() && std::string{ name }.find(filter) == std::string::npos)
+                continue;
+
+            std::printf("[%s]\n", name);
+
+            GetCurrent() = name;
+            function();
+        }
+
+        if (!json_path.empty() && !WriteJson(json_path))
+        {
+            std::fprintf(stderr, "Failed to write the results to %s.\n", json_path.c_str());
+            return 1;
+        }
+
+        return 0;
+    }
+
+    /**
+     * \brief Parses the command line arguments of the benchmark runner and runs the benchmarks.
+     * Usage: server_bench [filter] [-json [path]]
+     * If \code -json\endcode is the last argument, the measurements are written to
+     * \code DEFAULT_JSON_PATH\endcode.
+     * \return The process exit code.
+     */
+    static int Main(const int argc, char* argv[])
+    {
+        std::string filter;
+        std::string json_path;
+
+#if defined(SCX_LOGGING)
+        // The code being measured logs as it runs, such as when a packet is sent to a client
+        // which has no strand, and printing those lines would dominate the measurements.
+        Logging::Initialise("BENCH");
+        Logging::GetCoreLogger()->set_level(spdlog::level::off);
+#endif
+
+        for (int i = 1; i < argc; i++)
+        {
+            if (std::string_view{ argv[i] } == "-json")
+                json_path = i + 1 < argc ? argv[++i] : DEFAULT_JSON_PATH;
+            else
+                filter = argv[i];
+        }
+
+        return RunAll(filter, json_path);
+    }
+
+private:
+    struct Registered
+    {
+        const char* name;
+        BenchmarkFunction function;
+    };
+
+    struct Result
+    {
+        std::string benchmark;
+        std::string label;
+        uint64_t operations;
+        double seconds;
+    };
+
+    static std::vector<Registered>& GetRegistered()
+    {
+        static std::vector<Registered> s_registered;
+        return s_registered;
+    }
+
+    static std::vector<Result>& GetResults()
+    {
+        static std::vector<Result> s_results;
+        return s_results;
+    }
+
+    /**
+     * \brief Gets the name of the benchmark which is running.
+     */
+    static std::string& GetCurrent()
+    {
+        static std::string s_current;
+        return s_current;
+    }
+
+    /**
+     * \brief Writes every measurement which has been reported to a file as a JSON array.
+     * \param path The path of the file.
+     * \return Whether the file was written.
+     */
+    static bool WriteJson(const std::string& path)
+    {
+        std::FILE* p_file = std::fopen(path.c_str(), "w");
+        if (p_file == nullptr)
+            return false;
+
+        std::fprintf(p_file, "[\n");
+
+        const std::vector<Result>& results = GetResults();
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const Result& result = results[i];
+
+            std::fprintf(p_file,
+                         "  {\"benchmark\": \"%s\", \"name\": \"%s\", \"operations\": %llu, \"seconds\": %.9f, "
+                         "\"ops_per_second\": %.3f, \"ns_per_op\": %.3f}%s\n", Escape(result.benchmark).c_str(),
+                         Escape(result.label).c_str(), static_cast<unsigned long long>(result.operations),
+                         result.seconds, static_cast<double>(result.operations) / result.seconds,
+                         result.seconds * 1e9 / static_cast<double>(result.operations),
+                         i + 1 < results.size() ? "," : "");
+        }
+
+        std::fprintf(p_file, "]\n");
+
+        return std::fclose(p_file) == 0;
+    }
+
+    /**
+     * \brief Escapes the characters of a string which cannot appear in a JSON string as-is.
+     */
+    static std::string Escape(const std::string& value)
+    {
+        std::string escaped;
+
+        for (const char c : value)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+
+            escaped += c;
+        }
+
+        return escaped;
+    }
+};
+
+/**
+ * \brief Measures the time taken to invoke \code function\endcode.
+ * \return The elapsed time.
+ */
+template <typename F>
+std::chrono::duration<double> Measure(F&& function)
+{
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    function();
+    return std::chrono::high_resolution_clock::now() - start_time;
+}
+
+/**
+ * \brief Prevents the compiler from optimising away the computation of \code value\endcode.
+ */
+template <typename T>
+void KeepAlive(const T& value)
+{
+#if defined(_MSC_VER)
+    static const void* volatile s_p_sink;
+    s_p_sink = &value;
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+#define SCX_BENCHMARK(NAME) \
+    static void NAME(); \
+    [[maybe_unused]] static const bool NAME##_registered = Benchmarks::Register(#NAME, &NAME); \
+    static void NAME()
+
+#define SCX_BENCHMARK_RUNNER() \
+    int main(const int argc, char* argv[]) \
+    { \
+        return Benchmarks::Main(argc, argv); \
+    }
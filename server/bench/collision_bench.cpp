@@ -0,0 +1,98 @@
+#include "benchmark.h"
+#include "synthetic_level.h"
+
+#include <player.h>
+#include <room.h>
+#include <test_support.h>
+
+#include <physics/collision.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+constexpr uint64_t AABB_ITERATIONS = 10'000'000;
+constexpr size_t AABB_BOX_COUNT = 1024;
+
+constexpr uint64_t PLAYER_ITERATIONS = 1'000'000;
+constexpr size_t PLAYER_COUNT = 256;
+
+/**
+ * \brief The number of platforms of each level the players collide with, from the size of the
+ * shipped level to a level far larger than any which exists.
+ */
+constexpr size_t LEVEL_SIZES[] = { 4, 64, 1024, 16384 };
+
+SCX_BENCHMARK(AABBtoAABB)
+{
+    // Pairs of boxes scattered so that about half of them overlap, so the branches of the test
+    // cannot be predicted.
+    std::mt19937 random{ 1 };
+    std::uniform_real_distribution<float> coordinate{ -20.0f, 20.0f };
+
+    std::vector<Collision::AABB> boxes;
+    for (size_t i = 0; i < AABB_BOX_COUNT; i++)
+    {
+        const glm::vec2 min{ coordinate(random), coordinate(random) };
+        boxes.push_back(Collision::MakeAABB(min, min + glm::vec2{ 10.0f, 10.0f }));
+    }
+
+    uint64_t hits = 0;
+
+    const auto elapsed = Measure([&]
+    {
+        for (uint64_t i = 0; i < AABB_ITERATIONS; i++)
+            hits += Collision::AABBtoAABB(boxes[i % AABB_BOX_COUNT], boxes[(i * 7 + 1) % AABB_BOX_COUNT]);
+    });
+
+    KeepAlive(hits);
+    Benchmarks::Report("AABBtoAABB", AABB_ITERATIONS, elapsed);
+
+    const auto locations_elapsed = Measure([&]
+    {
+        for (uint64_t i = 0; i < AABB_ITERATIONS; i++)
+        {
+            bool collision_locations[4]{};
+            hits += Collision::AABBtoAABB(boxes[i % AABB_BOX_COUNT], boxes[(i * 7 + 1) % AABB_BOX_COUNT],
+                                          collision_locations);
+            KeepAlive(collision_locations);
+        }
+    });
+
+    KeepAlive(hits);
+    Benchmarks::Report("AABBtoAABB/locations", AABB_ITERATIONS, locations_elapsed);
+}
+
+SCX_BENCHMARK(PlayerHandleCollisions)
+{
+    for (const size_t platforms : LEVEL_SIZES)
+    {
+        const Level level = MakeSyntheticLevel(platforms);
+
+        // Players collide with the level of the room which is being updated.
+        const FakeTransport transport;
+        Room room{ 0, level, transport };
+        const Room::Scope scope{ room };
+
+        std::mt19937 random{ 1 };
+        std::vector<glm::vec2> positions;
+        for (size_t i = 0; i < PLAYER_COUNT; i++)
+            positions.push_back(RandomSyntheticPosition(platforms, random));
+
+        std::vector<Player> players(PLAYER_COUNT);
+
+        const auto elapsed = Measure([&]
+        {
+            for (uint64_t i = 0; i < PLAYER_ITERATIONS; i++)
+            {
+                // Collisions move the player, so each is put back where it started first.
+                Player& player = players[i % PLAYER_COUNT];
+                player.SetPosition(positions[i % PLAYER_COUNT]);
+                player.HandleCollisions();
+            }
+        });
+
+        KeepAlive(players);
+        Benchmarks::Report("HandleCollisions/platforms:" + std::to_string(platforms), PLAYER_ITERATIONS, elapsed);
+    }
+}
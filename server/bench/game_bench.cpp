@@ -0,0 +1,142 @@
+#include "benchmark.h"
+#include "synthetic_level.h"
+
+#include <game.h>
+#include <player.h>
+#include <room.h>
+#include <test_support.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+
+constexpr double GAME_BENCH_DT = 1.0 / 60.0;
+constexpr int GAME_BENCH_TICKS = 600;
+constexpr size_t GAME_BENCH_PLATFORMS = 64;
+
+constexpr size_t PLAYER_COUNTS[] = { 8, 32, 128 };
+constexpr size_t PROJECTILE_COUNTS[] = { 0, 256, 2048 };
+
+/**
+ * \brief A room filled with synthetic players, which are given fresh inputs and have their
+ * projectiles topped up before every tick, so that each tick does a similar amount of work.
+ */
+class SyntheticRoom
+{
+public:
+    SyntheticRoom(const Level& level, const size_t players, const size_t projectiles)
+        : m_room{ std::make_unique<Room>(0, level, m_transport) },
+          m_projectiles{ projectiles },
+          m_random{ 1 }
+    {
+        const Room::Scope scope{ *m_room };
+
+        // Clients join as they would on the server, with their connection as their identifier.
+        for (size_t i = 0; i < players; i++)
+        {
+            m_room->EnqueueCommand({
+                .type = GameCommand::Type::Join, .client_id = static_cast<unsigned int>(i + 1),
+                .text = "bench_" + std::to_string(i)
+            });
+        }
+
+        Game::Update(GAME_BENCH_DT);
+
+        // Spread the players over the level, rather than stacking them on the spawn point.
+        for (Player& player : m_room->GetClients().GetPlayers())
+            player.SetPosition(RandomSyntheticPosition(GAME_BENCH_PLATFORMS, m_random));
+    }
+
+    /**
+     * \brief Queues an input for every player, respawns dead players and spawns projectiles
+     * until there are as many as requested.
+     */
+    void Prepare()
+    {
+        const Room::Scope scope{ *m_room };
+
+        const std::span players = m_room->GetClients().GetPlayers();
+        std::uniform_int_distribution<int> key{ 0, 3 };
+
+        for (const Player& player : players)
+        {
+            const int pressed = key(m_random);
+
+            m_room->EnqueueCommand({
+                .type = GameCommand::Type::Input, .client_id = player.GetId(),
+                .inputs = { pressed == 0, pressed == 1, pressed == 2, false }
+            });
+
+            if (player.GetCurrentHealth() == 0)
+                m_room->EnqueueCommand({ .type = GameCommand::Type::Respawn, .client_id = player.GetId() });
+        }
+
+        if (players.empty())
+            return;
+
+        std::uniform_real_distribution<float> angle{ 0.0f, 6.2831853f };
+        std::uniform_int_distribution<size_t> shooter{ 0, players.size() - 1 };
+
+        for (size_t i = Game::GetProjectiles().GetSize(); i < m_projectiles; i++)
+        {
+            const Player& player = players[shooter(m_random)];
+            const float rotation = angle(m_random);
+
+            Game::SpawnProjectile(player.GetPosition(), { std::cos(rotation), std::sin(rotation) }, player.GetId());
+        }
+    }
+
+    Room& GetRoom()
+    {
+        return *m_room;
+    }
+
+private:
+    FakeTransport m_transport;
+    std::unique_ptr<Room> m_room;
+    size_t m_projectiles;
+    std::mt19937 m_random;
+};
+
+SCX_BENCHMARK(GameUpdate)
+{
+    const Level level = MakeSyntheticLevel(GAME_BENCH_PLATFORMS);
+
+    for (const size_t players : PLAYER_COUNTS)
+    {
+        for (const size_t projectiles : PROJECTILE_COUNTS)
+        {
+            const std::string label = "/players:" + std::to_string(players) + "/projectiles:" +
+                std::to_string(projectiles);
+
+            // The game alone: commands, player movement and projectile hits.
+            SyntheticRoom game_room{ level, players, projectiles };
+            std::chrono::duration<double> game_elapsed{ 0 };
+
+            for (int tick = 0; tick < GAME_BENCH_TICKS; tick++)
+            {
+                game_room.Prepare();
+
+                const Room::Scope scope{ game_room.GetRoom() };
+                game_elapsed += Measure([] { Game::Update(GAME_BENCH_DT); });
+            }
+
+            Benchmarks::Report("Game::Update" + label, GAME_BENCH_TICKS, game_elapsed);
+
+            // A whole tick of the room, which also finds each client's interest and replicates
+            // the world to them.
+            SyntheticRoom tick_room{ level, players, projectiles };
+            std::chrono::duration<double> room_elapsed{ 0 };
+
+            for (int tick = 0; tick < GAME_BENCH_TICKS; tick++)
+            {
+                tick_room.Prepare();
+                room_elapsed += Measure([&tick_room] { tick_room.GetRoom().Update(GAME_BENCH_DT, 1); });
+            }
+
+            Benchmarks::Report("Room::Update" + label, GAME_BENCH_TICKS, room_elapsed);
+        }
+    }
+}
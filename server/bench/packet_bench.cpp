@@ -0,0 +1,133 @@
+#include "benchmark.h"
+
+#include <common/networking/packet.h>
+
+#include <glm/vec2.hpp>
+
+#include <string>
+
+constexpr uint64_t PACKET_ITERATIONS = 1'000'000;
+
+/**
+ * \brief The lengths of the strings written, from a short username to most of a packet.
+ */
+constexpr size_t STRING_LENGTHS[] = { 8, 32, 100 };
+
+SCX_BENCHMARK(PacketWriteRead)
+{
+    // A player movement update, the most common shape of packet.
+    const auto write_elapsed = Measure([]
+    {
+        for (uint64_t i = 0; i < PACKET_ITERATIONS; i++)
+        {
+            Packet packet{ PacketType::PlayerMovement };
+            packet.Write(static_cast<unsigned int>(i));
+            packet.Write(glm::vec2{ 1.0f, 2.0f });
+            packet.Write(0.5f);
+
+            KeepAlive(packet);
+        }
+    });
+
+    Benchmarks::Report("Write/uint+vec2+float", PACKET_ITERATIONS, write_elapsed);
+
+    Packet source{ PacketType::PlayerMovement };
+    source.Write(42u);
+    source.Write(glm::vec2{ 1.0f, 2.0f });
+    source.Write(0.5f);
+
+    const auto read_elapsed = Measure([&source]
+    {
+        for (uint64_t i = 0; i < PACKET_ITERATIONS; i++)
+        {
+            Packet packet = source;
+
+            unsigned int id;
+            glm::vec2 position;
+            float rotation;
+
+            packet.Read(id);
+            packet.Read(position);
+            packet.Read(rotation);
+
+            KeepAlive(id);
+            KeepAlive(position);
+            KeepAlive(rotation);
+        }
+    });
+
+    Benchmarks::Report("Read/uint+vec2+float", PACKET_ITERATIONS, read_elapsed);
+}
+
+SCX_BENCHMARK(PacketStrings)
+{
+    // Strings are written and read a character at a time, so their cost grows with their length.
+    for (const size_t length : STRING_LENGTHS)
+    {
+        const std::string value(length, 'x');
+
+        const auto write_elapsed = Measure([&value]
+        {
+            for (uint64_t i = 0; i < PACKET_ITERATIONS; i++)
+            {
+                Packet packet{ PacketType::ChatMessageInbound };
+                packet.Write(value);
+
+                KeepAlive(packet);
+            }
+        });
+
+        Benchmarks::Report("WriteString/length:" + std::to_string(length), PACKET_ITERATIONS, write_elapsed);
+
+        Packet source{ PacketType::ChatMessageInbound };
+        source.Write(value);
+
+        const auto read_elapsed = Measure([&source]
+        {
+            std::string dest;
+
+            for (uint64_t i = 0; i < PACKET_ITERATIONS; i++)
+            {
+                Packet packet = source;
+                packet.Read(dest);
+
+                KeepAlive(dest);
+            }
+        });
+
+        Benchmarks::Report("ReadString/length:" + std::to_string(length), PACKET_ITERATIONS, read_elapsed);
+    }
+}
+
+SCX_BENCHMARK(PacketEncodeDecode)
+{
+    Packet source{ PacketType::ChatMessageInbound };
+    source.Write(std::string(32, 'x'));
+
+    unsigned char buffer[MAX_ENCODED_PACKET_SIZE];
+    int size = 0;
+
+    const auto encode_elapsed = Measure([&]
+    {
+        for (uint64_t i = 0; i < PACKET_ITERATIONS; i++)
+        {
+            size = source.Encode(buffer, sizeof(buffer));
+            KeepAlive(buffer);
+        }
+    });
+
+    Benchmarks::Report("Encode/bytes:" + std::to_string(size), PACKET_ITERATIONS, encode_elapsed);
+
+    const auto decode_elapsed = Measure([&]
+    {
+        Packet packet{};
+
+        for (uint64_t i = 0; i < PACKET_ITERATIONS; i++)
+        {
+            packet.Decode(buffer, size);
+            KeepAlive(packet);
+        }
+    });
+
+    Benchmarks::Report("Decode/bytes:" + std::to_string(size), PACKET_ITERATIONS, decode_elapsed);
+}
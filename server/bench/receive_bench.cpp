@@ -0,0 +1,126 @@
+#include "benchmark.h"
+
+#include <message_receiver.h>
+#include <ring_buffer.h>
+#include <thread_pool.h>
+
+#include <common/networking/core.h>
+#include <common/networking/packet.h>
+
+#include <steam/steamnetworkingsockets.h>
+
+#include <memory>
+#include <ranges>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+constexpr int CONNECTION_COUNT = 16;
+constexpr int MESSAGES_PER_TICK = 1024;
+constexpr int TICK_COUNT = 100;
+constexpr int RECEIVE_BATCH_SIZES[] = { 1, 16, 64, RECEIVE_BATCH_SIZE };
+
+using HandlingQueue = SpscRingBuffer<PacketInfoFromClient, HANDLING_QUEUE_CAPACITY>;
+
+/**
+ * \brief Stands in for the thread pool's strands: a handling queue per connection, found
+ * through a map guarded by a shared mutex.
+ */
+struct Strands
+{
+    std::shared_mutex guard;
+    std::unordered_map<HSteamNetConnection, std::unique_ptr<HandlingQueue>> queues;
+
+    HandlingQueue* Find(const HSteamNetConnection conn)
+    {
+        std::shared_lock guard_lock{ guard };
+        return queues.at(conn).get();
+    }
+
+    void Drain()
+    {
+        PacketInfoFromClient packet_info{};
+
+        for (const auto& queue : std::views::values(queues))
+        {
+            while (queue->TryPop(packet_info))
+            {
+            }
+        }
+    }
+};
+
+SCX_BENCHMARK(PollGroupReceive)
+{
+    InitialiseSteamDatagramConnectionSockets();
+
+    ISteamNetworkingSockets* p_sockets = SteamNetworkingSockets();
+    const HSteamNetPollGroup poll_group = p_sockets->CreatePollGroup();
+
+    Strands strands{};
+    std::vector<HSteamNetConnection> client_conns;
+    std::vector<HSteamNetConnection> server_conns;
+
+    for (int i = 0; i < CONNECTION_COUNT; i++)
+    {
+        HSteamNetConnection client_conn, server_conn;
+        p_sockets->CreateSocketPair(&client_conn, &server_conn, false, nullptr, nullptr);
+        p_sockets->SetConnectionPollGroup(server_conn, poll_group);
+
+        client_conns.push_back(client_conn);
+        server_conns.push_back(server_conn);
+        strands.queues[server_conn] = std::make_unique<HandlingQueue>();
+    }
+
+    Packet packet{ PacketType::PlayerInput };
+    packet.Write(true);
+    packet.Write(false);
+    packet.Write(false);
+    packet.Write(true);
+
+    unsigned char buffer[MAX_ENCODED_PACKET_SIZE];
+    const int size = packet.Encode(buffer, sizeof(buffer));
+
+    // The decoded packets of each connection are pushed onto its handling queue, as the
+    // server pushes them onto the connection's strand.
+    const auto enqueue = [&strands](const HSteamNetConnection conn, const std::span<PacketInfoFromClient> packets)
+    {
+        strands.Find(conn)->TryPushBatch(packets.data(), packets.size());
+    };
+
+    for (const int batch_size : RECEIVE_BATCH_SIZES)
+    {
+        MessageReceiver receiver{ batch_size };
+        std::chrono::duration<double> elapsed{ 0 };
+
+        for (int tick = 0; tick < TICK_COUNT; tick++)
+        {
+            // Spread the tick's messages over the clients, so that each batch holds the
+            // messages of several connections.
+            for (int i = 0; i < MESSAGES_PER_TICK; i++)
+            {
+                p_sockets->SendMessageToConnection(client_conns[i % CONNECTION_COUNT], buffer, size,
+                                                   k_nSteamNetworkingSend_Reliable, nullptr);
+            }
+
+            elapsed += Measure([&] { receiver.Receive(p_sockets, poll_group, enqueue); });
+
+            strands.Drain();
+        }
+
+        Benchmarks::Report("ReceiveMessagesOnPollGroup/batch:" + std::to_string(batch_size),
+                           static_cast<uint64_t>(MESSAGES_PER_TICK) * TICK_COUNT, elapsed);
+    }
+
+    for (int i = 0; i < CONNECTION_COUNT; i++)
+    {
+        p_sockets->CloseConnection(client_conns[i], 0, nullptr, false);
+        p_sockets->CloseConnection(server_conns[i], 0, nullptr, false);
+    }
+
+    p_sockets->DestroyPollGroup(poll_group);
+
+    ShutdownSteamDatagramConnectionSockets();
+}
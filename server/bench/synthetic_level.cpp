@@ -0,0 +1,57 @@
+#include "synthetic_level.h"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+static size_t GetGridSize(const size_t platforms)
+{
+    return static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(platforms))));
+}
+
+Level MakeSyntheticLevel(const size_t platforms)
+{
+    const std::filesystem::path path = std::filesystem::temp_directory_path() /
+        ("scx_bench_level_" + std::to_string(platforms) + ".xml");
+
+    const size_t grid_size = GetGridSize(platforms);
+    const float origin = -GetSyntheticLevelExtent(platforms) / 2.0f + SYNTHETIC_PLATFORM_SPACING / 2.0f;
+
+    {
+        std::ofstream file{ path };
+
+        file << "<Level Name=\"Synthetic " << platforms << "\">\n";
+        file << "    <PlayerSpawnPoint Position=\"0.0f, 40.0f\" Scale=\"1.0f, 1.0f\"/>\n";
+
+        for (size_t i = 0; i < platforms; i++)
+        {
+            const float x = origin + static_cast<float>(i % grid_size) * SYNTHETIC_PLATFORM_SPACING;
+            const float y = origin + static_cast<float>(i / grid_size) * SYNTHETIC_PLATFORM_SPACING;
+
+            file << "    <Platform Position=\"" << x << ", " << y << "\" Scale=\"80.0, 15.0\"/>\n";
+        }
+
+        file << "</Level>\n";
+    }
+
+    Level level{ path.string() };
+    level.Load();
+
+    std::filesystem::remove(path);
+
+    return level;
+}
+
+float GetSyntheticLevelExtent(const size_t platforms)
+{
+    return static_cast<float>(GetGridSize(platforms)) * SYNTHETIC_PLATFORM_SPACING;
+}
+
+glm::vec2 RandomSyntheticPosition(const size_t platforms, std::mt19937& random)
+{
+    const float half_extent = GetSyntheticLevelExtent(platforms) / 2.0f;
+    std::uniform_real_distribution<float> coordinate{ -half_extent, half_extent };
+
+    return { coordinate(random), coordinate(random) };
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <common/level.h>
+
+#include <glm/vec2.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+/**
+ * \brief The distance between the centres of neighbouring platforms of a synthetic level.
+ */
+constexpr float SYNTHETIC_PLATFORM_SPACING = 100.0f;
+
+/**
+ * \brief Creates a level of platforms laid out in a square grid, with a spawn point at its
+ * centre. The level is written to a temporary file and loaded as any other level would be.
+ * \param platforms The number of platforms.
+ * \return The loaded level.
+ */
+Level MakeSyntheticLevel(size_t platforms);
+
+/**
+ * \brief Gets the width and height of the square covered by the platforms of a synthetic level,
+ * which is centred on the origin.
+ * \param platforms The number of platforms.
+ */
+float GetSyntheticLevelExtent(size_t platforms);
+
+/**
+ * \brief Picks a random position within a synthetic level.
+ * \param platforms The number of platforms of the level.
+ * \param random The random number generator to use.
+ */
+glm::vec2 RandomSyntheticPosition(size_t platforms, std::mt19937& random);
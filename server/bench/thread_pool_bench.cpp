@@ -0,0 +1,297 @@
+#include "benchmark.h"
+
+#include <ring_buffer.h>
+#include <server_packet_dispatcher.h>
+#include <server_packet_handler.h>
+#include <thread_pool.h>
+
+#include <common/networking/packet.h>
+#include <common/networking/packet_stats.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+constexpr uint64_t PACKETS_PER_WORKER = 1'000'000;
+constexpr unsigned int WORKER_COUNTS[] = { 1, 2, 4, 8 };
+
+constexpr unsigned int STRAND_BENCH_CLIENTS = 16;
+constexpr uint64_t STRAND_BENCH_PACKETS = 1 << 18;
+constexpr size_t STRAND_BENCH_BATCH = 8;
+
+/**
+ * \brief Reproduces the queues the thread pool used before it moved to per-thread ring
+ * buffers: a \code std::queue\endcode per worker, all guarded by one shared mutex.
+ */
+struct LockedQueues
+{
+    std::mutex guard;
+    std::vector<std::queue<PacketInfoToClient>> queues;
+
+    void Push(const unsigned int worker, const Packet& packet)
+    {
+        std::unique_lock guard_lock{ guard };
+        queues[worker].push({ .to_client = worker, .packet = packet });
+    }
+
+    std::optional<PacketInfoToClient> Pop(const unsigned int worker)
+    {
+        std::unique_lock guard_lock{ guard };
+
+        if (queues[worker].empty())
+            return std::nullopt;
+
+        PacketInfoToClient value = queues[worker].front();
+        queues[worker].pop();
+
+        return std::make_optional<PacketInfoToClient>(value);
+    }
+};
+
+/**
+ * \brief Runs one producer and one consumer per worker, each pair exchanging
+ * \code PACKETS_PER_WORKER\endcode packets through \code push\endcode and \code pop\endcode.
+ */
+template <typename Push, typename Pop>
+std::chrono::duration<double> RunProducersAndConsumers(const unsigned int workers, Push push, Pop pop)
+{
+    return Measure([&]
+    {
+        std::vector<std::thread> threads;
+
+        for (unsigned int worker = 0; worker < workers; worker++)
+        {
+            threads.emplace_back([worker, &push]
+            {
+                Packet packet{ PacketType::PlayerMovement };
+                packet.Write(worker);
+
+                for (uint64_t i = 0; i < PACKETS_PER_WORKER; i++)
+                {
+                    while (!push(worker, packet))
+                        std::this_thread::yield();
+                }
+            });
+
+            threads.emplace_back([worker, &pop]
+            {
+                PacketInfoToClient packet_info{};
+
+                for (uint64_t i = 0; i < PACKETS_PER_WORKER; i++)
+                {
+                    while (!pop(worker, packet_info))
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+    });
+}
+
+SCX_BENCHMARK(ThreadPoolQueueContention)
+{
+    for (const unsigned int workers : WORKER_COUNTS)
+    {
+        const uint64_t operations = PACKETS_PER_WORKER * workers;
+
+        LockedQueues locked{};
+        locked.queues.resize(workers);
+
+        const auto locked_elapsed = RunProducersAndConsumers(workers,
+            [&locked](const unsigned int worker, const Packet& packet)
+            {
+                locked.Push(worker, packet);
+                return true;
+            },
+            [&locked](const unsigned int worker, PacketInfoToClient& dest)
+            {
+                auto value = locked.Pop(worker);
+                if (!value.has_value())
+                    return false;
+
+                dest = value.value();
+                return true;
+            });
+
+        Benchmarks::Report("GlobalMutexQueues/workers:" + std::to_string(workers), operations, locked_elapsed);
+
+        using DispatchQueue = MpscRingBuffer<PacketInfoToClient, DISPATCHING_QUEUE_CAPACITY>;
+
+        std::vector<std::unique_ptr<DispatchQueue>> ring_buffers;
+        for (unsigned int worker = 0; worker < workers; worker++)
+            ring_buffers.push_back(std::make_unique<DispatchQueue>());
+
+        const auto ring_buffer_elapsed = RunProducersAndConsumers(workers,
+            [&ring_buffers](const unsigned int worker, const Packet& packet)
+            {
+                return ring_buffers[worker]->TryPush({ .to_client = worker, .packet = packet });
+            },
+            [&ring_buffers](const unsigned int worker, PacketInfoToClient& dest)
+            {
+                return ring_buffers[worker]->TryPop(dest);
+            });
+
+        Benchmarks::Report("PerWorkerRingBuffers/workers:" + std::to_string(workers), operations,
+                           ring_buffer_elapsed);
+    }
+}
+
+SCX_BENCHMARK(DispatchQueueFanIn)
+{
+    // Many producers (the tick thread and other workers) feeding a single client's
+    // dispatch queue, as happens when several threads send packets to the same client.
+    for (const unsigned int producers : WORKER_COUNTS)
+    {
+        auto queue = std::make_unique<MpscRingBuffer<PacketInfoToClient, DISPATCHING_QUEUE_CAPACITY>>();
+
+        const uint64_t operations = PACKETS_PER_WORKER * producers;
+
+        const auto elapsed = Measure([&]
+        {
+            std::vector<std::thread> threads;
+
+            for (unsigned int producer = 0; producer < producers; producer++)
+            {
+                threads.emplace_back([producer, &queue]
+                {
+                    Packet packet{ PacketType::PlayerMovement };
+                    packet.Write(producer);
+
+                    for (uint64_t i = 0; i < PACKETS_PER_WORKER; i++)
+                    {
+                        while (!queue->TryPush({ .to_client = producer, .packet = packet }))
+                            std::this_thread::yield();
+                    }
+                });
+            }
+
+            PacketInfoToClient packet_info{};
+            for (uint64_t i = 0; i < operations; i++)
+            {
+                while (!queue->TryPop(packet_info))
+                    std::this_thread::yield();
+            }
+
+            for (auto& thread : threads)
+                thread.join();
+        });
+
+        Benchmarks::Report("MpscRingBuffer/producers:" + std::to_string(producers), operations, elapsed);
+    }
+}
+
+/**
+ * \brief A dispatcher which counts the packets the workers send instead of sending them.
+ */
+class CountingDispatcher final : public ServerPacketDispatcher
+{
+public:
+    CountingDispatcher()
+        : ServerPacketDispatcher{ nullptr }
+    {
+    }
+
+    void SendToClient(const Packet&, unsigned int) const override
+    {
+        m_sent.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t GetSent() const
+    {
+        return m_sent.load(std::memory_order_relaxed);
+    }
+
+private:
+    mutable std::atomic<uint64_t> m_sent{ 0 };
+};
+
+/**
+ * \brief Gets the number of packets of a type which have been handled by the workers.
+ */
+static uint64_t GetHandled(const PacketType type)
+{
+    return PacketStats::GetSnapshot().types[static_cast<size_t>(type)].handled;
+}
+
+SCX_BENCHMARK(ThreadPoolStrands)
+{
+    // The polling thread hands batches of received packets to the clients' strands while a
+    // tick thread queues packets to send to them, and the pool's workers process both. The
+    // producers never have more packets in flight than a single strand's queues can hold, so
+    // no packet is dropped however unevenly the workers drain the strands.
+    const ServerPacketHandler handler{};
+
+    Packet input{ PacketType::PlayerInput };
+    for (int i = 0; i < 4; i++)
+        input.Write(false);
+
+    const Packet movement{ PacketType::PlayerMovement };
+
+    for (const unsigned int workers : WORKER_COUNTS)
+    {
+        const CountingDispatcher dispatcher{};
+        ThreadPool::Initialise(handler, dispatcher, workers);
+
+        for (unsigned int client = 1; client <= STRAND_BENCH_CLIENTS; client++)
+            ThreadPool::OpenStrand(client);
+
+        const uint64_t handled_before = GetHandled(PacketType::PlayerInput);
+
+        const auto elapsed = Measure([&]
+        {
+            std::thread tick_thread{ [&dispatcher, &movement]
+            {
+                for (uint64_t sent = 0; sent < STRAND_BENCH_PACKETS; sent += STRAND_BENCH_CLIENTS)
+                {
+                    while (sent - dispatcher.GetSent() > DISPATCHING_QUEUE_CAPACITY - STRAND_BENCH_CLIENTS)
+                        std::this_thread::yield();
+
+                    for (unsigned int client = 1; client <= STRAND_BENCH_CLIENTS; client++)
+                        ThreadPool::EnqueuePacketToSend(movement, client);
+                }
+            } };
+
+            std::vector<PacketInfoFromClient> batch(STRAND_BENCH_BATCH);
+            const uint64_t round = STRAND_BENCH_CLIENTS * STRAND_BENCH_BATCH;
+
+            for (uint64_t received = 0; received < STRAND_BENCH_PACKETS; received += round)
+            {
+                while (received - (GetHandled(PacketType::PlayerInput) - handled_before) >
+                       HANDLING_QUEUE_CAPACITY - round)
+                {
+                    std::this_thread::yield();
+                }
+
+                for (unsigned int client = 1; client <= STRAND_BENCH_CLIENTS; client++)
+                {
+                    for (auto& packet_info : batch)
+                        packet_info = { .from_client = client, .packet = input };
+
+                    ThreadPool::EnqueuePacketsToHandle(batch, client);
+                }
+            }
+
+            tick_thread.join();
+
+            while (GetHandled(PacketType::PlayerInput) - handled_before < STRAND_BENCH_PACKETS ||
+                   dispatcher.GetSent() < STRAND_BENCH_PACKETS)
+            {
+                std::this_thread::yield();
+            }
+        });
+
+        for (unsigned int client = 1; client <= STRAND_BENCH_CLIENTS; client++)
+            ThreadPool::CloseStrand(client);
+
+        ThreadPool::Dispose();
+
+        Benchmarks::Report("ThreadPool/workers:" + std::to_string(workers), 2 * STRAND_BENCH_PACKETS, elapsed);
+    }
+}
@@ -23,6 +23,7 @@ project "server"
     links
     {
         "common",
+        "common_networking",
         "GLFW"
     }
 
@@ -31,6 +32,11 @@ project "server"
 
     filter {}
 
+    filter { "options:avx2" }
+        vectorextensions "AVX2"
+
+    filter {}
+
     filter { "system:Windows", "configurations:Debug" }
         links { "../thirdparty/game-networking/libs/Windows/Debug/GameNetworkingSockets.lib" }
 
@@ -30,6 +30,7 @@ project "server_tests"
     links
     {
         "common",
+        "common_networking",
         "GLFW"
     }
     
@@ -38,6 +39,11 @@ project "server_tests"
 
     filter {}
 
+    filter { "options:avx2" }
+        vectorextensions "AVX2"
+
+    filter {}
+
     filter { "system:Windows", "configurations:Debug" }
         links { "../thirdparty/game-networking/libs/Windows/Debug/GameNetworkingSockets.lib" }
 
@@ -0,0 +1,138 @@
+#include "client_registry.h"
+
+#include <common/utils/assertion.h>
+
+#include <algorithm>
+
+ClientHandle ClientRegistry::Add(const HSteamNetConnection connection, std::string username)
+{
+    const auto it_connection = FindConnection(connection);
+    SCX_ASSERT(it_connection == m_connection_slots.end() || it_connection->first != connection,
+               "A client associated with this connection already exists.");
+
+    uint32_t slot;
+    if (!m_free_slots.empty())
+    {
+        slot = m_free_slots.back();
+        m_free_slots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<uint32_t>(m_slots.size());
+        m_slots.push_back({ .index = 0, .generation = 0 });
+    }
+
+    m_slots[slot].index = static_cast<uint32_t>(m_players.size());
+
+    m_players.emplace_back();
+    m_position_histories.emplace_back();
+    m_info.push_back({ .connection = connection, .username = std::move(username) });
+    m_slot_of.push_back(slot);
+
+    m_connection_slots.emplace(it_connection, connection, slot);
+
+    return { .slot = slot, .generation = m_slots[slot].generation };
+}
+
+bool ClientRegistry::Remove(const HSteamNetConnection connection)
+{
+    const auto it_connection = FindConnection(connection);
+    if (it_connection == m_connection_slots.end() || it_connection->first != connection)
+        return false;
+
+    // Invalidate the handles of the removed client before its slot is reused.
+    const uint32_t slot = it_connection->second;
+    const size_t index = m_slots[slot].index;
+
+    m_slots[slot].generation++;
+    m_free_slots.push_back(slot);
+    m_connection_slots.erase(it_connection);
+
+    const size_t last = m_players.size() - 1;
+    if (index != last)
+    {
+        m_players[index] = std::move(m_players[last]);
+        m_position_histories[index] = m_position_histories[last];
+        m_info[index] = std::move(m_info[last]);
+        m_slot_of[index] = m_slot_of[last];
+
+        m_slots[m_slot_of[index]].index = static_cast<uint32_t>(index);
+    }
+
+    m_players.pop_back();
+    m_position_histories.pop_back();
+    m_info.pop_back();
+    m_slot_of.pop_back();
+
+    return true;
+}
+
+void ClientRegistry::Clear()
+{
+    while (!m_info.empty())
+        Remove(m_info.back().connection);
+}
+
+std::optional<size_t> ClientRegistry::Find(const HSteamNetConnection connection) const
+{
+    const auto it_connection = FindConnection(connection);
+    if (it_connection == m_connection_slots.end() || it_connection->first != connection)
+        return std::nullopt;
+
+    return m_slots[it_connection->second].index;
+}
+
+std::optional<size_t> ClientRegistry::Find(const ClientHandle handle) const
+{
+    if (handle.slot >= m_slots.size() || m_slots[handle.slot].generation != handle.generation)
+        return std::nullopt;
+
+    return m_slots[handle.slot].index;
+}
+
+ClientHandle ClientRegistry::GetHandle(const size_t index) const
+{
+    const uint32_t slot = m_slot_of[index];
+    return { .slot = slot, .generation = m_slots[slot].generation };
+}
+
+size_t ClientRegistry::GetSize() const
+{
+    return m_players.size();
+}
+
+std::span<Player> ClientRegistry::GetPlayers()
+{
+    return m_players;
+}
+
+std::span<const Player> ClientRegistry::GetPlayers() const
+{
+    return m_players;
+}
+
+std::span<PositionHistory> ClientRegistry::GetPositionHistories()
+{
+    return m_position_histories;
+}
+
+std::span<const PositionHistory> ClientRegistry::GetPositionHistories() const
+{
+    return m_position_histories;
+}
+
+std::span<ClientInfo> ClientRegistry::GetInfo()
+{
+    return m_info;
+}
+
+std::span<const ClientInfo> ClientRegistry::GetInfo() const
+{
+    return m_info;
+}
+
+std::vector<std::pair<HSteamNetConnection, uint32_t>>::const_iterator ClientRegistry::FindConnection(
+    const HSteamNetConnection connection) const
+{
+    return std::ranges::lower_bound(m_connection_slots, connection, {}, &std::pair<HSteamNetConnection, uint32_t>::first);
+}
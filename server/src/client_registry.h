@@ -0,0 +1,148 @@
+#pragma once
+
+#include "player.h"
+#include "position_history.h"
+
+#include <steam/steamnetworkingtypes.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * \brief Data about a connected client which is rarely needed by the simulation.
+ */
+struct ClientInfo
+{
+    HSteamNetConnection connection;
+    std::string username;
+
+    /**
+     * \brief The round-trip time to the client in milliseconds, sampled when the client joins
+     * and then at most once a second.
+     */
+    int ping = 0;
+};
+
+/**
+ * \brief A handle to a client of a registry, which is never reused by a later client.
+ */
+struct ClientHandle
+{
+    uint32_t slot;
+    uint32_t generation;
+};
+
+/**
+ * \brief Stores the connected clients as a slot map, so that per-tick work scans contiguous
+ * arrays.
+ *
+ * The data used by the simulation every tick, such as each client's player and position
+ * history, is kept in dense arrays apart from the rest of the client's data. Clients are
+ * removed by moving the last client into the gap, so their indices change over time. A client
+ * can instead be held by a handle made of its slot and that slot's generation. Connections are
+ * mapped to slots by a small table sorted by connection.
+ */
+class ClientRegistry
+{
+public:
+    ClientRegistry() = default;
+    ~ClientRegistry() = default;
+
+    ClientRegistry(const ClientRegistry&) = delete;
+    ClientRegistry& operator=(const ClientRegistry&) = delete;
+
+    ClientRegistry(ClientRegistry&&) noexcept = delete;
+    ClientRegistry& operator=(ClientRegistry&&) noexcept = delete;
+
+    /**
+     * \brief Adds a client, whose player starts at its default state.
+     * \param connection The connection of the client, which must not already be registered.
+     * \param username The username of the client.
+     * \return The handle of the new client.
+     */
+    ClientHandle Add(HSteamNetConnection connection, std::string username);
+
+    /**
+     * \brief Removes a client by moving the last client into its place, so the index of the
+     * last client changes.
+     * \param connection The connection of the client.
+     * \return A true or false value indicating whether the client was registered.
+     */
+    bool Remove(HSteamNetConnection connection);
+
+    /**
+     * \brief Removes every client.
+     */
+    void Clear();
+
+    /**
+     * \brief Finds the current index of a client by its connection.
+     * \param connection The connection of the client.
+     * \return The index of the client, or nothing if the connection is not registered.
+     */
+    [[nodiscard]] std::optional<size_t> Find(HSteamNetConnection connection) const;
+
+    /**
+     * \brief Finds the current index of a client by its handle.
+     * \param handle The handle of the client.
+     * \return The index of the client, or nothing if the client has been removed.
+     */
+    [[nodiscard]] std::optional<size_t> Find(ClientHandle handle) const;
+
+    /**
+     * \brief Gets the handle of a client.
+     * \param index The index of the client.
+     * \return The handle of the client.
+     */
+    [[nodiscard]] ClientHandle GetHandle(size_t index) const;
+
+    /**
+     * \brief Gets the number of registered clients.
+     * \return The number of clients.
+     */
+    [[nodiscard]] size_t GetSize() const;
+
+    [[nodiscard]] std::span<Player> GetPlayers();
+    [[nodiscard]] std::span<const Player> GetPlayers() const;
+    [[nodiscard]] std::span<PositionHistory> GetPositionHistories();
+    [[nodiscard]] std::span<const PositionHistory> GetPositionHistories() const;
+    [[nodiscard]] std::span<ClientInfo> GetInfo();
+    [[nodiscard]] std::span<const ClientInfo> GetInfo() const;
+
+private:
+    /**
+     * \brief An entry of the table which maps the slot of a handle to a client.
+     */
+    struct Slot
+    {
+        uint32_t index;
+        uint32_t generation;
+    };
+
+    // The hot data of each client, indexed by the client's index.
+    std::vector<Player> m_players;
+    std::vector<PositionHistory> m_position_histories;
+
+    // The cold data of each client, indexed by the client's index.
+    std::vector<ClientInfo> m_info;
+    std::vector<uint32_t> m_slot_of;
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_free_slots;
+
+    /**
+     * \brief The slot of each connection, sorted by connection.
+     */
+    std::vector<std::pair<HSteamNetConnection, uint32_t>> m_connection_slots;
+
+    /**
+     * \brief Finds the entry of a connection in the connection table, or where it would be inserted.
+     */
+    [[nodiscard]] std::vector<std::pair<HSteamNetConnection, uint32_t>>::const_iterator FindConnection(
+        HSteamNetConnection connection) const;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <common/networking/packet.h>
+
+#include <steam/steamnetworkingtypes.h>
+
+#include <optional>
+#include <span>
+
+/**
+ * \brief The interface through which rooms send packets to their clients and sample the
+ * clients' connections. The server implements it over the network, and the tests and
+ * benchmarks share a fake implementation so that rooms can be updated without a server.
+ * Every function may be called from any thread.
+ */
+class IClientTransport
+{
+public:
+    IClientTransport() = default;
+
+    IClientTransport(const IClientTransport&) = default;
+    IClientTransport& operator=(const IClientTransport&) = default;
+
+    IClientTransport(IClientTransport&&) noexcept = default;
+    IClientTransport& operator=(IClientTransport&&) noexcept = default;
+
+    virtual ~IClientTransport() = default;
+
+    /**
+     * \brief Sends a packet to a client, in order with the other packets sent to it.
+     * \param packet The packet which will be sent to the client.
+     * \param client The client identifier.
+     */
+    virtual void Send(const Packet& packet, unsigned int client) const = 0;
+
+    /**
+     * \brief Sends a packet to a set of clients, encoding it only once.
+     * \param packet The packet which will be dispatched to each client.
+     * \param clients The client connections to which the packet will be sent.
+     * \param except The client connection to exclude from the transmission. If left to be 0,
+     * no clients will be excluded.
+     */
+    virtual void Multicast(const Packet& packet, std::span<const HSteamNetConnection> clients,
+                           HSteamNetConnection except = k_HSteamNetConnection_Invalid) const = 0;
+
+    /**
+     * \brief Gets the round-trip time to a client.
+     * \param client The client connection.
+     * \return The round-trip time in milliseconds, or nothing if the connection's status is
+     * unavailable.
+     */
+    [[nodiscard]] virtual std::optional<int> GetPing(HSteamNetConnection client) const = 0;
+};
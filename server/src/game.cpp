@@ -1,55 +1,114 @@
 #include "game.h"
 #include "player.h"
-#include "projectile.h"
-#include "server.h"
+#include "room.h"
+#include "server_packet_dispatcher.h"
+#include "tick_profiler.h"
 
+#include "physics/batch_kernels.h"
+#include "physics/collision.h"
+
+#include <common/world.h>
 #include <common/level_manager.h>
 
-Game Game::s_instance{};
+#include <common/utils/logging.h>
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <optional>
+#include <span>
+#include <utility>
+
+constexpr float PROJECTILE_SPEED = 200.0f;
+constexpr float PROJECTILE_EXPIRATION_TIME = 3.0f;
+constexpr int PROJECTILE_DAMAGE = 10;
+
+Game::Game()
+    : m_tick{ 0 },
+      m_hit_detector{ std::max(PLAYER_SCALE.x, PLAYER_SCALE.y) + std::max(PROJECTILE_SCALE.x, PROJECTILE_SCALE.y) }
+{
+}
 
 void Game::Initialise()
 {
     LevelManager::Initialise();
+
+    SCX_CORE_INFO("Using {0} physics kernels.", Batch::GetInstructionSet());
 }
 
 void Game::Update(const double dt)
 {
-    // Update and send player movement packets to connected clients.
-    for (auto& [client_id, client_info] : Server::GetClientInfoMap())
     {
-        Player& client_player = client_info.player;
-        client_player.Update(dt);
-
-        PlayerMovement(client_id, client_player);
+        const ScopedPhaseTimer timer{ TickPhase::Commands };
+        ApplyCommands();
     }
 
-    // Update and send projectile-related packets to connected clients.
-    auto it = Get().m_projectiles.begin();
-    while (it != Get().m_projectiles.end())
+    const uint64_t tick = ++Get().m_tick;
+
+    ClientRegistry& clients = Room::GetCurrent().GetClients();
+    const std::span players = clients.GetPlayers();
+    const std::span position_histories = clients.GetPositionHistories();
+
+    // Update the players of connected clients, recording where they are for lag compensation.
     {
-        if ((*it).HasExpired())
+        const ScopedPhaseTimer timer{ TickPhase::Players };
+
+        for (size_t i = 0; i < players.size(); i++)
         {
-            // If a projectile has expired, notify the clients and remove it.
-            ProjectileDestroy(*it);
-            it = Get().m_projectiles.erase(it);
+            players[i].Update(dt);
+            position_histories[i].Record(tick, players[i].GetPosition());
         }
-        else
+    }
+
+    ProjectilePool& projectiles = Get().m_projectiles;
+
+    {
+        const ScopedPhaseTimer timer{ TickPhase::Projectiles };
+
+        // Remove the projectiles which expired during the last update, notifying the clients.
+        for (size_t i = 0; i < projectiles.GetSize();)
         {
-            (*it).Update(dt);
-            ++it;
+            if (projectiles.HasExpired(i))
+            {
+                // The last projectile is moved into this index, so it is checked next.
+                ProjectileDestroy(projectiles.GetIds()[i]);
+                projectiles.Remove(i);
+            }
+            else
+                i++;
         }
+
+        projectiles.Integrate(static_cast<float>(dt));
     }
+
+    const ScopedPhaseTimer timer{ TickPhase::Collisions };
+    CollideProjectiles(dt);
+}
+
+bool Game::EnqueueCommand(GameCommand&& command)
+{
+    const unsigned int client_id = command.client_id;
+
+    if (!Get().m_commands.TryPush(std::move(command)))
+    {
+        SCX_CORE_WARN("The game command queue is full, dropping a command from client {0}.", client_id);
+        return false;
+    }
+
+    return true;
 }
 
 void Game::SpawnProjectile(const glm::vec2 position, const glm::vec2 direction, const unsigned int src_id)
 {
-    const Projectile projectile = Get().m_projectiles.emplace_back(position, direction, src_id);
-    ProjectileUpdate(projectile);
+    // The projectile is replicated to the clients by the next snapshot.
+    Get().m_projectiles.Spawn(position, direction * PROJECTILE_SPEED, src_id, PROJECTILE_EXPIRATION_TIME);
 }
 
 void Game::SpawnPlayer(Player& player)
 {
-    Level& current_level = LevelManager::GetActive();
+    Level& current_level = Room::GetCurrent().GetLevel();
     const auto& potential_spawn_points = current_level.GetByType(LevelContent::Type::PlayerSpawnPoint);
 
     if (potential_spawn_points.empty())
@@ -63,12 +122,210 @@ void Game::SpawnPlayer(Player& player)
     player.SetPosition(spawn_point.position);
 }
 
-std::vector<Projectile> Game::GetProjectiles()
+const ProjectilePool& Game::GetProjectiles()
 {
     return Get().m_projectiles;
 }
 
 Game& Game::Get()
 {
-    return s_instance;
+    return Room::GetCurrent().GetGame();
+}
+
+void Game::ApplyCommands()
+{
+    Room& room = Room::GetCurrent();
+    ClientRegistry& clients = room.GetClients();
+
+    // Commands queued while draining are left for the next update, so that clients which
+    // keep sending cannot hold up the tick.
+    GameCommand command;
+
+    for (size_t pending = Get().m_commands.Size(); pending > 0 && Get().m_commands.TryPop(command); pending--)
+    {
+        std::optional<size_t> index = clients.Find(command.client_id);
+
+        // A client is only added to the room once its join is applied, unless it has already
+        // left the room.
+        if (!index && command.type == GameCommand::Type::Join && !room.DiscardJoin(command.client_id))
+            index = room.AddClient(command.client_id, std::move(command.text));
+
+        // The client may have disconnected since the command was queued.
+        if (!index)
+            continue;
+
+        ClientInfo& client_info = clients.GetInfo()[*index];
+        Player& player = clients.GetPlayers()[*index];
+
+        switch (command.type)
+        {
+        case GameCommand::Type::Join:
+            SCX_CORE_INFO("{0} has joined room {1}.", client_info.username, room.GetId());
+
+            player.SetId(command.client_id);
+
+            SpawnPlayer(player);
+            PlayerConnected(command.client_id, client_info.username);
+            break;
+        case GameCommand::Type::Input:
+            player.ProcessInput(command.inputs[0], command.inputs[1], command.inputs[2], command.inputs[3]);
+            break;
+        case GameCommand::Type::WeaponRotation:
+            player.SetWeaponRotation(command.weapon_rotation);
+            PlayerWeaponRotation_Dispatch(command.client_id, player);
+            break;
+        case GameCommand::Type::Respawn:
+            player.Respawn();
+
+            // The player must not be hit where they were before respawning.
+            clients.GetPositionHistories()[*index].Clear();
+
+            PlayerRespawn(command.client_id);
+            break;
+        case GameCommand::Type::ChatMessage:
+            ChatMessageSend(command.client_id, command.text);
+            break;
+        }
+    }
+}
+
+void Game::CollideProjectiles(const double dt)
+{
+    Game& game = Get();
+    const ProjectilePool& projectiles = game.m_projectiles;
+
+    const ClientRegistry& clients = Room::GetCurrent().GetClients();
+    const std::span players = clients.GetPlayers();
+    const std::span position_histories = clients.GetPositionHistories();
+    const std::span client_info = clients.GetInfo();
+
+    // Each target is at the same index as the client it belongs to.
+    std::vector<HitTarget>& targets = game.m_hit_targets;
+    std::vector<std::pair<unsigned int, uint64_t>>& view_ticks = game.m_view_ticks;
+    std::vector<std::pair<uint64_t, uint32_t>>& projectile_order = game.m_projectile_order;
+
+    targets.clear();
+    view_ticks.clear();
+    projectile_order.clear();
+
+    // Hits cannot be rewound further than the positions which are kept.
+    const auto max_rewind = std::min(static_cast<uint64_t>(MAX_LAG_COMPENSATION / std::chrono::duration<double>(dt)),
+                                     static_cast<uint64_t>(POSITION_HISTORY_LENGTH - 1));
+
+    for (size_t i = 0; i < players.size(); i++)
+    {
+        const Player& player = players[i];
+
+        targets.push_back({
+            .id = player.GetId(), .position = player.GetPosition(), .scale = player.GetScale(),
+            .can_be_hit = player.GetCurrentHealth() > 0
+        });
+
+        // A client sees the world as it was half a round trip ago, and its shots reach the
+        // server half a round trip later, so its hits are rewound by a whole round trip.
+        const auto rewind = static_cast<uint64_t>(std::lround(client_info[i].ping / 1000.0 / dt));
+        view_ticks.emplace_back(player.GetId(), game.m_tick - std::min({ rewind, max_rewind, game.m_tick - 1 }));
+    }
+
+    std::ranges::sort(view_ticks);
+
+    // Group the projectiles by the tick their shooter saw, so the targets are only rewound
+    // once for each group.
+    const std::span owners = projectiles.GetOwners();
+
+    for (uint32_t i = 0; i < projectiles.GetSize(); i++)
+    {
+        const auto it = std::ranges::lower_bound(view_ticks, owners[i], {}, &std::pair<unsigned int, uint64_t>::first);
+        const bool has_shooter = it != view_ticks.end() && it->first == owners[i];
+
+        projectile_order.emplace_back(has_shooter ? it->second : game.m_tick, i);
+    }
+
+    std::ranges::sort(projectile_order);
+
+    const StaticGeometry& static_geometry = Room::GetCurrent().GetLevel().GetStaticGeometry();
+
+    for (size_t first = 0; first < projectile_order.size();)
+    {
+        const uint64_t view_tick = projectile_order[first].first;
+
+        // Move the targets back to where they were at the tick the shooters saw.
+        for (size_t i = 0; i < targets.size(); i++)
+            targets[i].position = position_histories[i].GetPosition(view_tick).value_or(players[i].GetPosition());
+
+        game.m_hit_detector.Build(targets);
+
+        size_t last = first;
+        for (; last < projectile_order.size() && projectile_order[last].first == view_tick; last++)
+            CollideProjectile(projectile_order[last].second, static_geometry);
+
+        first = last;
+    }
+}
+
+void Game::CollideProjectile(const size_t index, const StaticGeometry& static_geometry)
+{
+    Game& game = Get();
+    ProjectilePool& projectiles = game.m_projectiles;
+    std::vector<HitTarget>& targets = game.m_hit_targets;
+
+    const glm::vec2 position = projectiles.GetPositions()[index];
+    const glm::vec2 previous_position = projectiles.GetPreviousPositions()[index];
+    const glm::vec2 velocity = projectiles.GetVelocities()[index];
+
+    // Projectiles point along their velocity, which gives the axes of their box without
+    // computing the sine and cosine of their rotation.
+    const float speed = glm::length(velocity);
+    const glm::vec2 direction = speed > 0.0f ? velocity / speed : glm::vec2{ 1.0f, 0.0f };
+
+    // Each projectile is swept from where it was before the last update, so that it cannot
+    // pass through a player or a platform which is thinner than its movement.
+    const HitProjectile projectile{
+        .position = position, .direction = direction, .owner_id = projectiles.GetOwners()[index],
+        .displacement = position - previous_position
+    };
+
+    float player_time = 0.0f;
+    const int hit = game.m_hit_detector.FindProjectileHit(projectile, PROJECTILE_SCALE, targets, &player_time);
+
+    const Collision::Box2d start_box = Collision::MakeBox2d(previous_position, PROJECTILE_SCALE / 2.0f, direction);
+
+    glm::vec2 start_min, start_max;
+    Collision::GetBounds(start_box, start_min, start_max);
+
+    const glm::vec2 min = start_min + projectile.displacement;
+    const glm::vec2 max = start_max + projectile.displacement;
+
+    // Only the static boxes which overlap the bounds of the whole movement can be hit.
+    std::optional<float> platform_time;
+
+    static_geometry.QueryBox(
+        { std::min(min.x, start_min.x), std::min(min.y, start_min.y) },
+        { std::max(max.x, start_max.x), std::max(max.y, start_max.y) },
+        [&](const StaticBox& platform)
+        {
+            const Collision::Box2d platform_box = Collision::MakeBox2d(
+                (platform.min + platform.max) / 2.0f, (platform.max - platform.min) / 2.0f, { 1.0f, 0.0f });
+
+            const std::optional<Collision::Contact> contact = Collision::SweepBox2d(
+                start_box, projectile.displacement, platform_box);
+
+            if (contact && (!platform_time || contact->time < *platform_time))
+                platform_time = contact->time;
+        });
+
+    // A player behind a platform is protected by it.
+    if (hit != NO_HIT && (!platform_time || player_time <= *platform_time))
+    {
+        // A collision has occurred, apply damage to the relevant player.
+        Player& player = Room::GetCurrent().GetClients().GetPlayers()[hit];
+        player.RemoveHealth(PROJECTILE_DAMAGE);
+
+        // A player who has died cannot be hit by the remaining projectiles.
+        targets[hit].can_be_hit = player.GetCurrentHealth() > 0;
+    }
+
+    // To stop multiple collisions from occurring, mark the projectile as expired.
+    if (hit != NO_HIT || platform_time)
+        projectiles.Expire(index);
 }
@@ -1,34 +1,55 @@
 #pragma once
 
+#include "game_command.h"
+#include "projectile_pool.h"
+#include "ring_buffer.h"
+
+#include "physics/hit_detection.h"
+
 #include <glm/vec2.hpp>
 
+#include <cstdint>
+#include <utility>
 #include <vector>
 
-class Projectile;
 class Player;
+class StaticGeometry;
 
 /**
- * \brief The server game class.
+ * \brief The game world of a room. Its static functions act on the game of the calling
+ * thread's current room.
  */
 class Game
 {
 public:
     ~Game() = default;
 
-    Game(const Game&) = default;
-    Game& operator=(const Game&) = default;
+    Game(const Game&) = delete;
+    Game& operator=(const Game&) = delete;
 
-    Game(Game&&) noexcept = default;
-    Game& operator=(Game&&) noexcept = default;
+    Game(Game&&) noexcept = delete;
+    Game& operator=(Game&&) noexcept = delete;
 
+    /**
+     * \brief Loads the levels which are shared by every room.
+     */
     static void Initialise();
 
     /**
-     * \brief Updates the game.
+     * \brief Updates the game, first applying the commands queued since the last update.
      * \param dt The delta time between frames of the game.
      */
     static void Update(double dt);
 
+    /**
+     * \brief Queues a command to be applied to the game world at the start of the next update.
+     * May be called from any thread whose current room is the game's room.
+     * \param command The command.
+     * \return A true or false value indicating whether the command was queued, which it is not
+     * when the queue is full.
+     */
+    static bool EnqueueCommand(GameCommand&& command);
+
     /**
      * \brief Spawns an instance of a projectile in the game world.
      * \param position The position of the new projectile.
@@ -40,16 +61,66 @@ public:
     static void SpawnPlayer(Player& player);
 
     /**
-     * \brief Gets the projectiles which currently exist in the game world.
-     * \return A vector of existing projectiles.
+     * \brief Gets the projectiles which currently exist in the game world. Must only be
+     * called from the thread which updates the game.
+     * \return A read-only view of the pool of existing projectiles.
      */
-    static [[nodiscard]] std::vector<Projectile> GetProjectiles();
+    [[nodiscard]] static const ProjectilePool& GetProjectiles();
 
 private:
-    std::vector<Projectile> m_projectiles;
+    ProjectilePool m_projectiles;
 
-    Game() = default;
+    /**
+     * \brief The commands waiting to be applied, pushed by the worker threads and drained by
+     * the thread which updates the game.
+     */
+    MpscRingBuffer<GameCommand, GAME_COMMAND_QUEUE_CAPACITY> m_commands;
+
+    /**
+     * \brief The number of updates which have been run, which identifies the positions recorded
+     * for lag compensation.
+     */
+    uint64_t m_tick;
+
+    /**
+     * \brief The players which projectiles can hit, rebuilt every update, at the same index as
+     * the client each target belongs to.
+     */
+    std::vector<HitTarget> m_hit_targets;
+    HitDetector m_hit_detector;
+
+    /**
+     * \brief The tick of the world each player saw, sorted by player identifier, and the index
+     * of each projectile sorted by the tick its shooter saw. Both are rebuilt every update.
+     */
+    std::vector<std::pair<unsigned int, uint64_t>> m_view_ticks;
+    std::vector<std::pair<uint64_t, uint32_t>> m_projectile_order;
+
+    Game();
+
+    /**
+     * \brief Applies the commands which were queued before the call.
+     */
+    static void ApplyCommands();
+
+    /**
+     * \brief Expires the projectiles which have hit a player or a platform, applying damage to
+     * any player which was hit. Only the players near each projectile are tested, and they
+     * are rewound to where the projectile's shooter saw them to compensate for the shooter's
+     * latency.
+     * \param dt The length of the update, used to convert latency into ticks.
+     */
+    static void CollideProjectiles(double dt);
+
+    /**
+     * \brief Tests a projectile against the targets, as last built by the hit detector, and
+     * the static geometry of the level.
+     * \param index The index of the projectile.
+     * \param static_geometry The static geometry of the active level.
+     */
+    static void CollideProjectile(size_t index, const StaticGeometry& static_geometry);
 
-    static Game s_instance;
     static Game& Get();
+
+    friend class Room;
 };
\ No newline at end of file
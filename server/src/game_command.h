@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * \brief The number of commands which can wait to be applied to the game world of a room.
+ */
+constexpr size_t GAME_COMMAND_QUEUE_CAPACITY = 16384;
+
+/**
+ * \brief A change to the game world requested by a client. Commands are decoded from packets
+ * by the worker threads and applied by the tick thread of the client's room, so that only that
+ * thread modifies the room's world.
+ */
+struct GameCommand
+{
+    enum class Type : uint8_t
+    {
+        Join,
+        Input,
+        WeaponRotation,
+        Respawn,
+        ChatMessage
+    };
+
+    Type type = Type::Input;
+    unsigned int client_id = 0;
+
+    /**
+     * \brief Whether the W, A and D keys and the left mouse button are pressed, for input commands.
+     */
+    std::array<bool, 4> inputs{};
+
+    float weapon_rotation = 0.0f;
+
+    /**
+     * \brief The username of a joining client, or the text of a chat message.
+     */
+    std::string text{};
+};
@@ -0,0 +1,204 @@
+#include "interest_manager.h"
+
+#include "room.h"
+#include "server_packet_dispatcher.h"
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <ranges>
+
+/**
+ * \brief Gets the identifier of a player.
+ */
+static unsigned int GetEntityId(const PlayerSnapshot& player)
+{
+    return player.id;
+}
+
+/**
+ * \brief Gets the identifier of a projectile.
+ */
+static uint64_t GetEntityId(const ProjectileSnapshot& projectile)
+{
+    return static_cast<uint64_t>(projectile.id);
+}
+
+/**
+ * \brief Appends the entities with the given sorted identifiers to a sorted array.
+ * \param entities The entities to search, sorted by identifier.
+ * \param ids The identifiers of the entities to append.
+ * \param out The array to append to.
+ */
+template <typename T, typename Id>
+static void AppendEntities(const std::vector<T>& entities, const std::vector<Id>& ids, std::vector<T>& out)
+{
+    auto it = entities.begin();
+    for (const Id id : ids)
+    {
+        // Both arrays are sorted, so each search can start where the previous one ended.
+        it = std::lower_bound(it, entities.end(), id, [](const T& entity, const Id value)
+        {
+            return GetEntityId(entity) < value;
+        });
+
+        if (it != entities.end() && GetEntityId(*it) == id)
+            out.push_back(*it);
+    }
+}
+
+InterestManager::InterestManager()
+    : m_player_grid{ INTEREST_LEAVE_RADIUS },
+      m_projectile_grid{ INTEREST_LEAVE_RADIUS }
+{
+}
+
+void InterestManager::Update(const WorldSnapshot& world)
+{
+    Get().m_player_grid.Clear();
+    for (uint32_t i = 0; i < world.players.size(); i++)
+        Get().m_player_grid.Insert(i, world.players[i].position);
+
+    Get().m_projectile_grid.Clear();
+    for (uint32_t i = 0; i < world.projectiles.size(); i++)
+        Get().m_projectile_grid.Insert(i, world.projectiles[i].position);
+
+    std::vector<unsigned int> previous_players, changed_players;
+    std::vector<uint64_t> previous_projectiles;
+
+    for (const Player& player : Room::GetCurrent().GetClients().GetPlayers())
+    {
+        // Clients which have not joined the game yet have no player to centre a region on.
+        const unsigned int client_id = player.GetId();
+        if (client_id == 0)
+            continue;
+
+        ClientInterest& interest = Get().m_clients[client_id];
+        const glm::vec2 centre = player.GetPosition();
+
+        previous_players.swap(interest.visible_players);
+        FindVisible(Get().m_player_grid, world.players, centre, previous_players, interest.visible_players);
+
+        // The client's own player is always relevant, so it is never spawned or despawned.
+        std::erase(interest.visible_players, client_id);
+
+        changed_players.clear();
+        std::ranges::set_difference(interest.visible_players, previous_players, std::back_inserter(changed_players));
+        for (const unsigned int player_id : changed_players)
+            PlayerSpawn(client_id, player_id);
+
+        changed_players.clear();
+        std::ranges::set_difference(previous_players, interest.visible_players, std::back_inserter(changed_players));
+        for (const unsigned int player_id : changed_players)
+            PlayerDespawn(client_id, player_id);
+
+        previous_projectiles.swap(interest.visible_projectiles);
+        FindVisible(Get().m_projectile_grid, world.projectiles, centre, previous_projectiles,
+                    interest.visible_projectiles);
+    }
+
+    std::unique_lock viewers_lock{ Get().m_viewers_guard };
+
+    for (auto& viewers : Get().m_player_viewers | std::views::values)
+        viewers.clear();
+
+    for (const auto& [client_id, interest] : Get().m_clients)
+    {
+        for (const unsigned int player_id : interest.visible_players)
+            Get().m_player_viewers[player_id].push_back(client_id);
+    }
+
+    std::erase_if(Get().m_player_viewers, [](const auto& entry) { return entry.second.empty(); });
+}
+
+WorldSnapshot InterestManager::GetView(const unsigned int client_id, const WorldSnapshot& world)
+{
+    WorldSnapshot view{};
+    view.sequence = world.sequence;
+
+    const auto it = Get().m_clients.find(client_id);
+    if (it == Get().m_clients.end())
+        return view;
+
+    AppendEntities(world.players, it->second.visible_players, view.players);
+    AppendEntities(world.projectiles, it->second.visible_projectiles, view.projectiles);
+
+    // Insert the client's own player, keeping the players sorted.
+    const auto by_id = [](const PlayerSnapshot& player, const unsigned int id) { return player.id < id; };
+
+    const auto own_it = std::lower_bound(world.players.begin(), world.players.end(), client_id, by_id);
+    if (own_it != world.players.end() && own_it->id == client_id)
+        view.players.insert(std::lower_bound(view.players.begin(), view.players.end(), client_id, by_id), *own_it);
+
+    return view;
+}
+
+std::vector<unsigned int> InterestManager::GetPlayerViewers(const unsigned int player_id)
+{
+    std::shared_lock viewers_lock{ Get().m_viewers_guard };
+
+    const auto it = Get().m_player_viewers.find(player_id);
+    return it != Get().m_player_viewers.end() ? it->second : std::vector<unsigned int>{};
+}
+
+std::vector<unsigned int> InterestManager::GetProjectileViewers(const UUID projectile_id)
+{
+    std::vector<unsigned int> viewers;
+
+    for (const auto& [client_id, interest] : Get().m_clients)
+    {
+        if (std::ranges::binary_search(interest.visible_projectiles, static_cast<uint64_t>(projectile_id)))
+            viewers.push_back(client_id);
+    }
+
+    return viewers;
+}
+
+void InterestManager::RemoveClient(const unsigned int client_id)
+{
+    const auto it = Get().m_clients.find(client_id);
+    if (it == Get().m_clients.end())
+        return;
+
+    // Stop packets from being sent to the client before the next update rebuilds the viewers.
+    {
+        std::unique_lock viewers_lock{ Get().m_viewers_guard };
+
+        for (const unsigned int player_id : it->second.visible_players)
+            std::erase(Get().m_player_viewers[player_id], client_id);
+    }
+
+    Get().m_clients.erase(it);
+}
+
+InterestManager& InterestManager::Get()
+{
+    return Room::GetCurrent().GetInterest();
+}
+
+template <typename T, typename Id>
+void InterestManager::FindVisible(const SpatialGrid& grid, const std::vector<T>& entities, const glm::vec2 centre,
+                                  const std::vector<Id>& previous, std::vector<Id>& visible)
+{
+    constexpr float enter_distance_squared = INTEREST_ENTER_RADIUS * INTEREST_ENTER_RADIUS;
+    constexpr float leave_distance_squared = INTEREST_LEAVE_RADIUS * INTEREST_LEAVE_RADIUS;
+
+    visible.clear();
+
+    grid.Query(centre, INTEREST_LEAVE_RADIUS, [&](const uint32_t index)
+    {
+        const T& entity = entities[index];
+
+        const glm::vec2 offset = entity.position - centre;
+        const float distance_squared = offset.x * offset.x + offset.y * offset.y;
+
+        // Entities enter the region at a shorter distance than they leave it.
+        if (distance_squared <= enter_distance_squared ||
+            (distance_squared <= leave_distance_squared && std::ranges::binary_search(previous, GetEntityId(entity))))
+        {
+            visible.push_back(GetEntityId(entity));
+        }
+    });
+
+    std::ranges::sort(visible);
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "physics/spatial_grid.h"
+
+#include <common/networking/snapshot.h>
+
+#include <common/utils/uuid.h>
+
+#include <cstdint>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \brief The distance from a client's player within which entities become relevant to it.
+ */
+constexpr float INTEREST_ENTER_RADIUS = 400.0f;
+
+/**
+ * \brief The distance from a client's player beyond which relevant entities stop being
+ * relevant to it. This is larger than the enter radius, so that an entity moving along the
+ * edge of a client's region does not repeatedly enter and leave it.
+ */
+constexpr float INTEREST_LEAVE_RADIUS = 480.0f;
+
+/**
+ * \brief A data structure to determine which entities are relevant to each client of a room.
+ * Its static functions act on the interest manager of the calling thread's current room.
+ *
+ * Each client has a region of interest around its player, and is only sent the state of the
+ * players and projectiles within it. When a player enters or leaves a client's region, the
+ * client is told to spawn or despawn it.
+ */
+class InterestManager
+{
+public:
+    InterestManager(const InterestManager&) = delete;
+    InterestManager& operator=(const InterestManager&) = delete;
+
+    InterestManager(InterestManager&&) noexcept = delete;
+    InterestManager& operator=(InterestManager&&) noexcept = delete;
+
+    /**
+     * \brief Determines the entities which are relevant to each client, sending spawn and
+     * despawn messages for the players which entered or left a client's region. Must be
+     * called from the thread which updates the game.
+     * \param world A snapshot of every entity in the world.
+     */
+    static void Update(const WorldSnapshot& world);
+
+    /**
+     * \brief Gets the part of the world which is relevant to a client, as determined by the
+     * last update.
+     * \param client_id The identifier of the client.
+     * \param world The snapshot of the world which was used by the last update.
+     * \return The client's own player and the entities within its region.
+     */
+    static WorldSnapshot GetView(unsigned int client_id, const WorldSnapshot& world);
+
+    /**
+     * \brief Gets the clients whose region contains a player. May be called from any thread
+     * whose current room is the room of the player.
+     * \param player_id The identifier of the player.
+     * \return The identifiers of the clients.
+     */
+    static std::vector<unsigned int> GetPlayerViewers(unsigned int player_id);
+
+    /**
+     * \brief Gets the clients whose region contains a projectile, as determined by the last
+     * update. Projectiles are only destroyed while the game updates, so this is found from each
+     * client's region rather than kept for every projectile, and must be called from the thread
+     * which updates the game.
+     * \param projectile_id The identifier of the projectile.
+     * \return The identifiers of the clients.
+     */
+    static std::vector<unsigned int> GetProjectileViewers(UUID projectile_id);
+
+    /**
+     * \brief Forgets the region of a client which has disconnected.
+     * \param client_id The identifier of the client.
+     */
+    static void RemoveClient(unsigned int client_id);
+
+private:
+    /**
+     * \brief The entities which are relevant to a client, each sorted by identifier.
+     */
+    struct ClientInterest
+    {
+        std::vector<unsigned int> visible_players;
+        std::vector<uint64_t> visible_projectiles;
+    };
+
+    SpatialGrid m_player_grid;
+    SpatialGrid m_projectile_grid;
+
+    /**
+     * \brief The entities relevant to each client. Only accessed by the thread which updates
+     * the game.
+     */
+    std::unordered_map<unsigned int, ClientInterest> m_clients;
+
+    /**
+     * \brief The clients each player is relevant to, rebuilt by every update so that packets
+     * about a player can be sent only to those clients.
+     */
+    std::unordered_map<unsigned int, std::vector<unsigned int>> m_player_viewers;
+    std::shared_mutex m_viewers_guard;
+
+    InterestManager();
+    ~InterestManager() = default;
+
+    static InterestManager& Get();
+
+    /**
+     * \brief Finds the entities which are within a region, keeping those which were already
+     * visible until they pass the leave radius.
+     * \param grid The grid holding the indices of the entities.
+     * \param entities The entities the grid was built from.
+     * \param centre The centre of the region.
+     * \param previous The sorted identifiers of the entities which were visible.
+     * \param visible Filled with the sorted identifiers of the entities which are now visible.
+     */
+    template <typename T, typename Id>
+    static void FindVisible(const SpatialGrid& grid, const std::vector<T>& entities, glm::vec2 centre,
+                            const std::vector<Id>& previous, std::vector<Id>& visible);
+
+    friend class Room;
+};
@@ -1,8 +1,16 @@
 #include "server.h"
 
+#include <algorithm>
+#include <climits>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 
+constexpr const char* USAGE =
+    "Invalid command line arguments. Usage: ./server -port [port] -tick-rate [tick rate] [-workers [count]] "
+    "[-tick-spin [microseconds]] [-rooms [count]] [-room-threads [count]] [-profile-interval [seconds]] "
+    "[-metrics-path [path]] [-metrics-interval [seconds]]\n";
+
 bool FindCommandOption(char* begin[], char* end[], const std::string& option, std::string& value)
 {
     auto it = std::find(begin, end, option);
@@ -14,6 +22,53 @@ bool FindCommandOption(char* begin[], char* end[], const std::string& option, st
     return true;
 }
 
+/**
+ * \brief Parses the whole of a command line value as an integer within a range.
+ * \param text The command line value.
+ * \param min The smallest value which is accepted.
+ * \param max The largest value which is accepted.
+ * \param value Receives the parsed value if it is valid.
+ * \return A true or false value indicating whether the value is an integer within the range.
+ */
+bool ParseInteger(const std::string& text, const int min, const int max, int& value)
+{
+    int parsed;
+    size_t length = 0;
+
+    try
+    {
+        parsed = std::stoi(text, &length);
+    }
+    catch (const std::logic_error&)
+    {
+        // Thrown as std::invalid_argument if the value is not a number, or std::out_of_range if it is too large.
+        return false;
+    }
+
+    if (length != text.size() || parsed < min || parsed > max)
+        return false;
+
+    value = parsed;
+    return true;
+}
+
+/**
+ * \brief Parses an integer option if it has been specified, leaving the value unchanged otherwise.
+ * \return A true or false value indicating whether the option is either not specified or valid.
+ */
+bool FindIntegerOption(char* begin[], char* end[], const std::string& option, const int min, int& value)
+{
+    std::string value_string;
+    if (!FindCommandOption(begin, end, option, value_string))
+        return true;
+
+    if (ParseInteger(value_string, min, INT_MAX, value))
+        return true;
+
+    std::cerr << "Invalid value '" << value_string << "' for " << option << ".\n";
+    return false;
+}
+
 bool ParseArguments(const int argc, char* argv[], ServerSettings& settings)
 {
     std::string port_string;
@@ -24,8 +79,54 @@ bool ParseArguments(const int argc, char* argv[], ServerSettings& settings)
     if (!FindCommandOption(argv + 1, argv + argc, "-tick-rate", tick_rate_string))
         return false;
 
-    settings.port = static_cast<uint16_t>(std::stoi(port_string));
-    settings.tick_rate = std::stoi(tick_rate_string);
+    int port;
+    int tick_rate;
+
+    if (!ParseInteger(port_string, 1, UINT16_MAX, port) || !ParseInteger(tick_rate_string, 1, INT_MAX, tick_rate))
+        return false;
+
+    settings.port = static_cast<uint16_t>(port);
+    settings.tick_rate = tick_rate;
+
+    return true;
+}
+
+bool ParseOptionalArguments(const int argc, char* argv[], ServerSettings& settings)
+{
+    // If the number of worker threads is not specified, the thread pool uses one per hardware thread.
+    int workers = static_cast<int>(settings.worker_threads);
+    if (!FindIntegerOption(argv + 1, argv + argc, "-workers", 1, workers))
+        return false;
+    settings.worker_threads = static_cast<unsigned int>(workers);
+
+    // If the tick spin is not specified, the server sleeps until each tick is due without spinning.
+    int tick_spin = static_cast<int>(settings.tick_spin.count());
+    if (!FindIntegerOption(argv + 1, argv + argc, "-tick-spin", 0, tick_spin))
+        return false;
+    settings.tick_spin = std::chrono::microseconds{ tick_spin };
+
+    // If the number of rooms or room threads is not specified, a single room is updated by a single thread.
+    int rooms = static_cast<int>(settings.rooms);
+    int room_threads = static_cast<int>(settings.room_threads);
+    if (!FindIntegerOption(argv + 1, argv + argc, "-rooms", 1, rooms) ||
+        !FindIntegerOption(argv + 1, argv + argc, "-room-threads", 1, room_threads))
+        return false;
+    settings.rooms = static_cast<unsigned int>(rooms);
+    settings.room_threads = static_cast<unsigned int>(room_threads);
+
+    // If the profile interval is not specified, the tick profile and traffic are logged every 30 seconds.
+    int profile_interval = 30;
+    if (!FindIntegerOption(argv + 1, argv + argc, "-profile-interval", 0, profile_interval))
+        return false;
+    settings.profile_interval = std::chrono::seconds{ profile_interval };
+
+    // If the metrics path is not specified, no metrics are exported. Otherwise, they are written every 15 seconds
+    // unless an interval is given.
+    FindCommandOption(argv + 1, argv + argc, "-metrics-path", settings.metrics_path);
+    int metrics_interval = 15;
+    if (!FindIntegerOption(argv + 1, argv + argc, "-metrics-interval", 0, metrics_interval))
+        return false;
+    settings.metrics_interval = std::chrono::seconds{ metrics_interval };
 
     return true;
 }
@@ -36,14 +137,21 @@ int main(const int argc, char* argv[])
 
     if (!ParseArguments(argc, argv, server_settings))
     {
-        std::cerr <<
-            "Invalid command line arguments. Usage: ./server -port [port] -tick-rate [tick rate]\n";
+        std::cerr << USAGE;
 
         // If invalid command line arguments have been passed to the program, just use default settings.
         server_settings.port = 27565;
         server_settings.tick_rate = 60;
     }
 
+    // Unlike the port and tick rate, there is no sensible fallback for an optional argument which was given but is
+    // invalid, such as a negative number of rooms, so the server does not start.
+    if (!ParseOptionalArguments(argc, argv, server_settings))
+    {
+        std::cerr << USAGE;
+        return 1;
+    }
+
     Server server{ server_settings };
     server.Run();
 
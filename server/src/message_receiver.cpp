@@ -0,0 +1,59 @@
+#include "message_receiver.h"
+
+#include <common/networking/packet_stats.h>
+
+#include <common/utils/logging.h>
+
+#include <algorithm>
+
+MessageReceiver::MessageReceiver(const int batch_size)
+    : m_batch_size{ batch_size },
+      m_incoming_messages(batch_size),
+      m_received_packets(batch_size),
+      m_decoded{ 0 }
+{
+}
+
+int MessageReceiver::ReceiveBatch(ISteamNetworkingSockets* p_sockets, const HSteamNetPollGroup poll_group)
+{
+    m_decoded = 0;
+
+    const int num_msgs = p_sockets->ReceiveMessagesOnPollGroup(poll_group, m_incoming_messages.data(), m_batch_size);
+    if (num_msgs < 0)
+    {
+        SCX_CORE_ERROR("An error occurred when checking for messages.");
+        return -1;
+    }
+
+    const std::span messages{ m_incoming_messages.data(), static_cast<size_t>(num_msgs) };
+
+    // Group the messages by connection. Message numbers increase with each message sent on a
+    // connection, so sorting by them keeps the packets of each client in order.
+    std::ranges::sort(messages, [](const SteamNetworkingMessage_t* a, const SteamNetworkingMessage_t* b)
+    {
+        return a->m_conn != b->m_conn ? a->m_conn < b->m_conn : a->m_nMessageNumber < b->m_nMessageNumber;
+    });
+
+    for (SteamNetworkingMessage_t* p_incoming_message : messages)
+    {
+        PacketInfoFromClient& packet_info = m_received_packets[m_decoded];
+
+        if (packet_info.packet.Decode(p_incoming_message->m_pData, p_incoming_message->m_cbSize) !=
+            PacketCode_Success)
+        {
+            SCX_CORE_WARN("Dropping malformed packet of {0} bytes from client {1}.", p_incoming_message->m_cbSize,
+                          p_incoming_message->m_conn);
+        }
+        else
+        {
+            PacketStats::RecordReceived(packet_info.packet.GetType(), p_incoming_message->m_cbSize);
+
+            packet_info.from_client = p_incoming_message->m_conn;
+            m_decoded++;
+        }
+
+        p_incoming_message->Release();
+    }
+
+    return num_msgs;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <common/networking/packet.h>
+
+#include <steam/isteamnetworkingsockets.h>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/**
+ * \brief The maximum number of messages received from the poll group in a single call.
+ */
+constexpr int RECEIVE_BATCH_SIZE = 256;
+
+/**
+ * \brief Receives the messages waiting on a poll group in batches, and decodes them into the
+ * packets of each connection.
+ *
+ * Each batch is grouped by connection, so that the packets of a connection can be handed on in
+ * a single push rather than one at a time. The storage for a batch is allocated once and reused
+ * by every poll.
+ */
+class MessageReceiver
+{
+public:
+    /**
+     * \brief Creates a receiver.
+     * \param batch_size The maximum number of messages received in a single call.
+     */
+    explicit MessageReceiver(int batch_size = RECEIVE_BATCH_SIZE);
+    ~MessageReceiver() = default;
+
+    MessageReceiver(const MessageReceiver&) = delete;
+    MessageReceiver& operator=(const MessageReceiver&) = delete;
+
+    MessageReceiver(MessageReceiver&&) noexcept = default;
+    MessageReceiver& operator=(MessageReceiver&&) noexcept = default;
+
+    /**
+     * \brief Receives every message waiting on a poll group. Malformed messages are dropped.
+     * \param p_sockets The interface the poll group belongs to.
+     * \param poll_group The poll group to receive from.
+     * \param enqueue Called with the connection and the decoded packets of each connection in
+     * each batch, in the order they were sent. The packets may be moved from.
+     */
+    template <typename F>
+    void Receive(ISteamNetworkingSockets* p_sockets, const HSteamNetPollGroup poll_group, F&& enqueue)
+    {
+        while (true)
+        {
+            const int num_msgs = ReceiveBatch(p_sockets, poll_group);
+            if (num_msgs <= 0)
+                break;
+
+            size_t first = 0;
+            while (first < m_decoded)
+            {
+                const unsigned int conn = m_received_packets[first].from_client;
+
+                size_t last = first + 1;
+                while (last < m_decoded && m_received_packets[last].from_client == conn)
+                    last++;
+
+                enqueue(static_cast<HSteamNetConnection>(conn),
+                        std::span{ m_received_packets.data() + first, last - first });
+
+                first = last;
+            }
+
+            // A partial batch means the poll group has been drained.
+            if (num_msgs < m_batch_size)
+                break;
+        }
+    }
+
+private:
+    int m_batch_size;
+    std::vector<SteamNetworkingMessage_t*> m_incoming_messages;
+    std::vector<PacketInfoFromClient> m_received_packets;
+
+    /**
+     * \brief The number of packets decoded from the last batch.
+     */
+    size_t m_decoded;
+
+    /**
+     * \brief Receives a batch of messages, decoding them into packets which are grouped by
+     * connection and kept in the order each connection sent them.
+     * \return The number of messages received, or -1 if the poll group could not be read.
+     */
+    int ReceiveBatch(ISteamNetworkingSockets* p_sockets, HSteamNetPollGroup poll_group);
+};
@@ -0,0 +1,272 @@
+#include "metrics_exporter.h"
+
+#include "room_manager.h"
+#include "thread_pool.h"
+#include "tick_profiler.h"
+
+#include <common/networking/packet_stats.h>
+
+#include <common/utils/logging.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+MetricsExporter MetricsExporter::s_instance;
+
+/**
+ * \brief Writes the help and type lines which precede the samples of a metric.
+ */
+static void WriteMetricHeader(std::ostream& out, const char* name, const char* type, const char* help)
+{
+    out << "# HELP " << name << ' ' << help << '\n';
+    out << "# TYPE " << name << ' ' << type << '\n';
+}
+
+/**
+ * \brief Writes the duration of each phase of a tick as a histogram. Only the buckets which end
+ * an octave are written, as their bounds are powers of two which every scrape shares, and the
+ * last bucket is left to the +Inf bucket, as it also holds every longer duration.
+ */
+static void WriteTickProfile(std::ostream& out, const TickProfile& profile)
+{
+    WriteMetricHeader(out, "scx_tick_phase_seconds", "histogram", "How long each phase of the server's loops took.");
+
+    for (size_t phase = 0; phase < TICK_PHASE_COUNT; phase++)
+    {
+        const DurationHistogram& histogram = profile.phases[phase];
+        const char* name = GetTickPhaseName(static_cast<TickPhase>(phase));
+
+        uint64_t cumulative = 0;
+
+        for (size_t i = 0; i < DURATION_BUCKET_COUNT; i++)
+        {
+            cumulative += histogram.counts[i];
+
+            if (i % DURATION_SUB_BUCKETS != 0 || i + 1 == DURATION_BUCKET_COUNT)
+                continue;
+
+            out << "scx_tick_phase_seconds_bucket{phase=\"" << name << "\",le=\""
+                << static_cast<double>(DurationHistogram::GetBucketUpperBound(i)) / 1e9 << "\"} " << cumulative
+                << '\n';
+        }
+
+        // The count is taken from the buckets, as the two may briefly disagree while durations
+        // are being recorded, and the +Inf bucket must hold every other.
+        out << "scx_tick_phase_seconds_bucket{phase=\"" << name << "\",le=\"+Inf\"} " << cumulative << '\n';
+        out << "scx_tick_phase_seconds_sum{phase=\"" << name << "\"} "
+            << static_cast<double>(histogram.total_ns) / 1e9 << '\n';
+        out << "scx_tick_phase_seconds_count{phase=\"" << name << "\"} " << cumulative << '\n';
+    }
+}
+
+/**
+ * \brief Writes the traffic and handler time of each packet type as counters.
+ */
+static void WritePacketStats(std::ostream& out, const PacketStatsSnapshot& snapshot)
+{
+    const auto write_counter = [&out, &snapshot](const char* name, const char* help, auto get)
+    {
+        WriteMetricHeader(out, name, "counter", help);
+
+        for (size_t i = 0; i < PACKET_TYPE_COUNT; i++)
+        {
+            out << name << "{type=\"" << GetPacketTypeName(static_cast<PacketType>(i)) << "\"} "
+                << get(snapshot.types[i]) << '\n';
+        }
+    };
+
+    write_counter("scx_packets_sent_total", "The packets sent to clients.",
+                  [](const PacketTypeStats& stats) { return stats.messages_sent; });
+    write_counter("scx_packet_bytes_sent_total", "The encoded bytes of the packets sent to clients.",
+                  [](const PacketTypeStats& stats) { return stats.bytes_sent; });
+    write_counter("scx_packets_received_total", "The packets received from clients.",
+                  [](const PacketTypeStats& stats) { return stats.messages_received; });
+    write_counter("scx_packet_bytes_received_total", "The encoded bytes of the packets received from clients.",
+                  [](const PacketTypeStats& stats) { return stats.bytes_received; });
+    write_counter("scx_packets_handled_total", "The packets handled by the workers.",
+                  [](const PacketTypeStats& stats) { return stats.handled; });
+    write_counter("scx_packet_handler_seconds_total", "The time spent handling packets.",
+                  [](const PacketTypeStats& stats) { return static_cast<double>(stats.handle_ns) / 1e9; });
+}
+
+/**
+ * \brief Writes the clients, projectiles and tick time of each room as gauges.
+ */
+static void WriteRoomStats(std::ostream& out, const std::vector<RoomStats>& rooms)
+{
+    WriteMetricHeader(out, "scx_room_clients", "gauge", "The clients assigned to each room.");
+    for (const RoomStats& room : rooms)
+        out << "scx_room_clients{room=\"" << room.id << "\"} " << room.clients << '\n';
+
+    WriteMetricHeader(out, "scx_room_projectiles", "gauge", "The projectiles alive in each room.");
+    for (const RoomStats& room : rooms)
+        out << "scx_room_projectiles{room=\"" << room.id << "\"} " << room.projectiles << '\n';
+
+    WriteMetricHeader(out, "scx_room_parked", "gauge", "Whether each room is parked.");
+    for (const RoomStats& room : rooms)
+        out << "scx_room_parked{room=\"" << room.id << "\"} " << (room.is_parked ? 1 : 0) << '\n';
+
+    WriteMetricHeader(out, "scx_room_tick_seconds", "gauge", "A moving average of how long each room's updates take.");
+    for (const RoomStats& room : rooms)
+    {
+        out << "scx_room_tick_seconds{room=\"" << room.id << "\",thread=\"" << room.tick_thread << "\"} "
+            << std::chrono::duration<double>(room.average_tick_time).count() << '\n';
+    }
+}
+
+/**
+ * \brief Writes the run queue depth of each worker as gauges.
+ */
+static void WriteWorkerStats(std::ostream& out, const std::vector<WorkerStats>& workers)
+{
+    WriteMetricHeader(out, "scx_worker_run_queue_depth", "gauge", "The strands waiting on each worker's run queue.");
+    for (const WorkerStats& worker : workers)
+        out << "scx_worker_run_queue_depth{worker=\"" << worker.id << "\"} " << worker.run_queue_depth << '\n';
+
+    WriteMetricHeader(out, "scx_worker_parked", "gauge", "Whether each worker is parked waiting for work.");
+    for (const WorkerStats& worker : workers)
+        out << "scx_worker_parked{worker=\"" << worker.id << "\"} " << (worker.is_parked ? 1 : 0) << '\n';
+}
+
+/**
+ * \brief Writes the number of connected clients, and the quality of each client's connection
+ * as gauges.
+ */
+static void WriteConnectionStats(std::ostream& out, const std::span<const ConnectionStats> connections)
+{
+    WriteMetricHeader(out, "scx_connected_clients", "gauge", "The clients connected to the server.");
+    out << "scx_connected_clients " << connections.size() << '\n';
+
+    WriteMetricHeader(out, "scx_connection_ping_seconds", "gauge", "The round-trip time to each client.");
+    for (const ConnectionStats& connection : connections)
+    {
+        out << "scx_connection_ping_seconds{connection=\"" << connection.connection << "\"} "
+            << static_cast<double>(connection.ping) / 1e3 << '\n';
+    }
+
+    WriteMetricHeader(out, "scx_connection_quality", "gauge",
+                      "The fraction of packets delivered to each end of each connection, or negative if unknown.");
+    for (const ConnectionStats& connection : connections)
+    {
+        out << "scx_connection_quality{connection=\"" << connection.connection << "\",end=\"local\"} "
+            << connection.quality_local << '\n';
+        out << "scx_connection_quality{connection=\"" << connection.connection << "\",end=\"remote\"} "
+            << connection.quality_remote << '\n';
+    }
+
+    WriteMetricHeader(out, "scx_connection_bytes_per_second", "gauge", "The throughput of each connection.");
+    for (const ConnectionStats& connection : connections)
+    {
+        out << "scx_connection_bytes_per_second{connection=\"" << connection.connection << "\",direction=\"out\"} "
+            << connection.out_bytes_per_sec << '\n';
+        out << "scx_connection_bytes_per_second{connection=\"" << connection.connection << "\",direction=\"in\"} "
+            << connection.in_bytes_per_sec << '\n';
+    }
+
+    WriteMetricHeader(out, "scx_connection_pending_bytes", "gauge", "The bytes queued to be sent on each connection.");
+    for (const ConnectionStats& connection : connections)
+    {
+        out << "scx_connection_pending_bytes{connection=\"" << connection.connection << "\",delivery=\"reliable\"} "
+            << connection.pending_reliable << '\n';
+        out << "scx_connection_pending_bytes{connection=\"" << connection.connection << "\",delivery=\"unreliable\"} "
+            << connection.pending_unreliable << '\n';
+    }
+}
+
+MetricsExporter::MetricsExporter()
+    : m_p_server{ nullptr },
+      m_interval{ 0 },
+      m_is_running{ false }
+{
+}
+
+void MetricsExporter::Initialise(const Server& server, std::filesystem::path path,
+                                 const std::chrono::seconds interval)
+{
+    Get().m_p_server = &server;
+    Get().m_path = std::move(path);
+    Get().m_interval = std::max(interval, std::chrono::seconds{ 1 });
+    Get().m_is_running = true;
+    Get().m_thread = std::thread{ Run };
+
+    SCX_CORE_INFO("Writing metrics to {0} every {1} seconds.", Get().m_path.string(), Get().m_interval.count());
+}
+
+void MetricsExporter::Dispose()
+{
+    if (!Get().m_thread.joinable())
+        return;
+
+    {
+        std::scoped_lock running_lock{ Get().m_running_guard };
+        Get().m_is_running = false;
+    }
+
+    Get().m_stopped.notify_all();
+    Get().m_thread.join();
+
+    Get().m_p_server = nullptr;
+}
+
+std::string MetricsExporter::Render(const std::span<const ConnectionStats> connections)
+{
+    std::ostringstream out;
+    out.precision(12);
+
+    WriteTickProfile(out, TickProfiler::GetProfile());
+    WritePacketStats(out, PacketStats::GetSnapshot());
+    WriteRoomStats(out, RoomManager::GetRoomStats());
+    WriteWorkerStats(out, ThreadPool::GetWorkerStats());
+    WriteConnectionStats(out, connections);
+
+    return out.str();
+}
+
+MetricsExporter& MetricsExporter::Get()
+{
+    return s_instance;
+}
+
+void MetricsExporter::Run()
+{
+    std::unique_lock running_lock{ Get().m_running_guard };
+
+    while (Get().m_is_running)
+    {
+        running_lock.unlock();
+        Write();
+        running_lock.lock();
+
+        Get().m_stopped.wait_for(running_lock, Get().m_interval, [] { return !Get().m_is_running; });
+    }
+}
+
+void MetricsExporter::Write()
+{
+    const std::filesystem::path& path = Get().m_path;
+    std::filesystem::path temporary_path = path;
+    temporary_path += ".tmp";
+
+    {
+        std::ofstream file{ temporary_path, std::ios::trunc };
+        file << Render(Get().m_p_server->GetConnectionStats());
+
+        if (!file)
+        {
+            SCX_CORE_WARN("Failed to write metrics to {0}.", temporary_path.string());
+            return;
+        }
+    }
+
+    // Renaming replaces the last file in a single step, so the collector never reads a file
+    // which is only partly written.
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+
+    if (error)
+        SCX_CORE_WARN("Failed to replace {0}: {1}", path.string(), error.message());
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "server.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+
+/**
+ * \brief A data structure implemented as a singleton pattern to export the server's metrics in
+ * the Prometheus text format.
+ *
+ * The metrics are written to a file at a fixed interval by a thread of their own, to be picked
+ * up by the textfile collector of a node exporter. Each file is written in full before it
+ * replaces the last one, so a scrape never sees a partial file. The metrics are read from the
+ * counters and snapshots which the tick threads, workers and network thread publish for any
+ * thread to read, so exporting never stalls a tick.
+ */
+class MetricsExporter
+{
+public:
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    MetricsExporter(MetricsExporter&&) noexcept = delete;
+    MetricsExporter& operator=(MetricsExporter&&) noexcept = delete;
+
+    /**
+     * \brief Starts the thread which writes the metrics.
+     * \param server The server whose connections are exported, which must outlive the exporter.
+     * \param path The file the metrics are written to, which should have the \code .prom\endcode
+     * extension to be picked up by the textfile collector.
+     * \param interval How often the metrics are written.
+     */
+    static void Initialise(const Server& server, std::filesystem::path path, std::chrono::seconds interval);
+
+    /**
+     * \brief Stops the thread which writes the metrics, if it was started.
+     */
+    static void Dispose();
+
+    /**
+     * \brief Collects the server's metrics. May be called from any thread.
+     * \param connections The quality of the connections to export.
+     * \return The metrics in the Prometheus text format.
+     */
+    static std::string Render(std::span<const ConnectionStats> connections);
+
+private:
+    const Server* m_p_server;
+    std::thread m_thread;
+    std::filesystem::path m_path;
+    std::chrono::seconds m_interval;
+
+    bool m_is_running;
+    std::mutex m_running_guard;
+    std::condition_variable m_stopped;
+
+    MetricsExporter();
+    ~MetricsExporter() = default;
+
+    static MetricsExporter s_instance;
+    static MetricsExporter& Get();
+
+    /**
+     * \brief The function run by the exporter's thread, which writes the metrics at each
+     * interval until the exporter is stopped.
+     */
+    static void Run();
+
+    /**
+     * \brief Writes the metrics to a temporary file, then moves it over the last one.
+     */
+    static void Write();
+};
@@ -0,0 +1,307 @@
+#include "batch_kernels.h"
+
+#include <common/utils/assertion.h>
+
+#include <cmath>
+#include <limits>
+
+#if defined(SCX_BATCH_AVX2)
+#include <immintrin.h>
+#elif defined(SCX_BATCH_SSE2)
+#include <emmintrin.h>
+#endif
+
+static_assert(sizeof(glm::vec2) == 2 * sizeof(float), "The kernels treat arrays of vectors as arrays of floats.");
+
+// Coefficients of the polynomial which approximates atan(a) / a for a within [0, 1].
+constexpr float ATAN_C0 = 0.99997726f,
+                ATAN_C1 = -0.33262347f,
+                ATAN_C2 = 0.19354346f,
+                ATAN_C3 = -0.11643287f,
+                ATAN_C4 = 0.05265332f,
+                ATAN_C5 = -0.01172120f;
+constexpr float HALF_PI = 1.57079637f,
+                PI = 3.14159274f;
+
+void Batch::BoxSet::Clear()
+{
+    m_min_x.clear();
+    m_min_y.clear();
+    m_max_x.clear();
+    m_max_y.clear();
+    m_size = 0;
+}
+
+void Batch::BoxSet::Add(const Box& box)
+{
+    // Start a new batch of padding boxes when the last batch is full. The padding boxes are
+    // empty and infinitely far away, so they never overlap anything.
+    if (m_size == m_min_x.size())
+    {
+        constexpr float infinity = std::numeric_limits<float>::infinity();
+
+        m_min_x.resize(m_size + BOX_BATCH_WIDTH, infinity);
+        m_min_y.resize(m_size + BOX_BATCH_WIDTH, infinity);
+        m_max_x.resize(m_size + BOX_BATCH_WIDTH, -infinity);
+        m_max_y.resize(m_size + BOX_BATCH_WIDTH, -infinity);
+    }
+
+    m_min_x[m_size] = box.min.x;
+    m_min_y[m_size] = box.min.y;
+    m_max_x[m_size] = box.max.x;
+    m_max_y[m_size] = box.max.y;
+    m_size++;
+}
+
+size_t Batch::BoxSet::GetSize() const
+{
+    return m_size;
+}
+
+size_t Batch::BoxSet::GetPaddedSize() const
+{
+    return m_min_x.size();
+}
+
+const float* Batch::BoxSet::GetMinX() const
+{
+    return m_min_x.data();
+}
+
+const float* Batch::BoxSet::GetMinY() const
+{
+    return m_min_y.data();
+}
+
+const float* Batch::BoxSet::GetMaxX() const
+{
+    return m_max_x.data();
+}
+
+const float* Batch::BoxSet::GetMaxY() const
+{
+    return m_max_y.data();
+}
+
+uint32_t Batch::OverlapMask(const Box& box, const BoxSet& boxes, const size_t first)
+{
+    SCX_ASSERT(first % BOX_BATCH_WIDTH == 0 && first < boxes.GetPaddedSize(), "The batch is out of range.");
+
+#if defined(SCX_BATCH_AVX2)
+    const __m256 overlap_x = _mm256_and_ps(
+        _mm256_cmp_ps(_mm256_set1_ps(box.min.x), _mm256_loadu_ps(boxes.GetMaxX() + first), _CMP_LT_OQ),
+        _mm256_cmp_ps(_mm256_set1_ps(box.max.x), _mm256_loadu_ps(boxes.GetMinX() + first), _CMP_GT_OQ));
+    const __m256 overlap_y = _mm256_and_ps(
+        _mm256_cmp_ps(_mm256_set1_ps(box.min.y), _mm256_loadu_ps(boxes.GetMaxY() + first), _CMP_LT_OQ),
+        _mm256_cmp_ps(_mm256_set1_ps(box.max.y), _mm256_loadu_ps(boxes.GetMinY() + first), _CMP_GT_OQ));
+
+    return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_and_ps(overlap_x, overlap_y)));
+#elif defined(SCX_BATCH_SSE2)
+    const __m128 min_x = _mm_set1_ps(box.min.x), min_y = _mm_set1_ps(box.min.y);
+    const __m128 max_x = _mm_set1_ps(box.max.x), max_y = _mm_set1_ps(box.max.y);
+
+    uint32_t mask = 0;
+
+    // Test the batch as two halves of four boxes.
+    for (size_t half = 0; half < BOX_BATCH_WIDTH; half += 4)
+    {
+        const size_t i = first + half;
+
+        const __m128 overlap_x = _mm_and_ps(_mm_cmplt_ps(min_x, _mm_loadu_ps(boxes.GetMaxX() + i)),
+                                            _mm_cmpgt_ps(max_x, _mm_loadu_ps(boxes.GetMinX() + i)));
+        const __m128 overlap_y = _mm_and_ps(_mm_cmplt_ps(min_y, _mm_loadu_ps(boxes.GetMaxY() + i)),
+                                            _mm_cmpgt_ps(max_y, _mm_loadu_ps(boxes.GetMinY() + i)));
+
+        mask |= static_cast<uint32_t>(_mm_movemask_ps(_mm_and_ps(overlap_x, overlap_y))) << half;
+    }
+
+    return mask;
+#else
+    return OverlapMaskScalar(box, boxes, first);
+#endif
+}
+
+uint32_t Batch::OverlapMaskScalar(const Box& box, const BoxSet& boxes, const size_t first)
+{
+    uint32_t mask = 0;
+
+    for (size_t i = 0; i < BOX_BATCH_WIDTH; i++)
+    {
+        const size_t index = first + i;
+        const Box other{
+            { boxes.GetMinX()[index], boxes.GetMinY()[index] }, { boxes.GetMaxX()[index], boxes.GetMaxY()[index] }
+        };
+
+        if (Overlaps(box, other))
+            mask |= 1u << i;
+    }
+
+    return mask;
+}
+
+#if defined(SCX_BATCH_AVX2) || defined(SCX_BATCH_SSE2)
+/**
+ * \brief Chooses between the lanes of two vectors, taking each lane from \code a\endcode
+ * where the mask is set and from \code b\endcode elsewhere.
+ */
+static __m128 Select(const __m128 mask, const __m128 a, const __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+/**
+ * \brief Approximates the angle of four vectors in the same way as \code Batch::Atan2\endcode.
+ */
+static __m128 Atan2Vector(const __m128 y, const __m128 x)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 sign_mask = _mm_set1_ps(-0.0f);
+
+    const __m128 abs_x = _mm_andnot_ps(sign_mask, x);
+    const __m128 abs_y = _mm_andnot_ps(sign_mask, y);
+
+    const __m128 min = _mm_min_ps(abs_x, abs_y);
+    const __m128 max = _mm_max_ps(abs_x, abs_y);
+
+    // The ratio of a zero vector is taken to be zero, rather than the result of dividing by zero.
+    const __m128 a = _mm_and_ps(_mm_div_ps(min, max), _mm_cmpneq_ps(max, zero));
+    const __m128 s = _mm_mul_ps(a, a);
+
+    __m128 p = _mm_set1_ps(ATAN_C5);
+    p = _mm_add_ps(_mm_mul_ps(p, s), _mm_set1_ps(ATAN_C4));
+    p = _mm_add_ps(_mm_mul_ps(p, s), _mm_set1_ps(ATAN_C3));
+    p = _mm_add_ps(_mm_mul_ps(p, s), _mm_set1_ps(ATAN_C2));
+    p = _mm_add_ps(_mm_mul_ps(p, s), _mm_set1_ps(ATAN_C1));
+    p = _mm_add_ps(_mm_mul_ps(p, s), _mm_set1_ps(ATAN_C0));
+
+    __m128 r = _mm_mul_ps(p, a);
+    r = Select(_mm_cmpgt_ps(abs_y, abs_x), _mm_sub_ps(_mm_set1_ps(HALF_PI), r), r);
+    r = Select(_mm_cmplt_ps(x, zero), _mm_sub_ps(_mm_set1_ps(PI), r), r);
+    r = Select(_mm_cmplt_ps(y, zero), _mm_sub_ps(zero, r), r);
+
+    return r;
+}
+#endif
+
+void Batch::IntegrateProjectiles(const std::span<glm::vec2> positions, const std::span<glm::vec2> velocities,
+                                 const std::span<float> rotations, const float dt, const float gravity)
+{
+    SCX_ASSERT(positions.size() == velocities.size() && positions.size() == rotations.size(),
+               "Each projectile must have a position, velocity and rotation.");
+
+    const size_t count = positions.size();
+    const float gravity_step = gravity * dt;
+
+    auto* p_positions = reinterpret_cast<float*>(positions.data());
+    auto* p_velocities = reinterpret_cast<float*>(velocities.data());
+
+    size_t i = 0;
+
+#if defined(SCX_BATCH_AVX2)
+    // Each vector holds the interleaved components of four projectiles.
+    const __m256 dt_vector = _mm256_set1_ps(dt);
+    const __m256 gravity_vector = _mm256_setr_ps(0.0f, gravity_step, 0.0f, gravity_step,
+                                                 0.0f, gravity_step, 0.0f, gravity_step);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256 velocity = _mm256_loadu_ps(p_velocities + i * 2);
+        const __m256 position = _mm256_loadu_ps(p_positions + i * 2);
+
+        _mm256_storeu_ps(p_positions + i * 2, _mm256_add_ps(position, _mm256_mul_ps(velocity, dt_vector)));
+        _mm256_storeu_ps(p_velocities + i * 2, _mm256_sub_ps(velocity, gravity_vector));
+    }
+#elif defined(SCX_BATCH_SSE2)
+    // Each vector holds the interleaved components of two projectiles.
+    const __m128 dt_vector = _mm_set1_ps(dt);
+    const __m128 gravity_vector = _mm_setr_ps(0.0f, gravity_step, 0.0f, gravity_step);
+
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128 velocity = _mm_loadu_ps(p_velocities + i * 2);
+        const __m128 position = _mm_loadu_ps(p_positions + i * 2);
+
+        _mm_storeu_ps(p_positions + i * 2, _mm_add_ps(position, _mm_mul_ps(velocity, dt_vector)));
+        _mm_storeu_ps(p_velocities + i * 2, _mm_sub_ps(velocity, gravity_vector));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        positions[i] += velocities[i] * dt;
+        velocities[i].y -= gravity_step;
+    }
+
+    i = 0;
+
+#if defined(SCX_BATCH_AVX2) || defined(SCX_BATCH_SSE2)
+    for (; i + 4 <= count; i += 4)
+    {
+        // Separate the components of four velocities.
+        const __m128 first = _mm_loadu_ps(p_velocities + i * 2);
+        const __m128 second = _mm_loadu_ps(p_velocities + i * 2 + 4);
+
+        const __m128 x = _mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 y = _mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1));
+
+        _mm_storeu_ps(rotations.data() + i, Atan2Vector(y, x));
+    }
+#endif
+
+    for (; i < count; i++)
+        rotations[i] = Atan2(velocities[i].y, velocities[i].x);
+}
+
+void Batch::IntegrateProjectilesScalar(const std::span<glm::vec2> positions, const std::span<glm::vec2> velocities,
+                                       const std::span<float> rotations, const float dt, const float gravity)
+{
+    const float gravity_step = gravity * dt;
+
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        positions[i] += velocities[i] * dt;
+        velocities[i].y -= gravity_step;
+        rotations[i] = Atan2(velocities[i].y, velocities[i].x);
+    }
+}
+
+float Batch::Atan2(const float y, const float x)
+{
+    const float abs_x = std::fabs(x);
+    const float abs_y = std::fabs(y);
+
+    const float min = std::fmin(abs_x, abs_y);
+    const float max = std::fmax(abs_x, abs_y);
+
+    // Reduce the angle to within [0, 45] degrees, where the polynomial is accurate.
+    const float a = max != 0.0f ? min / max : 0.0f;
+    const float s = a * a;
+
+    float p = ATAN_C5;
+    p = p * s + ATAN_C4;
+    p = p * s + ATAN_C3;
+    p = p * s + ATAN_C2;
+    p = p * s + ATAN_C1;
+    p = p * s + ATAN_C0;
+
+    float r = p * a;
+    if (abs_y > abs_x)
+        r = HALF_PI - r;
+    if (x < 0.0f)
+        r = PI - r;
+    if (y < 0.0f)
+        r = -r;
+
+    return r;
+}
+
+const char* Batch::GetInstructionSet()
+{
+#if defined(SCX_BATCH_AVX2)
+    return "AVX2";
+#elif defined(SCX_BATCH_SSE2)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
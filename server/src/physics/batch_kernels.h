@@ -0,0 +1,159 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#if defined(__AVX2__)
+#define SCX_BATCH_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCX_BATCH_SSE2
+#endif
+
+/**
+ * \brief Kernels which test and integrate many objects at once, using SIMD instructions when
+ * they are available and an equivalent scalar path otherwise. AVX2 is used when the server is
+ * built with AVX2 enabled, by the \code --avx2\endcode Premake option, otherwise SSE2 is used
+ * on x86.
+ */
+namespace Batch
+{
+    /**
+     * \brief The number of boxes tested by a single overlap test.
+     */
+    constexpr size_t BOX_BATCH_WIDTH = 8;
+
+    /**
+     * \brief An axis-aligned box stored as its lower and upper corners.
+     */
+    struct Box
+    {
+        glm::vec2 min;
+        glm::vec2 max;
+    };
+
+    /**
+     * \brief A set of boxes with each bound stored in its own array, padded to a whole number
+     * of batches with boxes which overlap nothing.
+     */
+    class BoxSet
+    {
+    public:
+        BoxSet() = default;
+        ~BoxSet() = default;
+
+        BoxSet(const BoxSet&) = default;
+        BoxSet& operator=(const BoxSet&) = default;
+
+        BoxSet(BoxSet&&) noexcept = default;
+        BoxSet& operator=(BoxSet&&) noexcept = default;
+
+        /**
+         * \brief Removes every box, keeping the memory of the arrays for reuse.
+         */
+        void Clear();
+
+        /**
+         * \brief Adds a box to the end of the set.
+         * \param box The box to add.
+         */
+        void Add(const Box& box);
+
+        /**
+         * \brief Gets the number of boxes which have been added.
+         * \return The number of boxes, excluding padding.
+         */
+        [[nodiscard]] size_t GetSize() const;
+
+        /**
+         * \brief Gets the number of boxes including padding, which is a multiple of
+         * \code BOX_BATCH_WIDTH\endcode.
+         * \return The padded number of boxes.
+         */
+        [[nodiscard]] size_t GetPaddedSize() const;
+
+        [[nodiscard]] const float* GetMinX() const;
+        [[nodiscard]] const float* GetMinY() const;
+        [[nodiscard]] const float* GetMaxX() const;
+        [[nodiscard]] const float* GetMaxY() const;
+
+    private:
+        std::vector<float> m_min_x;
+        std::vector<float> m_min_y;
+        std::vector<float> m_max_x;
+        std::vector<float> m_max_y;
+        size_t m_size = 0;
+    };
+
+    /**
+     * \brief Determines whether two boxes overlap. Boxes which only touch do not overlap.
+     */
+    inline bool Overlaps(const Box& a, const Box& b)
+    {
+        return a.min.x < b.max.x && a.max.x > b.min.x && a.min.y < b.max.y && a.max.y > b.min.y;
+    }
+
+    /**
+     * \brief Tests a box against a batch of boxes.
+     * \param box The box to test.
+     * \param boxes The set of boxes.
+     * \param first The index of the first box of the batch, which must be a multiple of
+     * \code BOX_BATCH_WIDTH\endcode.
+     * \return A mask with a bit set for each box of the batch which overlaps the box.
+     */
+    uint32_t OverlapMask(const Box& box, const BoxSet& boxes, size_t first);
+
+    /**
+     * \brief The scalar equivalent of \code OverlapMask\endcode.
+     */
+    uint32_t OverlapMaskScalar(const Box& box, const BoxSet& boxes, size_t first);
+
+    /**
+     * \brief Visits the index of every box in a set which overlaps a box, in increasing order.
+     * \param box The box to test.
+     * \param boxes The set of boxes.
+     * \param visit The function called with the index of each overlapping box.
+     */
+    template <typename F>
+    void ForEachOverlap(const Box& box, const BoxSet& boxes, F&& visit)
+    {
+        for (size_t first = 0; first < boxes.GetPaddedSize(); first += BOX_BATCH_WIDTH)
+        {
+            for (uint32_t mask = OverlapMask(box, boxes, first); mask != 0; mask &= mask - 1)
+                visit(first + static_cast<size_t>(std::countr_zero(mask)));
+        }
+    }
+
+    /**
+     * \brief Moves projectiles along their velocities, applies gravity and points each
+     * projectile along its new velocity.
+     * \param positions The positions of the projectiles.
+     * \param velocities The velocities of the projectiles.
+     * \param rotations The rotations of the projectiles, which are overwritten.
+     * \param dt The length of time to simulate.
+     * \param gravity The downwards acceleration applied to the projectiles.
+     */
+    void IntegrateProjectiles(std::span<glm::vec2> positions, std::span<glm::vec2> velocities,
+                              std::span<float> rotations, float dt, float gravity);
+
+    /**
+     * \brief The scalar equivalent of \code IntegrateProjectiles\endcode.
+     */
+    void IntegrateProjectilesScalar(std::span<glm::vec2> positions, std::span<glm::vec2> velocities,
+                                    std::span<float> rotations, float dt, float gravity);
+
+    /**
+     * \brief Approximates the angle of a vector, as \code std::atan2\endcode does, to within
+     * 0.00001 radians. This is the scalar form of the approximation used by the kernels.
+     */
+    float Atan2(float y, float x);
+
+    /**
+     * \brief Gets the name of the instruction set the kernels were built for.
+     */
+    const char* GetInstructionSet();
+}
@@ -1,7 +1,51 @@
 #include "collision.h"
 
+#include <glm/geometric.hpp>
 #include <glm/ext/quaternion_geometric.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+/**
+ * \brief Finds the edge of the first box along whose normal the second box is furthest away.
+ */
+static Collision::Separation FindSeparatingEdge(const Collision::Box2d& b1, const Collision::Box2d& b2)
+{
+    Collision::Separation separation{ -std::numeric_limits<float>::infinity(), { 0.0f, 0.0f } };
+
+    for (size_t i = 0; i < b1.vertices.size(); i++)
+    {
+        const glm::vec2 normal = GetNormal(b1, i);
+
+        // The distance of the second box from the edge is that of its nearest vertex.
+        float distance = std::numeric_limits<float>::infinity();
+        for (const auto& vertex : b2.vertices)
+            distance = std::min(distance, glm::dot(vertex - b1.vertices[i], normal));
+
+        if (distance > separation.distance)
+            separation = { distance, normal };
+    }
+
+    return separation;
+}
+
+/**
+ * \brief Projects the vertices of a box onto an axis.
+ */
+static void Project(const Collision::Box2d& box, const glm::vec2 axis, float& min, float& max)
+{
+    min = glm::dot(box.vertices[0], axis);
+    max = min;
+
+    for (size_t i = 1; i < box.vertices.size(); i++)
+    {
+        const float projection = glm::dot(box.vertices[i], axis);
+        min = std::min(min, projection);
+        max = std::max(max, projection);
+    }
+}
+
 Collision::AABB::AABB()
     : vertices{}
 {
@@ -30,6 +74,31 @@ Collision::Box2d::Box2d(const glm::vec2 v1, const glm::vec2 v2, const glm::vec2
     vertices[3] = v4;
 }
 
+Collision::AABB Collision::MakeAABB(const glm::vec2 min, const glm::vec2 max)
+{
+    return { { min.x, max.y }, { max.x, max.y }, { max.x, min.y }, { min.x, min.y } };
+}
+
+Collision::Box2d Collision::MakeBox2d(const glm::vec2 centre, const glm::vec2 half_scale, const glm::vec2 axis)
+{
+    const glm::vec2 width = axis * half_scale.x;
+    const glm::vec2 height = glm::vec2{ -axis.y, axis.x } * half_scale.y;
+
+    return { centre - width + height, centre + width + height, centre + width - height, centre - width - height };
+}
+
+void Collision::GetBounds(const Box2d& box, glm::vec2& min, glm::vec2& max)
+{
+    min = box.vertices[0];
+    max = box.vertices[0];
+
+    for (const auto& vertex : box.vertices)
+    {
+        min = { std::min(min.x, vertex.x), std::min(min.y, vertex.y) };
+        max = { std::max(max.x, vertex.x), std::max(max.y, vertex.y) };
+    }
+}
+
 bool Collision::AABBtoAABB(const AABB b1, const AABB b2)
 {
     return b1.vertices[0].x < b2.vertices[1].x &&
@@ -65,3 +134,89 @@ bool Collision::ByDistance(const glm::vec2 p1, const glm::vec2 p2, const float d
     const glm::vec2 distance_vector = p1 - p2;
     return glm::length(distance_vector) <= distance;
 }
+
+Collision::Separation Collision::SeparateBoxes(const Box2d& b1, const Box2d& b2)
+{
+    const Separation first = FindSeparatingEdge(b1, b2);
+    const Separation second = FindSeparatingEdge(b2, b1);
+
+    // The normals of the second box's edges point away from it, towards the first box.
+    if (second.distance > first.distance)
+        return { second.distance, -second.normal };
+
+    return first;
+}
+
+std::optional<Collision::Contact> Collision::SweepBox2d(const Box2d& box, const glm::vec2 displacement,
+                                                        const Box2d& other)
+{
+    // Opposite edges of a box are parallel, so two edges of each box give every axis to test.
+    const std::array<glm::vec2, 4> axes = {
+        GetNormal(box, 0), GetNormal(box, 1), GetNormal(other, 0), GetNormal(other, 1)
+    };
+
+    float enter = 0.0f;
+    float exit = 1.0f;
+    bool starts_overlapping = true;
+    glm::vec2 normal{ 0.0f, 0.0f };
+
+    for (const auto& axis : axes)
+    {
+        float min, max, other_min, other_max;
+        Project(box, axis, min, max);
+        Project(other, axis, other_min, other_max);
+
+        // The boxes overlap along this axis while the distance moved along it is strictly
+        // between these two bounds.
+        const float lower = other_min - max;
+        const float upper = other_max - min;
+        const float speed = glm::dot(displacement, axis);
+
+        if (speed == 0.0f)
+        {
+            // A box which does not move along this axis must already overlap on it.
+            if (lower >= 0.0f || upper <= 0.0f)
+                return std::nullopt;
+
+            continue;
+        }
+
+        float enter_time = lower / speed;
+        float exit_time = upper / speed;
+
+        if (enter_time > exit_time)
+            std::swap(enter_time, exit_time);
+
+        // The contact is on the axis along which the boxes are the last to start overlapping.
+        if (enter_time > 0.0f)
+            starts_overlapping = false;
+        if (enter_time > enter)
+        {
+            enter = enter_time;
+            normal = speed > 0.0f ? axis : -axis;
+        }
+
+        exit = std::min(exit, exit_time);
+
+        if (enter >= exit)
+            return std::nullopt;
+    }
+
+    // Boxes which already overlap are pushed apart along the axis of least penetration.
+    if (starts_overlapping)
+        normal = SeparateBoxes(box, other).normal;
+
+    return Contact{ enter, normal };
+}
+
+glm::vec2 GetNormal(const Collision::Box2d box, const size_t vertex_index)
+{
+    // The vertices are in clockwise order, so the outward normal is the edge turned anticlockwise.
+    const glm::vec2 edge = box.vertices[(vertex_index + 1) % box.vertices.size()] - box.vertices[vertex_index];
+    return glm::normalize(glm::vec2{ -edge.y, edge.x });
+}
+
+float FindMinimumSeparation(const Collision::Box2d b1, const Collision::Box2d b2)
+{
+    return FindSeparatingEdge(b1, b2).distance;
+}
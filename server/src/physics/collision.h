@@ -3,6 +3,7 @@
 #include <glm/vec2.hpp>
 
 #include <array>
+#include <optional>
 
 namespace Collision
 {
@@ -14,6 +15,9 @@ namespace Collision
         AABB(glm::vec2 v1, glm::vec2 v2, glm::vec2 v3, glm::vec2 v4);
     };
 
+    /**
+     * \brief A box which may be rotated, given by its corners in clockwise order.
+     */
     struct Box2d
     {
         std::array<glm::vec2, 4> vertices;
@@ -22,10 +26,91 @@ namespace Collision
         Box2d(glm::vec2 v1, glm::vec2 v2, glm::vec2 v3, glm::vec2 v4);
     };
 
+    /**
+     * \brief The axis along which two boxes are furthest apart.
+     */
+    struct Separation
+    {
+        /**
+         * \brief The distance between the boxes along the axis, which is negative when the boxes
+         * overlap, in which case it is the depth of the overlap.
+         */
+        float distance;
+
+        /**
+         * \brief The unit normal of the axis, pointing from the first box towards the second.
+         */
+        glm::vec2 normal;
+    };
+
+    /**
+     * \brief Where a moving box first touches another box.
+     */
+    struct Contact
+    {
+        /**
+         * \brief The fraction of the movement, from 0 to 1, at which the boxes first overlap.
+         */
+        float time;
+
+        /**
+         * \brief The unit normal of the contact, pointing from the moving box towards the other box.
+         */
+        glm::vec2 normal;
+    };
+
+    /**
+     * \brief Creates an axis-aligned box from its lower and upper corners.
+     */
+    AABB MakeAABB(glm::vec2 min, glm::vec2 max);
+
+    /**
+     * \brief Creates a box from its centre, half of its size and the direction of its width.
+     * \param centre The centre of the box.
+     * \param half_scale Half of the width and height of the box.
+     * \param axis The unit vector along the width of the box, which gives its rotation without
+     * any trigonometry.
+     */
+    Box2d MakeBox2d(glm::vec2 centre, glm::vec2 half_scale, glm::vec2 axis);
+
+    /**
+     * \brief Gets the axis-aligned bounds of a box.
+     * \param box The box.
+     * \param min The lower corner of the bounds.
+     * \param max The upper corner of the bounds.
+     */
+    void GetBounds(const Box2d& box, glm::vec2& min, glm::vec2& max);
+
     bool AABBtoAABB(AABB b1, AABB b2);
     bool AABBtoAABB(AABB b1, AABB b2, bool collision_locations[4]);
     bool ByDistance(glm::vec2 p1, glm::vec2 p2, float distance);
+
+    /**
+     * \brief Finds the separation of two boxes using the separating axis theorem.
+     * \return The axis along which the boxes are furthest apart. The boxes overlap when its
+     * distance is negative.
+     */
+    Separation SeparateBoxes(const Box2d& b1, const Box2d& b2);
+
+    /**
+     * \brief Finds when a box moving in a straight line first overlaps a stationary box, testing
+     * the movement along each axis of both boxes.
+     * \param box The moving box at the start of its movement.
+     * \param displacement The movement of the box.
+     * \param other The stationary box.
+     * \return The contact at which the boxes first overlap, or nothing if they do not overlap
+     * during the movement. Boxes which only touch do not overlap.
+     */
+    std::optional<Contact> SweepBox2d(const Box2d& box, glm::vec2 displacement, const Box2d& other);
 }
 
+/**
+ * \brief Gets the outward unit normal of the edge from a vertex of a box to the next vertex.
+ */
 glm::vec2 GetNormal(Collision::Box2d box, size_t vertex_index);
-float FindMinimumSeparation(Collision::Box2d b1, Collision::Box2d b2);
\ No newline at end of file
+
+/**
+ * \brief Finds the largest distance between the second box and any edge of the first box,
+ * measured along the edge's normal. The distance is negative when no edge separates them.
+ */
+float FindMinimumSeparation(Collision::Box2d b1, Collision::Box2d b2);
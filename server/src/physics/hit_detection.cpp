@@ -0,0 +1,148 @@
+#include "hit_detection.h"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <optional>
+
+/**
+ * \brief How far the bounds of a projectile's movement are widened before the targets are tested
+ * against them, so that rounding cannot reject a target which the exact sweep would hit.
+ */
+constexpr float MOVEMENT_BOUNDS_MARGIN = 0.001f;
+
+Collision::Box2d GetProjectileBox(const HitProjectile& projectile, const glm::vec2 projectile_scale)
+{
+    return Collision::MakeBox2d(projectile.position, projectile_scale / 2.0f, projectile.direction);
+}
+
+/**
+ * \brief Finds when a projectile, moving from the start of its displacement, first overlaps
+ * a target.
+ * \param start_box The box of the projectile at the start of its displacement.
+ */
+static std::optional<float> SweepHit(const Collision::Box2d& start_box, const HitProjectile& projectile,
+                                     const HitTarget& target)
+{
+    // Projectiles cannot hit the player who fired them, or a target which cannot be hit.
+    if (target.id == projectile.owner_id || !target.can_be_hit)
+        return std::nullopt;
+
+    const std::optional<Collision::Contact> contact = Collision::SweepBox2d(
+        start_box, projectile.displacement, Collision::MakeBox2d(target.position, target.scale / 2.0f, { 1.0f, 0.0f }));
+
+    if (!contact)
+        return std::nullopt;
+
+    return contact->time;
+}
+
+/**
+ * \brief Gets the box of a projectile at the start of its displacement.
+ */
+static Collision::Box2d GetStartBox(const HitProjectile& projectile, const glm::vec2 projectile_scale)
+{
+    return Collision::MakeBox2d(projectile.position - projectile.displacement, projectile_scale / 2.0f,
+                                projectile.direction);
+}
+
+int FindProjectileHit(const HitProjectile& projectile, const glm::vec2 projectile_scale,
+                      const std::span<const HitTarget> targets, float* hit_time)
+{
+    const Collision::Box2d start_box = GetStartBox(projectile, projectile_scale);
+
+    int hit = NO_HIT;
+    float first_time = 0.0f;
+
+    for (size_t i = 0; i < targets.size(); i++)
+    {
+        const std::optional<float> time = SweepHit(start_box, projectile, targets[i]);
+
+        if (time && (hit == NO_HIT || *time < first_time))
+        {
+            hit = static_cast<int>(i);
+            first_time = *time;
+        }
+    }
+
+    if (hit_time)
+        *hit_time = first_time;
+
+    return hit;
+}
+
+HitDetector::HitDetector(const float cell_size)
+    : m_grid{ cell_size },
+      m_max_target_extent{ 0.0f }
+{
+}
+
+void HitDetector::Build(const std::span<const HitTarget> targets)
+{
+    m_grid.Clear();
+    m_max_target_extent = 0.0f;
+
+    for (uint32_t i = 0; i < targets.size(); i++)
+    {
+        m_grid.Insert(i, targets[i].position);
+        m_max_target_extent = std::max(m_max_target_extent, glm::length(targets[i].scale) / 2.0f);
+    }
+}
+
+int HitDetector::FindProjectileHit(const HitProjectile& projectile, const glm::vec2 projectile_scale,
+                                   const std::span<const HitTarget> targets, float* hit_time)
+{
+    const Collision::Box2d start_box = GetStartBox(projectile, projectile_scale);
+
+    // A target can only be hit if its centre is within the distance from its centre to its
+    // furthest corner of a point the projectile passes over, so the search is centred on the
+    // middle of the displacement.
+    const glm::vec2 centre = projectile.position - projectile.displacement / 2.0f;
+    const float radius = glm::length(projectile_scale) / 2.0f + glm::length(projectile.displacement) / 2.0f +
+        m_max_target_extent;
+
+    m_candidates.clear();
+    m_candidate_boxes.Clear();
+
+    m_grid.Query(centre, radius, [&](const uint32_t index)
+    {
+        const HitTarget& target = targets[index];
+
+        m_candidates.push_back(index);
+        m_candidate_boxes.Add({ target.position - target.scale / 2.0f, target.position + target.scale / 2.0f });
+    });
+
+    // A target can only be hit if it overlaps the bounds of the whole movement of the projectile.
+    glm::vec2 start_min, start_max;
+    Collision::GetBounds(start_box, start_min, start_max);
+
+    const Batch::Box movement{
+        glm::min(start_min, start_min + projectile.displacement) - MOVEMENT_BOUNDS_MARGIN,
+        glm::max(start_max, start_max + projectile.displacement) + MOVEMENT_BOUNDS_MARGIN
+    };
+
+    // The targets near the projectile are visited in no particular order, so ties between
+    // targets hit at the same time are broken by index to give the same result as testing
+    // every target in order.
+    int hit = NO_HIT;
+    float first_time = 0.0f;
+
+    Batch::ForEachOverlap(movement, m_candidate_boxes, [&](const size_t candidate)
+    {
+        const uint32_t index = m_candidates[candidate];
+        const std::optional<float> time = SweepHit(start_box, projectile, targets[index]);
+
+        if (time && (hit == NO_HIT || *time < first_time ||
+            (*time == first_time && static_cast<int>(index) < hit)))
+        {
+            hit = static_cast<int>(index);
+            first_time = *time;
+        }
+    });
+
+    if (hit_time)
+        *hit_time = first_time;
+
+    return hit;
+}
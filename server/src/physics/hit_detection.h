@@ -0,0 +1,119 @@
+#pragma once
+
+#include "batch_kernels.h"
+#include "collision.h"
+#include "spatial_grid.h"
+
+#include <glm/vec2.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * \brief The index returned when a projectile has not hit any target.
+ */
+constexpr int NO_HIT = -1;
+
+/**
+ * \brief A box which can be hit by projectiles, such as a player.
+ */
+struct HitTarget
+{
+    unsigned int id;
+    glm::vec2 position;
+    glm::vec2 scale;
+    bool can_be_hit;
+};
+
+/**
+ * \brief A projectile to test for hits, which is swept along its displacement so that it
+ * cannot pass through a target between updates.
+ */
+struct HitProjectile
+{
+    glm::vec2 position;
+
+    /**
+     * \brief The unit vector along the length of the projectile.
+     */
+    glm::vec2 direction;
+    unsigned int owner_id;
+
+    /**
+     * \brief The movement of the projectile during the last update, which ended at its position.
+     */
+    glm::vec2 displacement{ 0.0f, 0.0f };
+};
+
+/**
+ * \brief Gets the box of a projectile at its position, pointing along its direction.
+ * \param projectile The projectile.
+ * \param projectile_scale The width and length of the projectile.
+ * \return The oriented box of the projectile.
+ */
+Collision::Box2d GetProjectileBox(const HitProjectile& projectile, glm::vec2 projectile_scale);
+
+/**
+ * \brief Finds the target a projectile hit first by testing it against every target.
+ * \param projectile The projectile.
+ * \param projectile_scale The width and length of the projectile.
+ * \param targets The targets which can be hit.
+ * \param hit_time If not null, set to the fraction of the projectile's displacement at which
+ * the target was hit.
+ * \return The index of the target which was hit first, or \code NO_HIT\endcode. Targets which
+ * are hit at the same time are ordered by index.
+ */
+int FindProjectileHit(const HitProjectile& projectile, glm::vec2 projectile_scale, std::span<const HitTarget> targets,
+                      float* hit_time = nullptr);
+
+/**
+ * \brief Finds the targets hit by projectiles, only testing each projectile against the
+ * targets near it. Gives the same results as \code FindProjectileHit\endcode.
+ */
+class HitDetector
+{
+public:
+    /**
+     * \brief Creates a hit detector.
+     * \param cell_size The size of the cells used to find nearby targets, which should be
+     * close to the distance at which a projectile can hit a target.
+     */
+    explicit HitDetector(float cell_size);
+
+    /**
+     * \brief Indexes the positions of the targets, which must be done whenever they move.
+     * \param targets The targets which can be hit.
+     */
+    void Build(std::span<const HitTarget> targets);
+
+    /**
+     * \brief Finds the target a projectile hit first. The bounds of the nearby targets are
+     * tested against the bounds of the projectile's movement a batch at a time, and only the
+     * targets which overlap them are swept exactly.
+     * \param projectile The projectile.
+     * \param projectile_scale The width and length of the projectile.
+     * \param targets The targets given to the last build. Whether each target can be hit may
+     * have changed since then.
+     * \param hit_time If not null, set to the fraction of the projectile's displacement at
+     * which the target was hit.
+     * \return The index of the target which was hit first, or \code NO_HIT\endcode.
+     */
+    [[nodiscard]] int FindProjectileHit(const HitProjectile& projectile, glm::vec2 projectile_scale,
+                                        std::span<const HitTarget> targets, float* hit_time = nullptr);
+
+private:
+    SpatialGrid m_grid;
+
+    /**
+     * \brief The index and bounds of each target near the projectile being tested, kept between
+     * queries so their memory is reused.
+     */
+    std::vector<uint32_t> m_candidates;
+    Batch::BoxSet m_candidate_boxes;
+
+    /**
+     * \brief The largest distance between the centre and a corner of any target.
+     */
+    float m_max_target_extent;
+};
@@ -0,0 +1,28 @@
+#include "spatial_grid.h"
+
+#include <ranges>
+
+SpatialGrid::SpatialGrid(const float cell_size)
+    : m_cell_size{ cell_size }
+{
+}
+
+void SpatialGrid::Clear()
+{
+    // A cell which is still empty was not used since the last clear, so it is unlikely to be
+    // used again soon.
+    std::erase_if(m_cells, [](const auto& cell) { return cell.second.empty(); });
+
+    for (auto& indices : m_cells | std::views::values)
+        indices.clear();
+}
+
+size_t SpatialGrid::GetCellCount() const
+{
+    return m_cells.size();
+}
+
+void SpatialGrid::Insert(const uint32_t index, const glm::vec2 position)
+{
+    m_cells[GetCellKey(ToCell(position.x), ToCell(position.y))].push_back(index);
+}
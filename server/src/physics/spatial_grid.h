@@ -0,0 +1,90 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \brief A uniform grid which buckets points by the cell they lie in, so that the points
+ * near a position can be found without testing every point.
+ */
+class SpatialGrid
+{
+public:
+    /**
+     * \brief Creates an empty grid.
+     * \param cell_size The width and height of each cell. Queries are cheapest when this is
+     * close to the radius most queries use.
+     */
+    explicit SpatialGrid(float cell_size);
+
+    /**
+     * \brief Removes every point from the grid. The cells which held points keep their memory
+     * for reuse, and the cells which were already empty are erased, so the grid only holds the
+     * cells used by the last two fills however far the points have moved.
+     */
+    void Clear();
+
+    /**
+     * \brief Adds a point to the grid.
+     * \param index An index identifying the point, such as its index within an array.
+     * \param position The position of the point.
+     */
+    void Insert(uint32_t index, glm::vec2 position);
+
+    /**
+     * \brief Visits the index of every point in the cells which overlap a circle. Points just
+     * outside the circle may also be visited, so callers must test the exact distance.
+     * \param centre The centre of the circle.
+     * \param radius The radius of the circle.
+     * \param visit The function called with the index of each point.
+     */
+    template <typename F>
+    void Query(const glm::vec2 centre, const float radius, F&& visit) const
+    {
+        const int min_x = ToCell(centre.x - radius), max_x = ToCell(centre.x + radius);
+        const int min_y = ToCell(centre.y - radius), max_y = ToCell(centre.y + radius);
+
+        for (int y = min_y; y <= max_y; y++)
+        {
+            for (int x = min_x; x <= max_x; x++)
+            {
+                const auto it = m_cells.find(GetCellKey(x, y));
+                if (it == m_cells.end())
+                    continue;
+
+                for (const uint32_t index : it->second)
+                    visit(index);
+            }
+        }
+    }
+
+    /**
+     * \brief Gets the number of cells the grid holds, including empty cells kept for reuse.
+     */
+    [[nodiscard]] size_t GetCellCount() const;
+
+private:
+    float m_cell_size;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells;
+
+    /**
+     * \brief Gets the coordinate of the cell which contains a coordinate of the world.
+     */
+    [[nodiscard]] int ToCell(const float coordinate) const
+    {
+        return static_cast<int>(std::floor(coordinate / m_cell_size));
+    }
+
+    /**
+     * \brief Combines the coordinates of a cell into the key of its bucket.
+     */
+    static uint64_t GetCellKey(const int x, const int y)
+    {
+        return static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32 | static_cast<uint32_t>(y);
+    }
+};
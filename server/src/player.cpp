@@ -1,16 +1,15 @@
 #include "player.h"
 #include "game.h"
+#include "room.h"
 #include "server_packet_dispatcher.h"
 
 #include "physics/collision.h"
 
-#include <common/level_manager.h>
 #include <common/world.h>
 
 #include <cmath>
 
-constexpr glm::vec2 PLAYER_START_POSITION = { 0.0f, 0.0f },
-                    PLAYER_SCALE{ 10.0f, 10.0f };
+constexpr glm::vec2 PLAYER_START_POSITION = { 0.0f, 0.0f };
 constexpr float PLAYER_MOVEMENT_SPEED = 50.0f,
                 PLAYER_JUMP_SPEED = 150.0f,
                 PLAYER_DAMPENING_FACTOR = 0.1f,
@@ -32,9 +31,6 @@ Player::Player()
 
 void Player::Update(const double dt)
 {
-    // Acquire lock on player guard.
-    std::unique_lock guard_lock{ m_guard };
-
     // Update the player's position based on their velocity.
     m_position += m_velocity * static_cast<float>(dt);
 
@@ -80,9 +76,6 @@ int Player::GetCurrentHealth() const
 void Player::ProcessInput(const bool key_pressed_down_w, const bool key_pressed_a, const bool key_pressed_d,
                           const bool left_mouse_btn_pressed)
 {
-    // Acquire lock on player guard.
-    std::unique_lock guard_lock{ m_guard };
-
     if (key_pressed_down_w && IsGrounded())
     {
         m_velocity.y = PLAYER_JUMP_SPEED;
@@ -104,21 +97,16 @@ void Player::ProcessInput(const bool key_pressed_down_w, const bool key_pressed_
 
 void Player::HandleCollisions()
 {
-    const Collision::AABB player_aabb{
-        { m_position.x - m_scale.x / 2.0f, m_position.y + m_scale.y / 2.0f },
-        { m_position.x + m_scale.x / 2.0f, m_position.y + m_scale.y / 2.0f },
-        { m_position.x + m_scale.x / 2.0f, m_position.y - m_scale.y / 2.0f },
-        { m_position.x - m_scale.x / 2.0f, m_position.y - m_scale.y / 2.0f }
-    };
+    const glm::vec2 player_min = m_position - m_scale / 2.0f;
+    const glm::vec2 player_max = m_position + m_scale / 2.0f;
+
+    const Collision::AABB player_aabb = Collision::MakeAABB(player_min, player_max);
 
-    for (const auto& platform : LevelManager::GetActive().GetByType(LevelContent::Type::Platform))
+    const StaticGeometry& static_geometry = Room::GetCurrent().GetLevel().GetStaticGeometry();
+
+    static_geometry.QueryBox(player_min, player_max, [&](const StaticBox& platform)
     {
-        const Collision::AABB platform_aabb{
-            { platform.position.x - platform.scale.x / 2.0f, platform.position.y + platform.scale.y / 2.0f },
-            { platform.position.x + platform.scale.x / 2.0f, platform.position.y + platform.scale.y / 2.0f },
-            { platform.position.x + platform.scale.x / 2.0f, platform.position.y - platform.scale.y / 2.0f },
-            { platform.position.x - platform.scale.x / 2.0f, platform.position.y - platform.scale.y / 2.0f }
-        };
+        const Collision::AABB platform_aabb = Collision::MakeAABB(platform.min, platform.max);
 
         bool collision_locations[4]{};
 
@@ -127,7 +115,7 @@ void Player::HandleCollisions()
             if (collision_locations[2] && collision_locations[3])
             {
                 // Collision has occurred at the bottom of the player.
-                m_position.y = platform.position.y + platform.scale.y / 2.0f + m_scale.y / 2.0f;
+                m_position.y = platform.max.y + m_scale.y / 2.0f;
                 m_velocity.y = 0;
                 m_on_platform = true;
             }
@@ -135,28 +123,28 @@ void Player::HandleCollisions()
             if (collision_locations[0] && collision_locations[1])
             {
                 // Collision has occurred at the top of the player.
-                m_position.y = platform.position.y - platform.scale.y / 2.0f - m_scale.y / 2.0f;
+                m_position.y = platform.min.y - m_scale.y / 2.0f;
                 m_velocity.y = 0;
             }
 
             if (collision_locations[0] && collision_locations[3])
             {
                 // Collision has occured on the left side of the player.
-                m_position.x = platform.position.x + platform.scale.x / 2.0f + m_scale.x / 2.0f;
+                m_position.x = platform.max.x + m_scale.x / 2.0f;
                 m_velocity.x = 0;
             }
 
             if (collision_locations[1] && collision_locations[2])
             {
                 // Collision has occured on the right side of the player.
-                m_position.x = platform.position.x - platform.scale.x / 2.0f - m_scale.x / 2.0f;
+                m_position.x = platform.min.x - m_scale.x / 2.0f;
                 m_velocity.x = 0;
             }
 
             if ((collision_locations[2] && !collision_locations[1]) || (collision_locations[3] && !collision_locations[0]))
             {
                 // Collision has occurred in either the bottom left or right.
-                m_position.y = platform.position.y + platform.scale.y / 2.0f + m_scale.y / 2.0f;
+                m_position.y = platform.max.y + m_scale.y / 2.0f;
                 m_velocity.y = 0;
                 m_on_platform = true;
             }
@@ -164,11 +152,11 @@ void Player::HandleCollisions()
             if ((collision_locations[0] && !collision_locations[3]) || (collision_locations[1] && !collision_locations[2]))
             {
                 // Collision has occurred in either the top left or right.
-                m_position.y = platform.position.y - platform.scale.y / 2.0f - m_scale.y / 2.0f;
+                m_position.y = platform.min.y - m_scale.y / 2.0f;
                 m_velocity.y = 0;
             }
         }
-    }
+    });
 }
 
 [[nodiscard]] glm::vec2 Player::GetPosition() const
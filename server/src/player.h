@@ -4,7 +4,7 @@
 
 #include <glm/vec2.hpp>
 
-#include <mutex>
+constexpr glm::vec2 PLAYER_SCALE{ 10.0f, 10.0f };
 
 class Player
 {
@@ -12,11 +12,11 @@ public:
     Player();
     ~Player() = default;
 
-    Player(const Player&) = delete;
-    Player& operator=(const Player&) = delete;
+    Player(const Player&) = default;
+    Player& operator=(const Player&) = default;
 
-    Player(Player&&) noexcept = delete;
-    Player& operator=(Player&&) noexcept = delete;
+    Player(Player&&) noexcept = default;
+    Player& operator=(Player&&) noexcept = default;
 
     /**
      * \brief Updates the necessary physics required for player movement.
@@ -113,7 +113,6 @@ private:
     Clock m_weapon_clock;
     bool m_on_platform;
     int m_health;
-    std::mutex m_guard;
 
     /**
      * \brief Determines whether the player is currently grounded.
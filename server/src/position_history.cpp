@@ -0,0 +1,33 @@
+#include "position_history.h"
+
+#include <common/utils/assertion.h>
+
+PositionHistory::PositionHistory()
+    : m_positions{},
+      m_ticks{}
+{
+}
+
+void PositionHistory::Record(const uint64_t tick, const glm::vec2 position)
+{
+    SCX_ASSERT(tick != 0, "Tick zero cannot be recorded, as it marks an empty entry.");
+
+    const size_t index = tick % POSITION_HISTORY_LENGTH;
+    m_positions[index] = position;
+    m_ticks[index] = tick;
+}
+
+void PositionHistory::Clear()
+{
+    m_ticks.fill(0);
+}
+
+std::optional<glm::vec2> PositionHistory::GetPosition(const uint64_t tick) const
+{
+    const size_t index = tick % POSITION_HISTORY_LENGTH;
+
+    if (tick == 0 || m_ticks[index] != tick)
+        return std::nullopt;
+
+    return m_positions[index];
+}
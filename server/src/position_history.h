@@ -0,0 +1,66 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+/**
+ * \brief The number of ticks of positions kept by a position history, which covers the
+ * longest lag compensation at tick rates of up to 128.
+ */
+constexpr size_t POSITION_HISTORY_LENGTH = 64;
+
+/**
+ * \brief The furthest back in time that hits are rewound to compensate for a client's latency.
+ */
+constexpr std::chrono::milliseconds MAX_LAG_COMPENSATION{ 500 };
+
+/**
+ * \brief A fixed-size ring buffer of the positions of an entity over the most recent ticks,
+ * used to test hits against where a client saw the entity rather than where it is now.
+ * Recording and looking up a position never allocates and takes constant time.
+ */
+class PositionHistory
+{
+public:
+    PositionHistory();
+    ~PositionHistory() = default;
+
+    PositionHistory(const PositionHistory&) = default;
+    PositionHistory& operator=(const PositionHistory&) = default;
+
+    PositionHistory(PositionHistory&&) noexcept = default;
+    PositionHistory& operator=(PositionHistory&&) noexcept = default;
+
+    /**
+     * \brief Records the position of the entity at a tick, replacing the oldest position.
+     * \param tick The tick, which must be later than the last recorded tick.
+     * \param position The position at the end of the tick.
+     */
+    void Record(uint64_t tick, glm::vec2 position);
+
+    /**
+     * \brief Removes every recorded position, such as when the entity is moved elsewhere.
+     */
+    void Clear();
+
+    /**
+     * \brief Gets the position of the entity at a tick.
+     * \param tick The tick.
+     * \return The position recorded at the tick, or nothing if it was not recorded or has been
+     * replaced by a later tick.
+     */
+    [[nodiscard]] std::optional<glm::vec2> GetPosition(uint64_t tick) const;
+
+private:
+    std::array<glm::vec2, POSITION_HISTORY_LENGTH> m_positions;
+
+    /**
+     * \brief The tick each position was recorded at, where zero marks an empty entry.
+     */
+    std::array<uint64_t, POSITION_HISTORY_LENGTH> m_ticks;
+};
@@ -0,0 +1,165 @@
+#include "projectile_pool.h"
+
+#include "physics/batch_kernels.h"
+
+#include <common/world.h>
+
+#include <common/utils/assertion.h>
+
+#include <algorithm>
+
+
+/**
+ * \brief Combines the slot and generation of a projectile into its identifier.
+ */
+static UUID MakeId(const uint32_t slot, const uint32_t generation)
+{
+    return UUID{ static_cast<uint64_t>(generation) << 32 | slot };
+}
+
+ProjectilePool::ProjectilePool()
+{
+    m_ids.reserve(INITIAL_PROJECTILE_CAPACITY);
+    m_positions.reserve(INITIAL_PROJECTILE_CAPACITY);
+    m_previous_positions.reserve(INITIAL_PROJECTILE_CAPACITY);
+    m_velocities.reserve(INITIAL_PROJECTILE_CAPACITY);
+    m_rotations.reserve(INITIAL_PROJECTILE_CAPACITY);
+    m_lifetimes.reserve(INITIAL_PROJECTILE_CAPACITY);
+    m_owners.reserve(INITIAL_PROJECTILE_CAPACITY);
+    m_slot_of.reserve(INITIAL_PROJECTILE_CAPACITY);
+    m_slots.reserve(INITIAL_PROJECTILE_CAPACITY);
+    m_free_slots.reserve(INITIAL_PROJECTILE_CAPACITY);
+}
+
+UUID ProjectilePool::Spawn(const glm::vec2 position, const glm::vec2 velocity, const unsigned int owner_id,
+                           const float lifetime)
+{
+    uint32_t slot;
+    if (!m_free_slots.empty())
+    {
+        slot = m_free_slots.back();
+        m_free_slots.pop_back();
+    }
+    else
+    {
+        // Generations start from one, so that no identifier is zero.
+        slot = static_cast<uint32_t>(m_slots.size());
+        m_slots.push_back({ .index = 0, .generation = 1 });
+    }
+
+    m_slots[slot].index = static_cast<uint32_t>(m_ids.size());
+
+    const UUID id = MakeId(slot, m_slots[slot].generation);
+
+    m_ids.push_back(id);
+    m_positions.push_back(position);
+    m_previous_positions.push_back(position);
+    m_velocities.push_back(velocity);
+    m_rotations.push_back(Batch::Atan2(velocity.y, velocity.x));
+    m_lifetimes.push_back(lifetime);
+    m_owners.push_back(owner_id);
+    m_slot_of.push_back(slot);
+
+    return id;
+}
+
+void ProjectilePool::Remove(const size_t index)
+{
+    SCX_ASSERT(index < m_ids.size(), "The projectile index is out of range.");
+
+    // Invalidate the handle of the removed projectile before its slot is reused.
+    const uint32_t slot = m_slot_of[index];
+    m_slots[slot].generation++;
+    m_free_slots.push_back(slot);
+
+    const size_t last = m_ids.size() - 1;
+    if (index != last)
+    {
+        m_ids[index] = m_ids[last];
+        m_positions[index] = m_positions[last];
+        m_previous_positions[index] = m_previous_positions[last];
+        m_velocities[index] = m_velocities[last];
+        m_rotations[index] = m_rotations[last];
+        m_lifetimes[index] = m_lifetimes[last];
+        m_owners[index] = m_owners[last];
+        m_slot_of[index] = m_slot_of[last];
+
+        m_slots[m_slot_of[index]].index = static_cast<uint32_t>(index);
+    }
+
+    m_ids.pop_back();
+    m_positions.pop_back();
+    m_previous_positions.pop_back();
+    m_velocities.pop_back();
+    m_rotations.pop_back();
+    m_lifetimes.pop_back();
+    m_owners.pop_back();
+    m_slot_of.pop_back();
+}
+
+void ProjectilePool::Integrate(const float dt)
+{
+    std::ranges::copy(m_positions, m_previous_positions.begin());
+
+    Batch::IntegrateProjectiles(m_positions, m_velocities, m_rotations, dt, GRAVITY * GRAVITY_SCALE);
+
+    for (float& lifetime : m_lifetimes)
+        lifetime -= dt;
+}
+
+void ProjectilePool::Expire(const size_t index)
+{
+    m_lifetimes[index] = 0.0f;
+}
+
+bool ProjectilePool::HasExpired(const size_t index) const
+{
+    return m_lifetimes[index] <= 0.0f;
+}
+
+std::optional<size_t> ProjectilePool::Find(const UUID id) const
+{
+    const auto value = static_cast<uint64_t>(id);
+    const auto slot = static_cast<uint32_t>(value);
+    const auto generation = static_cast<uint32_t>(value >> 32);
+
+    if (slot >= m_slots.size() || m_slots[slot].generation != generation)
+        return std::nullopt;
+
+    return m_slots[slot].index;
+}
+
+size_t ProjectilePool::GetSize() const
+{
+    return m_ids.size();
+}
+
+std::span<const UUID> ProjectilePool::GetIds() const
+{
+    return m_ids;
+}
+
+std::span<const glm::vec2> ProjectilePool::GetPositions() const
+{
+    return m_positions;
+}
+
+std::span<const glm::vec2> ProjectilePool::GetPreviousPositions() const
+{
+    return m_previous_positions;
+}
+
+std::span<const glm::vec2> ProjectilePool::GetVelocities() const
+{
+    return m_velocities;
+}
+
+std::span<const float> ProjectilePool::GetRotations() const
+{
+    return m_rotations;
+}
+
+std::span<const unsigned int> ProjectilePool::GetOwners() const
+{
+    return m_owners;
+}
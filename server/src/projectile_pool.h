@@ -0,0 +1,120 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+
+#include <common/utils/uuid.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+/**
+ * \brief The number of projectiles a pool has room for before it needs to grow.
+ */
+constexpr size_t INITIAL_PROJECTILE_CAPACITY = 1024;
+
+/**
+ * \brief Stores the projectiles of the game world as a structure of arrays, so that updating
+ * every projectile walks each property contiguously.
+ *
+ * Projectiles are kept densely packed and removed by moving the last projectile into the gap,
+ * so their indices change over time. Each projectile is instead identified by a handle made
+ * of its slot and the generation of that slot, which stays valid until the projectile is
+ * removed and is never reused by a later projectile in the same slot. Handles are sent to
+ * clients as the projectile's identifier.
+ */
+class ProjectilePool
+{
+public:
+    ProjectilePool();
+    ~ProjectilePool() = default;
+
+    ProjectilePool(const ProjectilePool&) = default;
+    ProjectilePool& operator=(const ProjectilePool&) = default;
+
+    ProjectilePool(ProjectilePool&&) noexcept = default;
+    ProjectilePool& operator=(ProjectilePool&&) noexcept = default;
+
+    /**
+     * \brief Adds a projectile to the pool.
+     * \param position The position of the new projectile.
+     * \param velocity The velocity of the new projectile.
+     * \param owner_id The identifier of the player who fired the projectile.
+     * \param lifetime The number of seconds before the projectile expires.
+     * \return The identifier of the new projectile.
+     */
+    UUID Spawn(glm::vec2 position, glm::vec2 velocity, unsigned int owner_id, float lifetime);
+
+    /**
+     * \brief Removes a projectile by moving the last projectile into its place, so the index
+     * of the last projectile changes.
+     * \param index The index of the projectile to remove.
+     */
+    void Remove(size_t index);
+
+    /**
+     * \brief Moves every projectile along its velocity, applies gravity and counts down its
+     * lifetime. The position of each projectile before it moved is kept, so that collisions
+     * can be found along the whole of the movement.
+     * \param dt The length of time to simulate.
+     */
+    void Integrate(float dt);
+
+    /**
+     * \brief Marks a projectile as expired, so that it is removed by the next update.
+     * \param index The index of the projectile.
+     */
+    void Expire(size_t index);
+
+    /**
+     * \brief Determines whether a projectile has expired.
+     * \param index The index of the projectile.
+     * \return A true or false value indicating if the projectile has expired.
+     */
+    [[nodiscard]] bool HasExpired(size_t index) const;
+
+    /**
+     * \brief Finds the current index of a projectile.
+     * \param id The identifier of the projectile.
+     * \return The index of the projectile, or nothing if it has been removed.
+     */
+    [[nodiscard]] std::optional<size_t> Find(UUID id) const;
+
+    /**
+     * \brief Gets the number of projectiles in the pool.
+     * \return The number of projectiles.
+     */
+    [[nodiscard]] size_t GetSize() const;
+
+    [[nodiscard]] std::span<const UUID> GetIds() const;
+    [[nodiscard]] std::span<const glm::vec2> GetPositions() const;
+    [[nodiscard]] std::span<const glm::vec2> GetPreviousPositions() const;
+    [[nodiscard]] std::span<const glm::vec2> GetVelocities() const;
+    [[nodiscard]] std::span<const float> GetRotations() const;
+    [[nodiscard]] std::span<const unsigned int> GetOwners() const;
+
+private:
+    /**
+     * \brief An entry of the table which maps the slot of a handle to a projectile.
+     */
+    struct Slot
+    {
+        uint32_t index;
+        uint32_t generation;
+    };
+
+    // The properties of each projectile, indexed by the projectile's index.
+    std::vector<UUID> m_ids;
+    std::vector<glm::vec2> m_positions;
+    std::vector<glm::vec2> m_previous_positions;
+    std::vector<glm::vec2> m_velocities;
+    std::vector<float> m_rotations;
+    std::vector<float> m_lifetimes;
+    std::vector<unsigned int> m_owners;
+    std::vector<uint32_t> m_slot_of;
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_free_slots;
+};
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * \brief The assumed size of a cache line, used to keep the indices of a ring buffer
+ * which are written by different threads from sharing a line.
+ */
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * \brief A bounded, lock-free ring buffer which supports a single producer thread and
+ * a single consumer thread.
+ * \tparam T The type of element stored in the ring buffer.
+ * \tparam Capacity The number of preallocated slots, which must be a power of two.
+ */
+template <typename T, size_t Capacity>
+class SpscRingBuffer
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+public:
+    SpscRingBuffer() = default;
+    ~SpscRingBuffer() = default;
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    SpscRingBuffer(SpscRingBuffer&&) noexcept = delete;
+    SpscRingBuffer& operator=(SpscRingBuffer&&) noexcept = delete;
+
+    /**
+     * \brief Moves a value into the next free slot. Must only be called by the producer.
+     * \param value The value to push.
+     * \return A true or false value indicating whether there was space for the value.
+     */
+    bool TryPush(T&& value)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail - m_head_cache == Capacity)
+        {
+            // Only re-read the consumer's index when the buffer appears to be full.
+            m_head_cache = m_head.load(std::memory_order_acquire);
+            if (tail - m_head_cache == Capacity)
+                return false;
+        }
+
+        m_slots[tail & (Capacity - 1)] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * \brief Moves as many of the given values as there is space for into the ring buffer,
+     * publishing them to the consumer together. Must only be called by the producer.
+     * \param values The values to push.
+     * \param count The number of values to push.
+     * \return The number of values which were pushed, counted from the first.
+     */
+    size_t TryPushBatch(T* values, const size_t count)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (Capacity - (tail - m_head_cache) < count)
+            m_head_cache = m_head.load(std::memory_order_acquire);
+
+        const size_t pushed = std::min(count, Capacity - (tail - m_head_cache));
+
+        for (size_t i = 0; i < pushed; i++)
+            m_slots[(tail + i) & (Capacity - 1)] = std::move(values[i]);
+
+        m_tail.store(tail + pushed, std::memory_order_release);
+
+        return pushed;
+    }
+
+    /**
+     * \brief Moves the oldest value out of the ring buffer. Must only be called by the consumer.
+     * \param dest A reference to the destination of the popped value.
+     * \return A true or false value indicating whether a value was popped.
+     */
+    bool TryPop(T& dest)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+
+        if (head == m_tail_cache)
+        {
+            m_tail_cache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tail_cache)
+                return false;
+        }
+
+        dest = std::move(m_slots[head & (Capacity - 1)]);
+        m_head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * \brief Gets an approximation of the number of values in the ring buffer.
+     * \return The number of values in the ring buffer at the time of the call.
+     */
+    [[nodiscard]] size_t Size() const
+    {
+        const size_t head = m_head.load(std::memory_order_acquire);
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+
+        return tail > head ? tail - head : 0;
+    }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head{ 0 };
+    size_t m_tail_cache{ 0 };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail{ 0 };
+    size_t m_head_cache{ 0 };
+
+    alignas(CACHE_LINE_SIZE) std::array<T, Capacity> m_slots{};
+};
+
+/**
+ * \brief A bounded, lock-free ring buffer which supports any number of producer threads
+ * and a single consumer thread. Each slot carries a sequence number which tells producers
+ * and the consumer whether it is free or holds a value.
+ * \tparam T The type of element stored in the ring buffer.
+ * \tparam Capacity The number of preallocated slots, which must be a power of two.
+ */
+template <typename T, size_t Capacity>
+class MpscRingBuffer
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+public:
+    MpscRingBuffer()
+    {
+        for (size_t i = 0; i < Capacity; i++)
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ~MpscRingBuffer() = default;
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    MpscRingBuffer(MpscRingBuffer&&) noexcept = delete;
+    MpscRingBuffer& operator=(MpscRingBuffer&&) noexcept = delete;
+
+    /**
+     * \brief Moves a value into the next free slot. May be called by any thread.
+     * \param value The value to push.
+     * \return A true or false value indicating whether there was space for the value.
+     */
+    bool TryPush(T&& value)
+    {
+        size_t position = m_tail.load(std::memory_order_relaxed);
+        Slot* slot;
+
+        while (true)
+        {
+            slot = &m_slots[position & (Capacity - 1)];
+
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+            if (difference == 0)
+            {
+                // The slot is free, attempt to claim it.
+                if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                // The consumer has not yet released this slot, so the buffer is full.
+                return false;
+            }
+            else
+                position = m_tail.load(std::memory_order_relaxed);
+        }
+
+        slot->value = std::move(value);
+        slot->sequence.store(position + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * \brief Moves the oldest value out of the ring buffer. Must only be called by the consumer.
+     * \param dest A reference to the destination of the popped value.
+     * \return A true or false value indicating whether a value was popped.
+     */
+    bool TryPop(T& dest)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        Slot& slot = m_slots[head & (Capacity - 1)];
+
+        if (slot.sequence.load(std::memory_order_acquire) != head + 1)
+            return false;
+
+        dest = std::move(slot.value);
+
+        // Mark the slot as free for the producer which will wrap around to it next.
+        slot.sequence.store(head + Capacity, std::memory_order_release);
+        m_head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * \brief Gets an approximation of the number of values in the ring buffer.
+     * \return The number of values in the ring buffer at the time of the call.
+     */
+    [[nodiscard]] size_t Size() const
+    {
+        const size_t head = m_head.load(std::memory_order_acquire);
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+
+        return tail > head ? tail - head : 0;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        T value{};
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail{ 0 };
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head{ 0 };
+
+    alignas(CACHE_LINE_SIZE) std::array<Slot, Capacity> m_slots{};
+};
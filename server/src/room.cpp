@@ -0,0 +1,246 @@
+#include "room.h"
+
+#include "server_packet_dispatcher.h"
+#include "tick_profiler.h"
+
+#include <common/utils/assertion.h>
+#include <common/utils/logging.h>
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+/**
+ * \brief The weight of the latest update in the moving average of a room's update times.
+ */
+constexpr int64_t TICK_TIME_AVERAGE_WEIGHT = 16;
+
+/**
+ * \brief How often the round-trip time of each client is refreshed. Lag compensation only needs
+ * a recent estimate, and sampling a connection's status takes a lock in the networking library.
+ */
+constexpr std::chrono::seconds PING_UPDATE_INTERVAL{ 1 };
+
+thread_local Room* Room::s_p_current = nullptr;
+
+Room::Scope::Scope(Room& room)
+    : m_p_previous{ s_p_current }
+{
+    s_p_current = &room;
+}
+
+Room::Scope::~Scope()
+{
+    s_p_current = m_p_previous;
+}
+
+Room::Room(const unsigned int id, const Level& level, const IClientTransport& transport)
+    : m_id{ id },
+      m_level{ level },
+      m_transport{ transport },
+      m_assigned_clients{ 0 },
+      m_client_count{ 0 },
+      m_tick_time{ 0 },
+      m_average_tick_time{ 0 },
+      m_projectile_count{ 0 },
+      m_last_ping_update{}
+{
+}
+
+void Room::Update(const double dt, const int ticks)
+{
+    const Scope scope{ *this };
+    const ScopedPhaseTimer timer{ TickPhase::Tick };
+    const auto start = std::chrono::steady_clock::now();
+
+    // Only the clients which left before the commands of this update were queued are removed,
+    // so a client's join is applied before its leave unless the join is held up behind a
+    // command which has not been published yet.
+    {
+        std::scoped_lock leaving_lock{ m_leaving_guard };
+        m_removing.swap(m_leaving);
+    }
+
+    UpdatePings(start);
+
+    // Every tick simulates the same length of time, however late it runs.
+    for (int i = 0; i < ticks; i++)
+        Game::Update(dt);
+
+    RemoveClients();
+
+    // Replicate the updated state of the world to the clients once the game has caught up.
+    {
+        const ScopedPhaseTimer dispatch_timer{ TickPhase::Dispatch };
+        SnapshotManager::Update();
+    }
+
+    const int64_t tick_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    const int64_t average = m_average_tick_time.load(std::memory_order_relaxed);
+
+    m_tick_time.store(tick_time, std::memory_order_relaxed);
+    m_average_tick_time.store(average + (tick_time - average) / TICK_TIME_AVERAGE_WEIGHT, std::memory_order_relaxed);
+    m_projectile_count.store(Game::GetProjectiles().GetSize(), std::memory_order_relaxed);
+}
+
+bool Room::EnqueueCommand(GameCommand&& command)
+{
+    const Scope scope{ *this };
+    return Game::EnqueueCommand(std::move(command));
+}
+
+void Room::Acknowledge(const unsigned int client_id, const uint32_t sequence)
+{
+    const Scope scope{ *this };
+    SnapshotManager::Acknowledge(client_id, sequence);
+}
+
+void Room::Leave(const unsigned int client_id)
+{
+    std::scoped_lock leaving_lock{ m_leaving_guard };
+    m_leaving.push_back(client_id);
+}
+
+size_t Room::AddClient(const HSteamNetConnection connection, std::string username)
+{
+    const ClientHandle handle = m_clients.Add(connection, std::move(username));
+    m_connections.push_back(connection);
+    m_client_count.store(m_clients.GetSize(), std::memory_order_relaxed);
+
+    const size_t index = *m_clients.Find(handle);
+
+    // The client's hits are compensated for its latency from the start, rather than once the
+    // pings are next refreshed.
+    if (const std::optional<int> ping = m_transport.GetPing(connection))
+        m_clients.GetInfo()[index].ping = *ping;
+
+    return index;
+}
+
+bool Room::DiscardJoin(const unsigned int client_id)
+{
+    const auto it = std::ranges::find(m_unmatched_leaves, client_id);
+    if (it == m_unmatched_leaves.end())
+        return false;
+
+    m_unmatched_leaves.erase(it);
+    return true;
+}
+
+bool Room::IsParked() const
+{
+    return m_assigned_clients.load(std::memory_order_relaxed) == 0 &&
+           m_client_count.load(std::memory_order_relaxed) == 0;
+}
+
+unsigned int Room::GetId() const
+{
+    return m_id;
+}
+
+size_t Room::GetAssignedClients() const
+{
+    return m_assigned_clients.load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds Room::GetTickTime() const
+{
+    return std::chrono::nanoseconds{ m_tick_time.load(std::memory_order_relaxed) };
+}
+
+std::chrono::nanoseconds Room::GetAverageTickTime() const
+{
+    return std::chrono::nanoseconds{ m_average_tick_time.load(std::memory_order_relaxed) };
+}
+
+size_t Room::GetProjectileCount() const
+{
+    return m_projectile_count.load(std::memory_order_relaxed);
+}
+
+ClientRegistry& Room::GetClients()
+{
+    return m_clients;
+}
+
+std::span<const HSteamNetConnection> Room::GetConnections() const
+{
+    return m_connections;
+}
+
+Level& Room::GetLevel()
+{
+    return m_level;
+}
+
+const IClientTransport& Room::GetTransport() const
+{
+    return m_transport;
+}
+
+Game& Room::GetGame()
+{
+    return m_game;
+}
+
+InterestManager& Room::GetInterest()
+{
+    return m_interest;
+}
+
+SnapshotManager& Room::GetSnapshots()
+{
+    return m_snapshots;
+}
+
+Room& Room::GetCurrent()
+{
+    SCX_ASSERT(s_p_current != nullptr, "The calling thread is not updating a room.");
+    return *s_p_current;
+}
+
+void Room::UpdatePings(const std::chrono::steady_clock::time_point now)
+{
+    if (now - m_last_ping_update < PING_UPDATE_INTERVAL)
+        return;
+
+    m_last_ping_update = now;
+
+    for (auto& client_info : m_clients.GetInfo())
+    {
+        if (const std::optional<int> ping = m_transport.GetPing(client_info.connection))
+            client_info.ping = *ping;
+    }
+}
+
+void Room::RemoveClients()
+{
+    for (const unsigned int client_id : m_removing)
+    {
+        // A client which left before its join was applied was never added, and its join is
+        // discarded once it arrives.
+        const std::optional<size_t> index = m_clients.Find(client_id);
+        if (!index)
+        {
+            m_unmatched_leaves.push_back(client_id);
+            continue;
+        }
+
+        const std::string username = m_clients.GetInfo()[*index].username;
+
+        SCX_CORE_INFO("{0} has left room {1}.", username, m_id);
+
+        // Inform the other clients of the room that this client has gone.
+        PlayerDisconnected(client_id, username);
+
+        InterestManager::RemoveClient(client_id);
+        SnapshotManager::RemoveClient(client_id);
+
+        m_clients.Remove(client_id);
+        std::erase(m_connections, client_id);
+    }
+
+    m_removing.clear();
+    m_client_count.store(m_clients.GetSize(), std::memory_order_relaxed);
+}
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "client_registry.h"
+#include "client_transport.h"
+#include "game.h"
+#include "game_command.h"
+#include "interest_manager.h"
+#include "snapshot_manager.h"
+
+#include <common/level.h>
+
+#include <steam/steamnetworkingtypes.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * \brief An independent match, with its own level, clients and game world.
+ *
+ * A room is only ever updated by one tick thread at a time. While a thread updates a room, the
+ * room is that thread's current room, and the static functions of \code Game\endcode,
+ * \code InterestManager\endcode and \code SnapshotManager\endcode act on the current room's
+ * instances of them. A room without any clients is parked, and is not updated until a client
+ * is assigned to it.
+ */
+class Room
+{
+public:
+    /**
+     * \brief Makes a room the current room of the calling thread until the scope ends.
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(Room& room);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        Scope(Scope&&) noexcept = delete;
+        Scope& operator=(Scope&&) noexcept = delete;
+
+    private:
+        Room* m_p_previous;
+    };
+
+    /**
+     * \brief Creates an empty room.
+     * \param id The identifier of the room.
+     * \param level The level played in the room, which the room keeps its own copy of.
+     * \param transport The transport through which packets are sent to the room's clients,
+     * which must outlive the room.
+     */
+    Room(unsigned int id, const Level& level, const IClientTransport& transport);
+    ~Room() = default;
+
+    Room(const Room&) = delete;
+    Room& operator=(const Room&) = delete;
+
+    Room(Room&&) noexcept = delete;
+    Room& operator=(Room&&) noexcept = delete;
+
+    /**
+     * \brief Runs the ticks which are due, removes the clients which have left and replicates
+     * the world to the remaining clients. Must only be called by the room's tick thread.
+     * \param dt The length of time simulated by each tick.
+     * \param ticks The number of ticks to run.
+     */
+    void Update(double dt, int ticks);
+
+    /**
+     * \brief Queues a command to be applied to the room's world. May be called from any thread.
+     * \param command The command.
+     * \return A true or false value indicating whether the command was queued.
+     */
+    bool EnqueueCommand(GameCommand&& command);
+
+    /**
+     * \brief Records that a client of the room has reconstructed a snapshot. May be called
+     * from any thread.
+     * \param client_id The identifier of the client.
+     * \param sequence The sequence of the snapshot which was acknowledged.
+     */
+    void Acknowledge(unsigned int client_id, uint32_t sequence);
+
+    /**
+     * \brief Queues a client to be removed from the room by its next update, once the commands
+     * it queued before leaving have been applied. May be called from any thread.
+     * \param client_id The identifier of the client.
+     */
+    void Leave(unsigned int client_id);
+
+    /**
+     * \brief Adds a client which has joined to the room, sampling its round-trip time. Must
+     * only be called by the room's tick thread.
+     * \param connection The connection of the client.
+     * \param username The username of the client.
+     * \return The index of the client within the room's registry.
+     */
+    size_t AddClient(HSteamNetConnection connection, std::string username);
+
+    /**
+     * \brief Determines whether a client left the room before its join was applied, in which
+     * case the join must be discarded. Must only be called by the room's tick thread.
+     * \param client_id The identifier of the client whose join is being applied.
+     * \return A true or false value indicating whether the join arrived after the client left.
+     */
+    bool DiscardJoin(unsigned int client_id);
+
+    /**
+     * \brief Determines whether the room is parked, which it is when no clients are assigned
+     * to it and the clients which left it have been removed. May be called from any thread.
+     */
+    [[nodiscard]] bool IsParked() const;
+
+    [[nodiscard]] unsigned int GetId() const;
+
+    /**
+     * \brief Gets the number of clients assigned to the room, including those which have not
+     * been added by the room's tick thread yet. May be called from any thread.
+     */
+    [[nodiscard]] size_t GetAssignedClients() const;
+
+    /**
+     * \brief Gets how long the room's last update took. May be called from any thread.
+     */
+    [[nodiscard]] std::chrono::nanoseconds GetTickTime() const;
+
+    /**
+     * \brief Gets an exponential moving average of how long the room's updates take. May be
+     * called from any thread.
+     */
+    [[nodiscard]] std::chrono::nanoseconds GetAverageTickTime() const;
+
+    /**
+     * \brief Gets the number of projectiles alive after the room's last update. May be called
+     * from any thread.
+     */
+    [[nodiscard]] size_t GetProjectileCount() const;
+
+    /**
+     * \brief Gets the clients which have joined the room. Must only be used by the room's
+     * tick thread.
+     */
+    [[nodiscard]] ClientRegistry& GetClients();
+
+    /**
+     * \brief Gets the connections of the clients which have joined the room, to which
+     * packets about the room are sent. Must only be used by the room's tick thread.
+     */
+    [[nodiscard]] std::span<const HSteamNetConnection> GetConnections() const;
+
+    /**
+     * \brief Gets the room's copy of its level. Must only be used by the room's tick thread.
+     */
+    [[nodiscard]] Level& GetLevel();
+
+    /**
+     * \brief Gets the transport through which packets are sent to the room's clients.
+     */
+    [[nodiscard]] const IClientTransport& GetTransport() const;
+
+    [[nodiscard]] Game& GetGame();
+    [[nodiscard]] InterestManager& GetInterest();
+    [[nodiscard]] SnapshotManager& GetSnapshots();
+
+    /**
+     * \brief Gets the room which the calling thread is updating.
+     * \return The current room, which must exist.
+     */
+    static Room& GetCurrent();
+
+private:
+    unsigned int m_id;
+    Level m_level;
+    const IClientTransport& m_transport;
+    ClientRegistry m_clients;
+    std::vector<HSteamNetConnection> m_connections;
+
+    Game m_game;
+    InterestManager m_interest;
+    SnapshotManager m_snapshots;
+
+    /**
+     * \brief The number of clients assigned to the room, which is changed by the room
+     * manager and read by the room's tick thread to decide whether the room is parked.
+     */
+    std::atomic<size_t> m_assigned_clients;
+
+    /**
+     * \brief The number of clients in the room's registry, published by the room's tick thread
+     * whenever clients are added or removed so that other threads can read it.
+     */
+    std::atomic<size_t> m_client_count;
+
+    /**
+     * \brief The clients which have left the room but have not been removed yet, and those
+     * being removed by the current update.
+     */
+    std::vector<unsigned int> m_leaving;
+    std::vector<unsigned int> m_removing;
+    std::mutex m_leaving_guard;
+
+    /**
+     * \brief The clients which were removed before their join was applied. A join which is
+     * queued behind a command that has not been published yet is only applied by a later
+     * update, so it may arrive after the client has left.
+     */
+    std::vector<unsigned int> m_unmatched_leaves;
+
+    std::atomic<int64_t> m_tick_time;
+    std::atomic<int64_t> m_average_tick_time;
+    std::atomic<size_t> m_projectile_count;
+
+    std::chrono::steady_clock::time_point m_last_ping_update;
+
+    static thread_local Room* s_p_current;
+
+    /**
+     * \brief Refreshes the round-trip time of each client from its connection's status, if
+     * the last refresh was long enough ago.
+     * \param now The time at which the update started.
+     */
+    void UpdatePings(std::chrono::steady_clock::time_point now);
+
+    /**
+     * \brief Removes the clients which left before the update started, telling the
+     * remaining clients that they have gone.
+     */
+    void RemoveClients();
+
+    friend class RoomManager;
+};
@@ -0,0 +1,217 @@
+#include "room_manager.h"
+
+#include "tick_scheduler.h"
+
+#include <common/utils/logging.h>
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+RoomManager RoomManager::s_instance;
+
+RoomManager::RoomManager()
+    : m_is_running{ false }
+{
+}
+
+void RoomManager::Initialise(const IClientTransport& transport, const Level& level, unsigned int room_count,
+                             unsigned int thread_count, const int tick_rate, const std::chrono::microseconds tick_spin)
+{
+    room_count = std::max(1u, room_count);
+    thread_count = std::clamp(thread_count, 1u, room_count);
+
+    for (unsigned int i = 0; i < thread_count; i++)
+        Get().m_threads.push_back(std::make_unique<TickThread>());
+
+    // Spread the rooms evenly over the tick threads.
+    for (unsigned int id = 0; id < room_count; id++)
+    {
+        Get().m_rooms.push_back(std::make_unique<Room>(id, level, transport));
+        Get().m_threads[id % thread_count]->rooms.push_back(Get().m_rooms.back().get());
+    }
+
+    Get().m_is_running = true;
+
+    for (unsigned int id = 0; id < thread_count; id++)
+        Get().m_threads[id]->handle = std::thread{ RunTickThread, id, tick_rate, tick_spin };
+
+    SCX_CORE_INFO("Created {0} rooms updated by {1} tick threads.", room_count, thread_count);
+}
+
+void RoomManager::Dispose()
+{
+    Get().m_is_running = false;
+
+    for (const auto& thread : Get().m_threads)
+        thread->handle.join();
+
+    Get().m_threads.clear();
+
+    std::unique_lock client_rooms_lock{ Get().m_client_rooms_guard };
+    Get().m_client_rooms.clear();
+    Get().m_rooms.clear();
+}
+
+void RoomManager::AssignClient(const unsigned int client_id, std::string username)
+{
+    std::unique_lock client_rooms_lock{ Get().m_client_rooms_guard };
+
+    if (Get().m_client_rooms.contains(client_id))
+        return;
+
+    Room* p_room = ChooseRoom();
+    if (p_room == nullptr)
+    {
+        SCX_CORE_WARN("Every room is full, client {0} cannot join a room.", client_id);
+        return;
+    }
+
+    // The room is unparked before the join is queued, so that its tick thread applies it.
+    Get().m_client_rooms[client_id] = p_room;
+    p_room->m_assigned_clients.fetch_add(1, std::memory_order_relaxed);
+
+    // Queuing the join while the rooms are locked orders it before the client's removal.
+    if (!p_room->EnqueueCommand({ .type = GameCommand::Type::Join, .client_id = client_id, .text = std::move(username) }))
+    {
+        // A client whose join was dropped would never have a player, so it is left unassigned.
+        SCX_CORE_WARN("Room {0} is too busy, client {1} cannot join it.", p_room->GetId(), client_id);
+
+        Get().m_client_rooms.erase(client_id);
+        p_room->m_assigned_clients.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+void RoomManager::RemoveClient(const unsigned int client_id)
+{
+    std::unique_lock client_rooms_lock{ Get().m_client_rooms_guard };
+
+    const auto it = Get().m_client_rooms.find(client_id);
+    if (it == Get().m_client_rooms.end())
+        return;
+
+    Room* p_room = it->second;
+    Get().m_client_rooms.erase(it);
+
+    p_room->Leave(client_id);
+    p_room->m_assigned_clients.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void RoomManager::EnqueueCommand(GameCommand&& command)
+{
+    std::shared_lock client_rooms_lock{ Get().m_client_rooms_guard };
+
+    const auto it = Get().m_client_rooms.find(command.client_id);
+    if (it != Get().m_client_rooms.end())
+        it->second->EnqueueCommand(std::move(command));
+}
+
+void RoomManager::Acknowledge(const unsigned int client_id, const uint32_t sequence)
+{
+    std::shared_lock client_rooms_lock{ Get().m_client_rooms_guard };
+
+    const auto it = Get().m_client_rooms.find(client_id);
+    if (it != Get().m_client_rooms.end())
+        it->second->Acknowledge(client_id, sequence);
+}
+
+std::vector<RoomStats> RoomManager::GetRoomStats()
+{
+    std::shared_lock client_rooms_lock{ Get().m_client_rooms_guard };
+
+    std::vector<RoomStats> stats;
+    stats.reserve(Get().m_rooms.size());
+
+    for (const auto& room : Get().m_rooms)
+    {
+        stats.push_back({
+            .id = room->GetId(), .tick_thread = GetTickThread(*room), .clients = room->GetAssignedClients(),
+            .is_parked = room->IsParked(), .tick_time = room->GetTickTime(),
+            .average_tick_time = room->GetAverageTickTime(), .projectiles = room->GetProjectileCount()
+        });
+    }
+
+    return stats;
+}
+
+RoomManager& RoomManager::Get()
+{
+    return s_instance;
+}
+
+void RoomManager::RunTickThread(const unsigned int id, const int tick_rate, const std::chrono::microseconds tick_spin)
+{
+    SCX_CORE_INFO("Tick thread {0} has been started!", id);
+
+    const std::vector<Room*>& rooms = Get().m_threads[id]->rooms;
+
+    TickScheduler scheduler{ tick_rate, tick_spin };
+    scheduler.Start();
+
+    while (Get().m_is_running)
+    {
+        const int ticks = scheduler.WaitForNextTick();
+
+        if (ticks > 1)
+        {
+            SCX_CORE_WARN(
+                "Tick thread {0} started {1:.2f} ms late, running {2} ticks to catch up ({3} skipped in total).", id,
+                std::chrono::duration<double, std::milli>(scheduler.GetLateness()).count(), ticks,
+                scheduler.GetSkippedTicks());
+        }
+
+        for (Room* p_room : rooms)
+        {
+            if (!p_room->IsParked())
+                p_room->Update(scheduler.GetFixedDeltaTime(), ticks);
+        }
+    }
+
+    SCX_CORE_INFO("Tick thread {0} has been terminated!", id);
+}
+
+Room* RoomManager::ChooseRoom()
+{
+    Room* p_busiest = nullptr;
+
+    for (const auto& room : Get().m_rooms)
+    {
+        const size_t clients = room->GetAssignedClients();
+
+        if (clients > 0 && clients < MAX_ROOM_CLIENTS &&
+            (p_busiest == nullptr || clients > p_busiest->GetAssignedClients()))
+        {
+            p_busiest = room.get();
+        }
+    }
+
+    if (p_busiest != nullptr)
+        return p_busiest;
+
+    // Every active room is full, so open a parked room on the least loaded tick thread.
+    std::vector<std::chrono::nanoseconds> thread_loads(Get().m_threads.size());
+
+    for (const auto& room : Get().m_rooms)
+    {
+        if (room->GetAssignedClients() > 0)
+            thread_loads[GetTickThread(*room)] += room->GetAverageTickTime();
+    }
+
+    Room* p_parked = nullptr;
+
+    for (const auto& room : Get().m_rooms)
+    {
+        if (room->GetAssignedClients() == 0 &&
+            (p_parked == nullptr || thread_loads[GetTickThread(*room)] < thread_loads[GetTickThread(*p_parked)]))
+        {
+            p_parked = room.get();
+        }
+    }
+
+    return p_parked;
+}
+
+unsigned int RoomManager::GetTickThread(const Room& room)
+{
+    return room.GetId() % static_cast<unsigned int>(Get().m_threads.size());
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "game_command.h"
+#include "room.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \brief The maximum number of clients which can be assigned to a room.
+ */
+constexpr size_t MAX_ROOM_CLIENTS = 32;
+
+/**
+ * \brief A snapshot of the load of a room.
+ */
+struct RoomStats
+{
+    unsigned int id;
+    unsigned int tick_thread;
+    size_t clients;
+    bool is_parked;
+    std::chrono::nanoseconds tick_time;
+    std::chrono::nanoseconds average_tick_time;
+    size_t projectiles;
+};
+
+/**
+ * \brief A data structure implemented as a singleton pattern to run many rooms in one process.
+ *
+ * A fixed set of rooms is created up front and spread across a pool of tick threads, each of
+ * which updates its rooms at the tick rate. Clients are assigned to a room once they have been
+ * welcomed. New clients fill the busiest room which has space, so that as few rooms as possible
+ * are active, and a parked room is only opened once every active room is full. Parked rooms
+ * are opened on the tick thread which is spending the least time updating its rooms.
+ */
+class RoomManager
+{
+public:
+    RoomManager(const RoomManager&) = delete;
+    RoomManager& operator=(const RoomManager&) = delete;
+
+    RoomManager(RoomManager&&) noexcept = delete;
+    RoomManager& operator=(RoomManager&&) noexcept = delete;
+
+    /**
+     * \brief Creates the rooms and starts the tick threads which update them.
+     * \param transport The transport through which the rooms send packets to their clients,
+     * which must outlive the rooms.
+     * \param level The level played in every room.
+     * \param room_count The number of rooms. If 0, a single room is created.
+     * \param thread_count The number of tick threads. If 0, a single thread is used.
+     * \param tick_rate The number of ticks per second.
+     * \param tick_spin How long before each tick the tick threads stop sleeping and spin.
+     */
+    static void Initialise(const IClientTransport& transport, const Level& level, unsigned int room_count,
+                           unsigned int thread_count, int tick_rate, std::chrono::microseconds tick_spin);
+
+    /**
+     * \brief Stops the tick threads and destroys the rooms.
+     */
+    static void Dispose();
+
+    /**
+     * \brief Assigns a client which has been welcomed to a room and queues its join. Clients
+     * which have already been assigned are ignored, and a client whose join cannot be queued
+     * is left unassigned. May be called from any thread.
+     * \param client_id The identifier of the client.
+     * \param username The username of the client.
+     */
+    static void AssignClient(unsigned int client_id, std::string username);
+
+    /**
+     * \brief Removes a client which has disconnected from its room. May be called from any
+     * thread.
+     * \param client_id The identifier of the client.
+     */
+    static void RemoveClient(unsigned int client_id);
+
+    /**
+     * \brief Queues a command to be applied to the room of the client which sent it. Commands
+     * from clients which have not been assigned a room are dropped. May be called from any
+     * thread.
+     * \param command The command.
+     */
+    static void EnqueueCommand(GameCommand&& command);
+
+    /**
+     * \brief Records that a client has reconstructed a snapshot of its room. May be called
+     * from any thread.
+     * \param client_id The identifier of the client.
+     * \param sequence The sequence of the snapshot which was acknowledged.
+     */
+    static void Acknowledge(unsigned int client_id, uint32_t sequence);
+
+    /**
+     * \brief Gets the load of each room. May be called from any thread.
+     * \return The stats of each room, in order of room identifier.
+     */
+    static std::vector<RoomStats> GetRoomStats();
+
+private:
+    /**
+     * \brief A thread which updates a subset of the rooms.
+     */
+    struct TickThread
+    {
+        std::thread handle;
+        std::vector<Room*> rooms;
+    };
+
+    std::vector<std::unique_ptr<Room>> m_rooms;
+    std::vector<std::unique_ptr<TickThread>> m_threads;
+    std::atomic<bool> m_is_running;
+
+    /**
+     * \brief The room each assigned client belongs to. Rooms are only used by other threads
+     * while this is locked, so they cannot be destroyed while in use.
+     */
+    std::unordered_map<unsigned int, Room*> m_client_rooms;
+    std::shared_mutex m_client_rooms_guard;
+
+    RoomManager();
+    ~RoomManager() = default;
+
+    static RoomManager s_instance;
+    static RoomManager& Get();
+
+    /**
+     * \brief The function run by each tick thread.
+     * \param id The index of the tick thread.
+     * \param tick_rate The number of ticks per second.
+     * \param tick_spin How long before each tick to stop sleeping and spin.
+     */
+    static void RunTickThread(unsigned int id, int tick_rate, std::chrono::microseconds tick_spin);
+
+    /**
+     * \brief Chooses the room to assign a new client to. The rooms must be locked.
+     * \return The room, or \code nullptr\endcode if every room is full.
+     */
+    static Room* ChooseRoom();
+
+    /**
+     * \brief Gets the index of the tick thread which updates a room.
+     */
+    static unsigned int GetTickThread(const Room& room);
+};
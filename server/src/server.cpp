@@ -1,23 +1,67 @@
 #include "server.h"
 #include "game.h"
+#include "metrics_exporter.h"
+#include "room_manager.h"
 #include "thread_pool.h"
 
 #include <common/assets/asset_manager.h>
+#include <common/level_manager.h>
 
 #include <common/networking/core.h>
+#include <common/networking/packet_stats.h>
 
 #include <common/utils/assertion.h>
 #include <common/utils/logging.h>
 
+#include <steam/isteamnetworkingutils.h>
 #include <steam/steamnetworkingsockets.h>
 
-#include <ranges>
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+
+/**
+ * \brief An encoded packet shared by every message of a broadcast. Each message holds a
+ * reference, and the payload is freed when the networking library releases the last one.
+ */
+struct SharedPayload
+{
+    std::atomic<int> references;
+    int size;
+    unsigned char data[MAX_ENCODED_PACKET_SIZE];
+};
+
+/**
+ * \brief Releases a message's reference to its shared payload. May be called by the
+ * networking library from any thread.
+ * \param p_message The message which has been sent.
+ */
+static void ReleaseSharedPayload(SteamNetworkingMessage_t* p_message)
+{
+    auto* p_payload = reinterpret_cast<SharedPayload*>(static_cast<intptr_t>(p_message->m_nUserData));
+
+    if (p_payload->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete p_payload;
+}
+
+/**
+ * \brief Requests that the tick profile is logged when the server is sent a signal.
+ */
+static void RequestTickProfileLog(int)
+{
+    TickProfiler::RequestLog();
+}
 
 Server* Server::s_p_callback_instance = nullptr;
 
 Server::Server(const ServerSettings settings)
     : m_settings{ settings },
       m_dispatcher{ this },
+      m_scheduler{ settings.tick_rate, settings.tick_spin },
       m_interface{ nullptr },
       m_listen_socket{ k_HSteamListenSocket_Invalid },
       m_poll_group{ k_HSteamNetPollGroup_Invalid }
@@ -41,9 +85,25 @@ void Server::Initialise()
     // Select interface instance to use.
     m_interface = SteamNetworkingSockets();
 
-    ThreadPool::Initialise(m_handler, m_dispatcher);
+    // The callbacks are run by this thread, once the server has been fully initialised.
+    s_p_callback_instance = this;
+
+    // The tick profile and traffic since the server started can be logged at any time by sending
+    // the server a signal.
+#if defined(SIGUSR1)
+    std::signal(SIGUSR1, RequestTickProfileLog);
+#elif defined(SIGBREAK)
+    std::signal(SIGBREAK, RequestTickProfileLog);
+#endif
+
+    ThreadPool::Initialise(m_handler, m_dispatcher, m_settings.worker_threads);
 
     Game::Initialise();
+    RoomManager::Initialise(*this, LevelManager::GetActive(), m_settings.rooms, m_settings.room_threads,
+                            m_settings.tick_rate, m_settings.tick_spin);
+
+    if (!m_settings.metrics_path.empty())
+        MetricsExporter::Initialise(*this, m_settings.metrics_path, m_settings.metrics_interval);
 }
 
 void Server::Run()
@@ -65,39 +125,84 @@ void Server::Run()
 
     SCX_CORE_INFO("Server listening on port {0}.", m_settings.port);
 
-    const int sleep_duration = 1000 / m_settings.tick_rate;
+    m_scheduler.Start();
 
+    // The rooms are updated by their own tick threads, so this thread only polls the network,
+    // once per tick.
     while (true)
     {
-        const auto current_time = std::chrono::high_resolution_clock::now();
-        const double delta_time = static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(
-            current_time - m_last_time).count()) / 1000;
-        m_last_time = current_time;
+        m_scheduler.WaitForNextTick();
 
-        PollIncomingMessages();
-        PollConnectionStateChanges();
+        {
+            const ScopedPhaseTimer timer{ TickPhase::Poll };
+            PollIncomingMessages();
+        }
 
-        Game::Update(delta_time);
+        {
+            const ScopedPhaseTimer timer{ TickPhase::Callbacks };
+            PollConnectionStateChanges();
+        }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(sleep_duration));
+        LogStats();
     }
 }
 
-std::unordered_map<HSteamNetConnection, ClientInfo>& Server::GetClientInfoMap()
+void Server::Send(const Packet& packet, const unsigned int client) const
 {
-    return s_p_callback_instance->m_client_info;
+    ThreadPool::EnqueuePacketToSend(packet, client);
 }
 
-std::unordered_map<HSteamNetConnection, UUID>& Server::GetClientThreadMap()
+void Server::Multicast(const Packet& packet, const std::span<const HSteamNetConnection> clients,
+                       const HSteamNetConnection except) const
 {
-    return s_p_callback_instance->m_client_threads;
+    SendToClients(packet, clients, except);
+}
+
+std::optional<int> Server::GetPing(const HSteamNetConnection client) const
+{
+    SteamNetConnectionRealTimeStatus_t status{};
+
+    if (m_interface->GetConnectionRealTimeStatus(client, &status, 0, nullptr) != k_EResultOK)
+        return std::nullopt;
+
+    return status.m_nPing;
+}
+
+std::vector<ConnectionStats> Server::GetConnectionStats() const
+{
+    // The connections are copied so that the lock is not held while the library is queried.
+    std::vector<HSteamNetConnection> connections;
+    {
+        std::shared_lock connections_lock{ m_connections_guard };
+        connections = m_connections;
+    }
+
+    std::vector<ConnectionStats> stats;
+    stats.reserve(connections.size());
+
+    for (const auto conn : connections)
+    {
+        SteamNetConnectionRealTimeStatus_t status{};
+
+        if (m_interface->GetConnectionRealTimeStatus(conn, &status, 0, nullptr) != k_EResultOK)
+            continue;
+
+        stats.push_back({
+            .connection = conn, .ping = status.m_nPing, .quality_local = status.m_flConnectionQualityLocal,
+            .quality_remote = status.m_flConnectionQualityRemote, .out_bytes_per_sec = status.m_flOutBytesPerSec,
+            .in_bytes_per_sec = status.m_flInBytesPerSec, .pending_reliable = status.m_cbPendingReliable,
+            .pending_unreliable = status.m_cbPendingUnreliable
+        });
+    }
+
+    return stats;
 }
 
 void Server::Dispose()
 {
     SCX_CORE_INFO("Closing connections to server.");
 
-    for (const auto client : std::views::keys(m_client_info))
+    for (const auto client : m_connections)
     {
         // Send a farewell packet message to each client.
         Packet farewell_packet{ PacketType::ServerShutdown };
@@ -108,10 +213,14 @@ void Server::Dispose()
         m_interface->CloseConnection(client, 0, "Server shutdown", true);
     }
 
+    // The exporter reads from the rooms and the thread pool, so it is stopped before them. The
+    // rooms are stopped next, so that their tick threads no longer send packets to the strands
+    // of the thread pool.
+    MetricsExporter::Dispose();
+    RoomManager::Dispose();
     ThreadPool::Dispose();
 
-    m_client_info.clear();
-    m_client_threads.clear();
+    m_connections.clear();
 
     m_interface->CloseListenSocket(m_listen_socket);
     m_listen_socket = k_HSteamListenSocket_Invalid;
@@ -120,54 +229,106 @@ void Server::Dispose()
     m_poll_group = k_HSteamNetPollGroup_Invalid;
 
     ShutdownSteamDatagramConnectionSockets();
+
+    s_p_callback_instance = nullptr;
 }
 
 void Server::PollIncomingMessages()
 {
-    while (true)
+    m_receiver.Receive(m_interface, m_poll_group,
+                       [this](const HSteamNetConnection conn, const std::span<PacketInfoFromClient> packet_infos)
     {
-        ISteamNetworkingMessage* p_incoming_message = nullptr;
-
-        const int num_msgs = m_interface->ReceiveMessagesOnPollGroup(m_poll_group, &p_incoming_message, 1);
-        if (num_msgs == 0)
-            break;
-        if (num_msgs < 0)
-            SCX_CORE_ERROR("An error occurred when checking for messages.");
+        SCX_ASSERT(std::ranges::find(m_connections, conn) != m_connections.end(),
+                   "There isn't a client associated with the incoming message.");
 
-        // Check that a valid message exists.
-        SCX_ASSERT(num_msgs == 1 && p_incoming_message, "A valid message does not exist.");
+        // Add the client's packets to its strand to be processed by the relevant thread.
+        ThreadPool::EnqueuePacketsToHandle(packet_infos, conn);
+    });
+}
 
-        auto it_client = m_client_info.find(p_incoming_message->m_conn);
-        SCX_ASSERT(it_client != m_client_info.end(), "There isn't a client associated with the incoming message.");
+void Server::PollConnectionStateChanges()
+{
+    m_interface->RunCallbacks();
+}
 
-        auto packet_received = *static_cast<Packet*>(p_incoming_message->m_pData);
+void Server::LogStats()
+{
+    if (m_settings.profile_interval.count() > 0 &&
+        m_server_clock.HasTimeElapsed(static_cast<double>(m_settings.profile_interval.count())))
+    {
+        const std::string period = "of the last " + std::to_string(m_settings.profile_interval.count()) + " seconds";
 
-        // Add the packet to a queue to be processed by the relevant thread.
-        ThreadPool::EnqueuePacketToHandle(packet_received, p_incoming_message->m_conn);
+        const TickProfile profile = TickProfiler::GetProfile();
+        TickProfiler::LogProfile(profile.Since(m_last_profile), ("Tick profile " + period).c_str());
+        m_last_profile = profile;
 
-        p_incoming_message->Release();
+        const PacketStatsSnapshot packet_stats = PacketStats::GetSnapshot();
+        PacketStats::LogSnapshot(packet_stats.Since(m_last_packet_stats), ("Traffic " + period).c_str(),
+                                 static_cast<double>(m_settings.profile_interval.count()));
+        m_last_packet_stats = packet_stats;
     }
-}
 
-void Server::PollConnectionStateChanges()
-{
-    s_p_callback_instance = this;
-    m_interface->RunCallbacks();
+    if (TickProfiler::ConsumeLogRequest())
+    {
+        TickProfiler::LogProfile(TickProfiler::GetProfile(), "Tick profile since the server started");
+        PacketStats::LogSnapshot(PacketStats::GetSnapshot(), "Traffic since the server started");
+    }
 }
 
 void Server::SendToClient(const Packet& data, const HSteamNetConnection client_conn) const
 {
-    m_interface->SendMessageToConnection(client_conn, &data, sizeof(Packet),
-                                         k_nSteamNetworkingSend_Reliable, nullptr);
+    unsigned char buffer[MAX_ENCODED_PACKET_SIZE];
+    const int size = data.Encode(buffer, sizeof(buffer));
+
+    m_interface->SendMessageToConnection(client_conn, buffer, size, GetSendFlags(data.GetType()), nullptr);
+    PacketStats::RecordSent(data.GetType(), size);
 }
 
-void Server::SendToAllClients(const Packet& data, const HSteamNetConnection except) const
+void Server::SendToClients(const Packet& data, const std::span<const HSteamNetConnection> clients,
+                           const HSteamNetConnection except) const
 {
-    for (const auto& conn : std::views::keys(m_client_info))
+    // Reused between broadcasts on the same thread to avoid allocating the batch each time.
+    static thread_local std::vector<SteamNetworkingMessage_t*> messages;
+    messages.clear();
+
+    if (clients.empty())
+        return;
+
+    auto* p_payload = new SharedPayload{};
+    p_payload->size = data.Encode(p_payload->data, sizeof(p_payload->data));
+
+    const int send_flags = GetSendFlags(data.GetType());
+
+    for (const auto conn : clients)
+    {
+        if (conn == except)
+            continue;
+
+        SteamNetworkingMessage_t* p_message = SteamNetworkingUtils()->AllocateMessage(0);
+        p_message->m_conn = conn;
+        p_message->m_pData = p_payload->data;
+        p_message->m_cbSize = p_payload->size;
+        p_message->m_nFlags = send_flags;
+        p_message->m_nUserData = static_cast<int64>(reinterpret_cast<intptr_t>(p_payload));
+        p_message->m_pfnFreeData = ReleaseSharedPayload;
+
+        messages.push_back(p_message);
+    }
+
+    if (messages.empty())
     {
-        if (conn != except)
-            SendToClient(data, conn);
+        delete p_payload;
+        return;
     }
+
+    // None of the messages can be released before they are submitted, so the references
+    // only need to be counted once the batch is complete.
+    p_payload->references.store(static_cast<int>(messages.size()), std::memory_order_release);
+
+    // The payload may be freed as soon as the messages are submitted, so they are counted first.
+    PacketStats::RecordSent(data.GetType(), p_payload->size, messages.size());
+
+    m_interface->SendMessages(static_cast<int>(messages.size()), messages.data(), nullptr);
 }
 
 void Server::OnSteamNetConnectionStatusChanged(SteamNetConnectionStatusChangedCallback_t* p_info)
@@ -184,14 +345,9 @@ void Server::OnSteamNetConnectionStatusChanged(SteamNetConnectionStatusChangedCa
             // before their connection was accepted by the server.
             if (p_info->m_eOldState == k_ESteamNetworkingConnectionState_Connected)
             {
-                const auto it_client_info = m_client_info.find(p_info->m_hConn);
-                SCX_ASSERT(it_client_info != m_client_info.end(),
+                SCX_ASSERT(std::ranges::find(m_connections, p_info->m_hConn) != m_connections.end(),
                            "There isn't any client information associated with this connection.");
 
-                const auto it_client_thread = m_client_threads.find(p_info->m_hConn);
-                SCX_ASSERT(it_client_thread != m_client_threads.end(),
-                           "There isn't a thread associated with this connection.");
-
                 std::string error_log;
 
                 if (p_info->m_info.m_eState == k_ESteamNetworkingConnectionState_ProblemDetectedLocally)
@@ -200,17 +356,18 @@ void Server::OnSteamNetConnectionStatusChanged(SteamNetConnectionStatusChangedCa
                     error_log = "closed by peer";
 
                 // Log on server side.
-                SCX_CORE_INFO("{0} has disconnected from the server ({1}).", it_client_info->second.username,
-                              error_log);
+                SCX_CORE_INFO("Client {0} has disconnected from the server ({1}).", p_info->m_hConn, error_log);
 
-                // Inform other clients that this client has disconnected.
-                PlayerDisconnected(p_info->m_hConn, it_client_info->second.username);
+                // The client's room informs the other clients in it that this client has left.
+                RoomManager::RemoveClient(p_info->m_hConn);
 
                 // Cleanup
-                ThreadPool::TerminateThread(it_client_thread->second);
+                {
+                    std::unique_lock connections_lock{ m_connections_guard };
+                    std::erase(m_connections, p_info->m_hConn);
+                }
 
-                m_client_info.erase(it_client_info);
-                m_client_threads.erase(it_client_thread);
+                ThreadPool::CloseStrand(p_info->m_hConn);
             }
             else
                 SCX_ASSERT(p_info->m_eOldState == k_ESteamNetworkingConnectionState_Connecting,
@@ -223,7 +380,7 @@ void Server::OnSteamNetConnectionStatusChanged(SteamNetConnectionStatusChangedCa
     case k_ESteamNetworkingConnectionState_Connecting:
         {
             // Make sure this is a new connection by checking existing clients.
-            SCX_ASSERT(!m_client_info.contains(p_info->m_hConn),
+            SCX_ASSERT(std::ranges::find(m_connections, p_info->m_hConn) == m_connections.end(),
                        "A client associated with this connection already exists.");
 
             SCX_CORE_INFO("Connection request from {0}.", p_info->m_info.m_szConnectionDescription);
@@ -244,15 +401,15 @@ void Server::OnSteamNetConnectionStatusChanged(SteamNetConnectionStatusChangedCa
                 break;
             }
 
-            // Allocate a thread to manage this connection.
-            const UUID thread_id = ThreadPool::AllocateThread();
+            // Open a strand to process the new client's packets. The client is assigned a room
+            // once it has received the welcome message.
+            // Note: The client must have a strand before any packets can be sent or received.
+            ThreadPool::OpenStrand(p_info->m_hConn);
 
-            // Add the new client to the client lists.
-            // Note: Due to the dependency on an allocated thread to manage each connection,
-            // this the client must be associated with a thread before any packets can be sent
-            // or received.
-            m_client_info[p_info->m_hConn].username = "PlaceholderUsername";
-            m_client_threads[p_info->m_hConn] = thread_id;
+            {
+                std::unique_lock connections_lock{ m_connections_guard };
+                m_connections.push_back(p_info->m_hConn);
+            }
 
             // Send a welcome message to the new client.
             Welcome(p_info->m_hConn, "Welcome to the server.");
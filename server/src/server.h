@@ -1,22 +1,27 @@
 #pragma once
 
-#include "player.h"
-
+#include "client_transport.h"
+#include "message_receiver.h"
 #include "server_packet_dispatcher.h"
 #include "server_packet_handler.h"
+#include "tick_profiler.h"
+#include "tick_scheduler.h"
 
 #include <common/interface/iapplication.h>
 
+#include <common/networking/packet.h>
+#include <common/networking/packet_stats.h>
+
 #include <common/utils/clock.h>
-#include <common/utils/uuid.h>
 
 #include <steam/isteamnetworkingsockets.h>
 
 #include <chrono>
+#include <optional>
+#include <shared_mutex>
+#include <span>
 #include <string>
-#include <unordered_map>
-
-class Player;
+#include <vector>
 
 /**
  * \brief The settings used to configure the server application.
@@ -25,21 +30,40 @@ struct ServerSettings
 {
     uint16_t port;
     int tick_rate;
+    unsigned int worker_threads;
+    std::chrono::microseconds tick_spin;
+    unsigned int rooms;
+    unsigned int room_threads;
+    // How often the tick profile and packet statistics are logged, or never if zero.
+    std::chrono::seconds profile_interval;
+    // The file the metrics are written to in the Prometheus text format, or none if empty.
+    std::string metrics_path;
+    std::chrono::seconds metrics_interval;
 };
 
 /**
- * \brief Data providing information about each connected client.
+ * \brief A snapshot of the quality of a client's connection, as measured by the networking
+ * library.
  */
-struct ClientInfo
+struct ConnectionStats
 {
-    std::string username;
-    Player player;
+    HSteamNetConnection connection;
+    int ping;
+    // The fraction of packets delivered, from this end and from the client's, or negative if
+    // unknown.
+    float quality_local;
+    float quality_remote;
+    float out_bytes_per_sec;
+    float in_bytes_per_sec;
+    int pending_reliable;
+    int pending_unreliable;
 };
 
 /**
- * \brief Implementation of \code IApplication\endcode to represent the server application.
+ * \brief Implementation of \code IApplication\endcode to represent the server application,
+ * which is also the transport the rooms send packets to their clients through.
  */
-class Server final : public IApplication
+class Server final : public IApplication, public IClientTransport
 {
 public:
     explicit Server(ServerSettings settings);
@@ -54,34 +78,61 @@ public:
     void Run() override;
 
     /**
-     * \brief Gets the map of client connections with their respective information.
-     * \return The client information map.
+     * \brief Hands a packet to the client's strand, to be sent by a worker in order with the
+     * client's other packets. May be called from any thread.
+     */
+    void Send(const Packet& packet, unsigned int client) const override;
+
+    /**
+     * \brief Sends a packet to a set of clients, encoding it only once. May be called from any
+     * thread.
      */
-    static std::unordered_map<HSteamNetConnection, ClientInfo>& GetClientInfoMap();
+    void Multicast(const Packet& packet, std::span<const HSteamNetConnection> clients,
+                   HSteamNetConnection except = k_HSteamNetConnection_Invalid) const override;
 
     /**
-     * \brief Gets the map of client connections with their respective processing threads.
-     * \return The client thread map.
+     * \brief Gets the round-trip time to a client. May be called from any thread.
      */
-    static std::unordered_map<HSteamNetConnection, UUID>& GetClientThreadMap();
+    [[nodiscard]] std::optional<int> GetPing(HSteamNetConnection client) const override;
+
+    /**
+     * \brief Gets the quality of every client's connection. May be called from any thread.
+     * \return The status of each connection whose status is available.
+     */
+    [[nodiscard]] std::vector<ConnectionStats> GetConnectionStats() const;
 
 private:
     Clock m_server_clock;
     ServerSettings m_settings;
     ServerPacketHandler m_handler;
     ServerPacketDispatcher m_dispatcher;
+    TickScheduler m_scheduler;
     ISteamNetworkingSockets* m_interface;
     HSteamListenSocket m_listen_socket;
     HSteamNetPollGroup m_poll_group;
-    std::chrono::time_point<std::chrono::high_resolution_clock> m_last_time;
-    std::unordered_map<HSteamNetConnection, ClientInfo> m_client_info;
-    std::unordered_map<HSteamNetConnection, UUID> m_client_threads;
+
+    /**
+     * \brief The connections of every client, whichever room it is in, which are closed on
+     * shutdown and whose statistics are exported as metrics.
+     */
+    std::vector<HSteamNetConnection> m_connections;
+    mutable std::shared_mutex m_connections_guard;
+
+    MessageReceiver m_receiver;
+
+    /**
+     * \brief The tick profile and packet statistics when they were last logged, so that each
+     * periodic log only covers the interval since the one before it.
+     */
+    TickProfile m_last_profile;
+    PacketStatsSnapshot m_last_packet_stats;
 
     void Initialise() override;
     void Dispose() override;
 
     /**
-     * \brief Polls incoming messages from clients.
+     * \brief Polls incoming messages from clients in batches, handing the packets of each
+     * client to its strand in a single push per batch.
      */
     void PollIncomingMessages();
 
@@ -90,6 +141,12 @@ private:
      */
     void PollConnectionStateChanges();
 
+    /**
+     * \brief Logs the tick profile and packet statistics of the last interval once it has
+     * elapsed, and those since the server started if they have been requested.
+     */
+    void LogStats();
+
     /**
      * \brief Sends a packet to the specified client.
      * \param data The packet which will be dispatched to the client.
@@ -98,12 +155,14 @@ private:
     void SendToClient(const Packet& data, HSteamNetConnection client_conn) const;
 
     /**
-     * \brief Sends a packet to all clients. If \code except\endcode is specified, the
-     * associated client will be excluded from receiving the packet.
+     * \brief Sends a packet to each of the specified clients. The packet is encoded once into
+     * a shared, reference counted payload and every message is submitted in a single batch.
      * \param data The packet which will be dispatched to each client.
+     * \param clients The client connections to which the packet will be sent.
      * \param except The client connection to exclude from the transmission.
      */
-    void SendToAllClients(const Packet& data, HSteamNetConnection except = k_HSteamListenSocket_Invalid) const;
+    void SendToClients(const Packet& data, std::span<const HSteamNetConnection> clients,
+                       HSteamNetConnection except = k_HSteamNetConnection_Invalid) const;
 
     /**
      * \brief The callback used when a connection status has been changed, called on the
@@ -112,6 +171,11 @@ private:
      */
     void OnSteamNetConnectionStatusChanged(SteamNetConnectionStatusChangedCallback_t* p_info);
 
+    /**
+     * \brief The server which receives the networking library's callbacks. It is set when the
+     * server is initialised and cleared once it has been disposed of, and is only used by the
+     * thread which runs the callbacks.
+     */
     static Server* s_p_callback_instance;
 
     /**
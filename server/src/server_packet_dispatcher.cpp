@@ -1,6 +1,7 @@
 #include "server_packet_dispatcher.h"
 
-#include "projectile.h"
+#include "interest_manager.h"
+#include "room.h"
 #include "server.h"
 #include "thread_pool.h"
 
@@ -16,11 +17,6 @@ void ServerPacketDispatcher::SendToClient(const Packet& packet, const unsigned i
     dynamic_cast<const Server*>(m_handle)->SendToClient(packet, client);
 }
 
-void ServerPacketDispatcher::SendToAllClients(const Packet& packet, const unsigned int client) const
-{
-    dynamic_cast<const Server*>(m_handle)->SendToAllClients(packet, client);
-}
-
 void Welcome(const unsigned int client, const std::string& msg)
 {
     Packet pckt{ PacketType::Welcome };
@@ -36,30 +32,15 @@ void PlayerConnected(const unsigned int client, const std::string& username)
     pckt.Write(client);
     pckt.Write(username);
 
-    // Create a new "Player" object in client_info (Server::GetClientInfoMap()) to reference the position.
-    const Player& client_player = Server::GetClientInfoMap()[client].player;
+    Room& room = Room::GetCurrent();
+    const ClientRegistry& clients = room.GetClients();
+    const Player& client_player = clients.GetPlayers()[*clients.Find(client)];
     pckt.Write(client_player.GetPosition());
     pckt.Write(client_player.GetScale());
 
-    ThreadPool::EnqueuePacketToSendToAll(pckt, 0);
-
-    // For every client already connected, send a packet to spawn these on the new client.
-    for (const auto& [existing_client_id, existing_client_info] : Server::GetClientInfoMap())
-    {
-        // Make sure the existing client ID, is not the new client.
-        if (existing_client_id == client)
-            continue;
-
-        const auto& [existing_username, existing_player] = existing_client_info;
-
-        Packet existing_player_pckt{ PacketType::PlayerConnected };
-        existing_player_pckt.Write(existing_client_id);
-        existing_player_pckt.Write(existing_username);
-        existing_player_pckt.Write(existing_player.GetPosition());
-        existing_player_pckt.Write(existing_player.GetScale());
-
-        ThreadPool::EnqueuePacketToSend(existing_player_pckt, client);
-    }
+    // The players of other clients are spawned on the new client once they are within its
+    // region of interest, so only the connection itself is announced here.
+    room.GetTransport().Multicast(pckt, room.GetConnections());
 }
 
 void PlayerDisconnected(const unsigned int client, const std::string& username)
@@ -68,16 +49,8 @@ void PlayerDisconnected(const unsigned int client, const std::string& username)
     pckt.Write(client);
     pckt.Write(username);
 
-    ThreadPool::EnqueuePacketToSendToAll(pckt, client);
-}
-
-void PlayerMovement(const unsigned int client, const Player& player)
-{
-    Packet pckt{ PacketType::PlayerMovement };
-    pckt.Write(client);
-    pckt.Write(player.GetPosition());
-
-    ThreadPool::EnqueuePacketToSendToAll(pckt, 0);
+    const Room& room = Room::GetCurrent();
+    room.GetTransport().Multicast(pckt, room.GetConnections(), client);
 }
 
 void PlayerHealthUpdate(const unsigned int client, const Player& player)
@@ -85,7 +58,7 @@ void PlayerHealthUpdate(const unsigned int client, const Player& player)
     Packet pckt{ PacketType::PlayerHealthUpdate };
     pckt.Write(player.GetCurrentHealth());
 
-    ThreadPool::EnqueuePacketToSend(pckt, client);
+    Room::GetCurrent().GetTransport().Send(pckt, client);
 }
 
 void PlayerDeath(const unsigned int client)
@@ -93,17 +66,17 @@ void PlayerDeath(const unsigned int client)
     Packet pckt{ PacketType::PlayerDeath };
     pckt.Write(client);
 
-    ThreadPool::EnqueuePacketToSendToAll(pckt, 0);;
+    // Other clients despawn the player once it has left the world.
+    Room::GetCurrent().GetTransport().Send(pckt, client);
 }
 
 void PlayerRespawn(const unsigned int client)
 {
-    ClientInfo& client_info = Server::GetClientInfoMap()[client];
+    const ClientRegistry& clients = Room::GetCurrent().GetClients();
+    const size_t index = *clients.Find(client);
 
-    const std::string& username = client_info.username;
-
-    Player& client_player = client_info.player;
-    client_player.Respawn();
+    const std::string& username = clients.GetInfo()[index].username;
+    const Player& client_player = clients.GetPlayers()[index];
 
     Packet pckt{ PacketType::PlayerRespawn };
     pckt.Write(client);
@@ -111,7 +84,34 @@ void PlayerRespawn(const unsigned int client)
     pckt.Write(client_player.GetPosition());
     pckt.Write(client_player.GetScale());
 
-    ThreadPool::EnqueuePacketToSendToAll(pckt, 0);
+    // Other clients spawn the player once it is within their region of interest.
+    Room::GetCurrent().GetTransport().Send(pckt, client);
+}
+
+void PlayerSpawn(const unsigned int client, const unsigned int player_id)
+{
+    const ClientRegistry& clients = Room::GetCurrent().GetClients();
+    const size_t index = *clients.Find(player_id);
+
+    Packet pckt{ PacketType::PlayerSpawn };
+    pckt.Write(player_id);
+    pckt.Write(clients.GetInfo()[index].username);
+    pckt.Write(clients.GetPlayers()[index].GetPosition());
+    pckt.Write(clients.GetPlayers()[index].GetScale());
+
+    // The weapon rotation is only multicast to the clients which can already see the player,
+    // so a client which starts to see the player is given its current rotation here.
+    pckt.Write(clients.GetPlayers()[index].GetWeaponRotation());
+
+    Room::GetCurrent().GetTransport().Send(pckt, client);
+}
+
+void PlayerDespawn(const unsigned int client, const unsigned int player_id)
+{
+    Packet pckt{ PacketType::PlayerDespawn };
+    pckt.Write(player_id);
+
+    Room::GetCurrent().GetTransport().Send(pckt, client);
 }
 
 void PlayerWeaponRotation_Dispatch(const unsigned int client, const Player& player)
@@ -120,38 +120,39 @@ void PlayerWeaponRotation_Dispatch(const unsigned int client, const Player& play
     pckt.Write(client);
     pckt.Write(player.GetWeaponRotation());
 
-    // The player weapon rotation packet will be sent to all clients except
-    // the client associated with the player, as this is handled locally.
-    ThreadPool::EnqueuePacketToSendToAll(pckt, client);
+    // The player weapon rotation packet will be sent to the clients which can see the player,
+    // which never includes the client associated with the player, as this is handled locally.
+    Room::GetCurrent().GetTransport().Multicast(pckt, InterestManager::GetPlayerViewers(client));
 }
 
-void ProjectileUpdate(const Projectile& projectile)
+void ProjectileDestroy(const UUID projectile_id)
 {
-    Packet pckt{ PacketType::ProjectileUpdate };
-    pckt.Write(projectile.GetId());
-    pckt.Write(projectile.GetPosition());
-    pckt.Write(projectile.GetRotation());
+    Packet pckt{ PacketType::ProjectileDestroy };
+    pckt.Write(projectile_id);
 
-    ThreadPool::EnqueuePacketToSendToAll(pckt, 0);
+    Room::GetCurrent().GetTransport().Multicast(pckt, InterestManager::GetProjectileViewers(projectile_id));
 }
 
-void ProjectileDestroy(const Projectile& projectile)
+void SnapshotDelta_Dispatch(const unsigned int client, const std::vector<Packet>& fragments)
 {
-    Packet pckt{ PacketType::ProjectileDestroy };
-    pckt.Write(projectile.GetId());
+    const IClientTransport& transport = Room::GetCurrent().GetTransport();
 
-    ThreadPool::EnqueuePacketToSendToAll(pckt, 0);
+    for (const auto& fragment : fragments)
+        transport.Send(fragment, client);
 }
 
 void ChatMessageSend(const unsigned int client, const std::string& message)
 {
     const auto timestamp = std::chrono::system_clock::now();
-    const std::string& username = Server::GetClientInfoMap()[client].username;
+    Room& room = Room::GetCurrent();
+    const ClientRegistry& clients = room.GetClients();
+    const std::string& username = clients.GetInfo()[*clients.Find(client)].username;
 
     Packet pckt{ PacketType::ChatMessageInbound };
     pckt.Write(timestamp);
     pckt.Write(username);
     pckt.Write(message);
 
-    ThreadPool::EnqueuePacketToSendToAll(pckt, client);
+    // Chat messages are only seen by the clients in the same room as their author.
+    room.GetTransport().Multicast(pckt, room.GetConnections(), client);
 }
@@ -3,16 +3,18 @@
 #include <common/interface/ipacket_dispatcher.h>
 
 #include <string>
+#include <vector>
 
 class Server;
 class Packet;
 class Player;
-class Projectile;
+class UUID;
 
 /**
  * \brief Implementation of \code IPacketDispatcher\endcode for server-side packet dispatching.
+ * The benchmarks derive from it to run the thread pool without sending packets over the network.
  */
-class ServerPacketDispatcher final : public IPacketDispatcher
+class ServerPacketDispatcher : public IPacketDispatcher
 {
 public:
     explicit ServerPacketDispatcher(const Server* server);
@@ -30,14 +32,7 @@ public:
      * \param packet The packet which will be sent to the client.
      * \param client The client connection to which the packet will be sent.
      */
-    void SendToClient(const Packet& packet, unsigned int client) const;
-
-    /**
-     * \brief Wraps the server's \code SendToAllClients\endcode function to simplify behaviour.
-     * \param packet The packet which will be dispatched to each client.
-     * \param client The client connection to exclude from the transmission.
-     */
-    void SendToAllClients(const Packet& packet, unsigned int client) const;
+    virtual void SendToClient(const Packet& packet, unsigned int client) const;
 };
 
 /**
@@ -48,29 +43,21 @@ public:
 void Welcome(unsigned int client, const std::string& msg);
 
 /**
- * \brief Sends a new player message to all clients except \code client\endcode
- * to inform them that a new player has connected to the server.
+ * \brief Sends a new player message to the clients of the current room to inform them that a
+ * new player has joined the room.
  * \param client The client identifier associated with the new player.
  * \param username The connected player's username.
  */
 void PlayerConnected(unsigned int client, const std::string& username);
 
 /**
- * \brief Sends a message to all clients (except \code client\endcode) to indicate
- * that a player has disconnected.
+ * \brief Sends a message to the clients of the current room (except \code client\endcode) to
+ * indicate that a player has left the room.
  * \param client The client identifier associated with the player who disconnected.
  * \param username The username of the disconnected client.
  */
 void PlayerDisconnected(unsigned int client, const std::string& username);
 
-/**
- * \brief Sends a player movement packet to all clients to convey the position of
- * the given player.
- * \param client The client identifier associated with the player.
- * \param player The player.
- */
-void PlayerMovement(unsigned int client, const Player& player);
-
 /**
  * \brief Sends a player health update packet to a client to indicate that there has been an
  * update to their health.
@@ -80,41 +67,57 @@ void PlayerMovement(unsigned int client, const Player& player);
 void PlayerHealthUpdate(unsigned int client, const Player& player);
 
 /**
- * \brief Sends a player death packet to a client to indicate that the player has died.
+ * \brief Sends a player death packet to a client to indicate that its player has died.
  * \param client The client identifier associated with the player.
  */
 void PlayerDeath(unsigned int client);
 
 /**
- * \brief Sends a player respawn packet to a client to indicate that a player needs to be
+ * \brief Sends a player respawn packet to a client to indicate that its player has been
  * respawned.
  * \param client The client identifier associated with the player to be respawned.
  */
 void PlayerRespawn(unsigned int client);
 
 /**
- * \brief Sends a player weapon rotation packet to all clients (except the client associated
- * with the player).
+ * \brief Sends a player spawn packet to a client to indicate that a player has entered its
+ * region of interest, carrying the player's current weapon rotation.
+ * \param client The client to send the message to.
+ * \param player_id The client identifier associated with the player to spawn.
+ */
+void PlayerSpawn(unsigned int client, unsigned int player_id);
+
+/**
+ * \brief Sends a player despawn packet to a client to indicate that a player has left its
+ * region of interest, or the world.
+ * \param client The client to send the message to.
+ * \param player_id The client identifier associated with the player to despawn.
+ */
+void PlayerDespawn(unsigned int client, unsigned int player_id);
+
+/**
+ * \brief Sends a player weapon rotation packet to the clients which can see the player.
  * \param client The client identifier associated with the player.
  * \param player The player.
  */
 void PlayerWeaponRotation_Dispatch(unsigned int client, const Player& player);
 
 /**
- * \brief Sends a projectile update packet to all clients.
- * \param projectile The relevant projectile to update.
+ * \brief Sends a projectile destroy packet to the clients which can see the projectile.
+ * \param projectile_id The identifier of the projectile to destroy.
  */
-void ProjectileUpdate(const Projectile& projectile);
+void ProjectileDestroy(UUID projectile_id);
 
 /**
- * \brief Sends a projectile destroy packet to all clients.
- * \param projectile The relevant projectile to destroy.
+ * \brief Sends the fragments of a snapshot delta to a client.
+ * \param client The client to send the snapshot delta to.
+ * \param fragments The packets which hold the snapshot delta.
  */
-void ProjectileDestroy(const Projectile& projectile);
+void SnapshotDelta_Dispatch(unsigned int client, const std::vector<Packet>& fragments);
 
 /**
- * \brief Sends a chat message to every client but the client who's identifier
- * is specified.
+ * \brief Sends a chat message to every client of the current room but the client who's
+ * identifier is specified.
  * \param client The client identifier of the message author.
  * \param message The message to send.
  */
@@ -1,63 +1,59 @@
 #include "server_packet_handler.h"
-#include "server_packet_dispatcher.h"
-#include "game.h"
-#include "server.h"
+#include "room_manager.h"
 
-#include <common/utils/logging.h>
+#include <string>
+#include <utility>
 
 void WelcomeReceived(const unsigned int client_id, Packet& packet, const IPacketDispatcher* dispatcher = nullptr)
 {
     std::string username;
     packet.Read(username);
 
-    SCX_CORE_INFO("Client has connected with username: {0}", username);
-
-    ClientInfo& client_info = Server::GetClientInfoMap()[client_id];
-
-    client_info.username = username;
-    client_info.player.SetId(client_id);
-
-    Game::SpawnPlayer(client_info.player);
-
-    PlayerConnected(client_id, username);
+    // The client joins the game once it has been given a room.
+    RoomManager::AssignClient(client_id, std::move(username));
 }
 
 void PlayerInput(const unsigned int client_id, Packet& packet, const IPacketDispatcher* dispatcher = nullptr)
 {
-    bool inputs[4]{};
-    packet.Read(inputs[0]); // W key pressed down
-    packet.Read(inputs[1]); // A key pressed
-    packet.Read(inputs[2]); // D key pressed
-    packet.Read(inputs[3]); // Left mouse button pressed.
-
-    Player& client_player = Server::GetClientInfoMap()[client_id].player;
+    GameCommand command{ .type = GameCommand::Type::Input, .client_id = client_id };
+    packet.Read(command.inputs[0]); // W key pressed down
+    packet.Read(command.inputs[1]); // A key pressed
+    packet.Read(command.inputs[2]); // D key pressed
+    packet.Read(command.inputs[3]); // Left mouse button pressed.
 
-    client_player.ProcessInput(inputs[0], inputs[1], inputs[2], inputs[3]);
+    RoomManager::EnqueueCommand(std::move(command));
 }
 
 void PlayerWeaponRotation(const unsigned int client_id, Packet& packet, const IPacketDispatcher* dispatcher = nullptr)
 {
-    float rotation;
-    packet.Read(rotation);
-
-    Player& client_player = Server::GetClientInfoMap()[client_id].player;
+    GameCommand command{ .type = GameCommand::Type::WeaponRotation, .client_id = client_id };
+    packet.Read(command.weapon_rotation);
 
-    client_player.SetWeaponRotation(rotation);
-
-    PlayerWeaponRotation_Dispatch(client_id, client_player);
+    RoomManager::EnqueueCommand(std::move(command));
 }
 
 void PlayerRespawnRequest(const unsigned int client_id, Packet& packet, const IPacketDispatcher* dispatcher = nullptr)
 {
-    PlayerRespawn(client_id);
+    RoomManager::EnqueueCommand({ .type = GameCommand::Type::Respawn, .client_id = client_id });
 }
 
 void ChatMessageReceive(const unsigned int client_id, Packet& packet, const IPacketDispatcher* dispatcher)
 {
-    std::string message;
-    packet.Read(message);
+    // The chat message is sent from the room's tick thread, which owns the sender's username.
+    GameCommand command{ .type = GameCommand::Type::ChatMessage, .client_id = client_id };
+    packet.Read(command.text);
+
+    RoomManager::EnqueueCommand(std::move(command));
+}
+
+void SnapshotAck(const unsigned int client_id, Packet& packet, const IPacketDispatcher* dispatcher = nullptr)
+{
+    // A truncated acknowledgement carries no sequence, so it is dropped.
+    uint32_t sequence = 0;
+    if (packet.Read(sequence) != PacketCode_Success)
+        return;
 
-    ChatMessageSend(client_id, message);
+    RoomManager::Acknowledge(client_id, sequence);
 }
 
 ServerPacketHandler::ServerPacketHandler()
@@ -70,6 +66,7 @@ ServerPacketHandler::ServerPacketHandler()
         { PacketType::PlayerInput, &PlayerInput },
         { PacketType::PlayerWeaponRotation, &PlayerWeaponRotation },
         { PacketType::PlayerRespawnRequest, &PlayerRespawnRequest },
-        { PacketType::ChatMessageOutbound, &ChatMessageReceive }
+        { PacketType::ChatMessageOutbound, &ChatMessageReceive },
+        { PacketType::SnapshotAck, &SnapshotAck }
     };
 }
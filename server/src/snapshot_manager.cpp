@@ -0,0 +1,150 @@
+#include "snapshot_manager.h"
+
+#include "game.h"
+#include "interest_manager.h"
+#include "room.h"
+#include "server_packet_dispatcher.h"
+
+#include <mutex>
+#include <span>
+#include <vector>
+
+SnapshotManager::SnapshotManager()
+    : m_sequence{ 0 }
+{
+}
+
+void SnapshotManager::Update()
+{
+    const uint32_t sequence = Get().m_sequence.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    const WorldSnapshot world = Capture(sequence);
+    InterestManager::Update(world);
+
+    std::vector<Packet> fragments;
+
+    const ClientRegistry& clients = Room::GetCurrent().GetClients();
+    const std::span client_info = clients.GetInfo();
+    const std::span players = clients.GetPlayers();
+
+    for (size_t i = 0; i < client_info.size(); i++)
+    {
+        const HSteamNetConnection client_id = client_info[i].connection;
+
+        ClientSnapshots& client = GetClient(client_id);
+        const WorldSnapshot* baseline = FindBaseline(client);
+
+        // Each client only remembers the part of the world which is relevant to it, so deltas
+        // are computed between the client's own snapshots.
+        WorldSnapshot& snapshot = client.history[sequence % SNAPSHOT_HISTORY];
+        snapshot = InterestManager::GetView(client_id, world);
+
+        SnapshotDelta delta = ComputeSnapshotDelta(baseline, snapshot);
+
+        // A delta which is too large to send is cut down to the entities nearest the client's
+        // player. The client only reconstructs what was sent, and the rest is sent by the deltas
+        // against this snapshot once it has been acknowledged.
+        if (LimitSnapshotDelta(delta, players[i].GetPosition()))
+        {
+            snapshot = baseline ? *baseline : WorldSnapshot{};
+            ApplySnapshotDelta(delta, snapshot);
+        }
+
+        fragments.clear();
+        WriteSnapshotDelta(delta, fragments);
+
+        SnapshotDelta_Dispatch(client_id, fragments);
+    }
+}
+
+void SnapshotManager::Acknowledge(const unsigned int client_id, const uint32_t sequence)
+{
+    // A snapshot which has not been sent cannot have been reconstructed, and would otherwise
+    // be taken as a baseline the client does not have.
+    if (sequence > Get().m_sequence.load(std::memory_order_relaxed))
+        return;
+
+    std::shared_lock clients_lock{ Get().m_clients_guard };
+
+    const auto it = Get().m_clients.find(client_id);
+    if (it == Get().m_clients.end())
+        return;
+
+    // Acknowledgements are sent unreliably, so they may arrive out of order.
+    std::atomic<uint32_t>& acknowledged = it->second->acknowledged;
+
+    uint32_t current = acknowledged.load(std::memory_order_relaxed);
+    while (sequence > current && !acknowledged.compare_exchange_weak(current, sequence, std::memory_order_relaxed))
+    {
+    }
+}
+
+void SnapshotManager::RemoveClient(const unsigned int client_id)
+{
+    std::unique_lock clients_lock{ Get().m_clients_guard };
+    Get().m_clients.erase(client_id);
+}
+
+SnapshotManager& SnapshotManager::Get()
+{
+    return Room::GetCurrent().GetSnapshots();
+}
+
+WorldSnapshot SnapshotManager::Capture(const uint32_t sequence)
+{
+    WorldSnapshot snapshot{};
+    snapshot.sequence = sequence;
+
+    for (const Player& player : Room::GetCurrent().GetClients().GetPlayers())
+    {
+        // A player's identifier is its client's connection, which is only assigned once the
+        // client has joined.
+        if (player.GetId() != 0 && player.GetCurrentHealth() > 0)
+            snapshot.players.push_back({ .id = player.GetId(), .position = player.GetPosition() });
+    }
+
+    const ProjectilePool& projectiles = Game::GetProjectiles();
+
+    const std::span ids = projectiles.GetIds();
+    const std::span positions = projectiles.GetPositions();
+    const std::span rotations = projectiles.GetRotations();
+
+    snapshot.projectiles.reserve(projectiles.GetSize());
+    for (size_t i = 0; i < projectiles.GetSize(); i++)
+        snapshot.projectiles.push_back({ .id = ids[i], .position = positions[i], .rotation = rotations[i] });
+
+    SortSnapshot(snapshot);
+
+    return snapshot;
+}
+
+SnapshotManager::ClientSnapshots& SnapshotManager::GetClient(const unsigned int client_id)
+{
+    {
+        std::shared_lock clients_lock{ Get().m_clients_guard };
+
+        const auto it = Get().m_clients.find(client_id);
+        if (it != Get().m_clients.end())
+            return *it->second;
+    }
+
+    std::unique_lock clients_lock{ Get().m_clients_guard };
+
+    auto& client = Get().m_clients[client_id];
+    if (!client)
+        client = std::make_unique<ClientSnapshots>();
+
+    return *client;
+}
+
+const WorldSnapshot* SnapshotManager::FindBaseline(const ClientSnapshots& client)
+{
+    const uint32_t acknowledged = client.acknowledged.load(std::memory_order_relaxed);
+
+    // The client only remembers the most recent snapshots, so an older acknowledgement
+    // cannot be used as a baseline.
+    if (acknowledged == 0 || Get().m_sequence.load(std::memory_order_relaxed) - acknowledged >= SNAPSHOT_HISTORY)
+        return nullptr;
+
+    return &client.history[acknowledged % SNAPSHOT_HISTORY];
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <common/networking/snapshot.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+
+/**
+ * \brief A data structure to replicate the state of a room's world to its clients. Its static
+ * functions act on the snapshot manager of the calling thread's current room.
+ *
+ * Each tick a snapshot of the world is captured and filtered down to the entities which are
+ * relevant to each client. Every client is sent the delta between its filtered snapshot and
+ * the most recent one it has acknowledged, so entities which have not changed since then cost
+ * nothing to replicate.
+ */
+class SnapshotManager
+{
+public:
+    SnapshotManager(const SnapshotManager&) = delete;
+    SnapshotManager& operator=(const SnapshotManager&) = delete;
+
+    SnapshotManager(SnapshotManager&&) noexcept = delete;
+    SnapshotManager& operator=(SnapshotManager&&) noexcept = delete;
+
+    /**
+     * \brief Captures a snapshot of the world, updates the interest of each client and sends
+     * each client its delta.
+     */
+    static void Update();
+
+    /**
+     * \brief Records that a client has reconstructed a snapshot, so that it can be used as
+     * the baseline of the client's next delta. Acknowledgements of snapshots which have not
+     * been sent yet are ignored. May be called from any thread whose current room is the
+     * client's room.
+     * \param client_id The identifier of the client.
+     * \param sequence The sequence of the snapshot which was acknowledged.
+     */
+    static void Acknowledge(unsigned int client_id, uint32_t sequence);
+
+    /**
+     * \brief Forgets the snapshots of a client which has disconnected.
+     * \param client_id The identifier of the client.
+     */
+    static void RemoveClient(unsigned int client_id);
+
+private:
+    /**
+     * \brief The snapshots which have been sent to a client.
+     */
+    struct ClientSnapshots
+    {
+        std::atomic<uint32_t> acknowledged{ 0 };
+        WorldSnapshot history[SNAPSHOT_HISTORY];
+    };
+
+    /**
+     * \brief The sequence of the latest snapshot, which is advanced by the room's tick thread
+     * and read by the threads which acknowledge snapshots.
+     */
+    std::atomic<uint32_t> m_sequence;
+
+    std::unordered_map<unsigned int, std::unique_ptr<ClientSnapshots>> m_clients;
+    std::shared_mutex m_clients_guard;
+
+    SnapshotManager();
+    ~SnapshotManager() = default;
+
+    static SnapshotManager& Get();
+
+    /**
+     * \brief Captures the current state of the projectiles and of the players which are in
+     * the world, which are those that have joined and are alive.
+     * \param sequence The sequence of the new snapshot.
+     * \return The snapshot of the world.
+     */
+    static WorldSnapshot Capture(uint32_t sequence);
+
+    /**
+     * \brief Gets the snapshots which have been sent to a client, creating them for a client
+     * which has not been sent any.
+     * \param client_id The identifier of the client.
+     * \return The client's snapshots.
+     */
+    static ClientSnapshots& GetClient(unsigned int client_id);
+
+    /**
+     * \brief Gets the snapshot a client's next delta should be relative to.
+     * \param client The snapshots which have been sent to the client.
+     * \return The client's most recently acknowledged snapshot, or \code nullptr\endcode if
+     * it has not acknowledged one which is still remembered.
+     */
+    static const WorldSnapshot* FindBaseline(const ClientSnapshots& client);
+
+    friend class Room;
+};
@@ -3,229 +3,342 @@
 #include <common/utils/logging.h>
 
 #include <algorithm>
+#include <functional>
 #include <ranges>
 #include <thread>
 
-#include "server.h"
+/**
+ * \brief The index of the worker running on the current thread, or -1 if the current
+ * thread is not a worker.
+ */
+static thread_local int s_current_worker = -1;
 
-void PollPackets(const UUID id, const ServerPacketHandler& packet_handler,
-                    const ServerPacketDispatcher& packet_dispatcher)
+ThreadPool ThreadPool::s_instance;
+
+ThreadPool::ThreadPool()
+    : m_is_running{ false },
+      m_next_home_worker{ 0 }
 {
-    SCX_CORE_INFO("Thread {0} has been started!", static_cast<uint64_t>(id));
+}
 
-    while (true)
-    {
-        const ThreadState state = ThreadPool::GetThreadState(id);
+ThreadPool& ThreadPool::Get()
+{
+    return s_instance;
+}
 
-        if (state == ThreadState::WaitingForWork)
-        {
-            // Don't do any processing when a thread is in a waiting for work state.
-            continue;
-        }
+void ThreadPool::Initialise(const ServerPacketHandler& handler, const ServerPacketDispatcher& dispatcher,
+                            unsigned int thread_count)
+{
+    if (thread_count == 0)
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
 
-        if (state == ThreadState::Working)
-        {
-            // Handle client-related processing here.
-            auto packet_info_to_send = ThreadPool::DequeuePacketToSend(id);
-            if (packet_info_to_send.has_value())
-            {
-                Packet& packet = packet_info_to_send.value().packet;
-                const unsigned int client_id = packet_info_to_send.value().to_client;
-
-                packet_dispatcher.SendToClient(packet, client_id);
-            }
-
-            auto packet_info_to_handle = ThreadPool::DequeuePacketToHandle(id);
-            if (packet_info_to_handle.has_value())
-            {
-                const unsigned int client_id = packet_info_to_handle.value().from_client;
-                Packet& packet = packet_info_to_handle.value().packet;
-
-                packet_handler.Handle(client_id, packet, &packet_dispatcher);
-            }
-        }
+    // Create every worker before starting any thread so that the workers can steal from
+    // one another as soon as they start.
+    for (unsigned int i = 0; i < thread_count; i++)
+        Get().m_workers.push_back(std::make_unique<Worker>());
 
-        if (state == ThreadState::Done)
-            break;
-    }
+    Get().m_is_running = true;
 
-    SCX_CORE_INFO("Thread {0} has been terminated!", static_cast<uint64_t>(id));
-}
+    for (unsigned int id = 0; id < thread_count; id++)
+        Get().m_workers[id]->handle = std::thread{ RunWorker, id, std::cref(handler), std::cref(dispatcher) };
 
-ThreadPool ThreadPool::s_instance;
+    SCX_CORE_INFO("Thread pool initialised with {0} worker threads.", thread_count);
+}
 
-ThreadPool::ThreadPool()
+void ThreadPool::OpenStrand(const unsigned int client_id)
 {
-    m_threads_available = std::min(MAX_THREADS, std::thread::hardware_concurrency());
+    auto strand = std::make_shared<Strand>();
+    strand->client_id = client_id;
+
+    std::unique_lock strands_lock{ Get().m_strands_guard };
+
+    // Spread the strands across the workers, idle workers will steal them if this
+    // leaves a worker with more than its share of work.
+    strand->home_worker = Get().m_next_home_worker++ % GetThreadCount();
+
+    Get().m_strands[client_id] = std::move(strand);
 }
 
-ThreadPool& ThreadPool::Get()
+void ThreadPool::CloseStrand(const unsigned int client_id)
 {
-    return s_instance;
-}
+    std::unique_lock strands_lock{ Get().m_strands_guard };
 
+    const auto it = Get().m_strands.find(client_id);
 
-void ThreadPool::Initialise(const ServerPacketHandler& handler, const ServerPacketDispatcher& dispatcher)
-{
-    for (unsigned int i = 0; i < Get().m_threads_available; i++)
+    if (it == Get().m_strands.end())
     {
-        UUID uuid{};
-
-        Get().m_pool[uuid] = {
-            .handle = std::thread{ PollPackets, uuid, handler, dispatcher },
-            .state = ThreadState::WaitingForWork
-        };
+        SCX_CORE_ERROR("Could not find a strand for client {0} in the thread pool.", client_id);
+        return;
     }
+
+    // A worker may still hold the strand, so mark it as closed to stop it from processing
+    // any more of its packets.
+    it->second->is_closed = true;
+    Get().m_strands.erase(it);
 }
 
-UUID ThreadPool::AllocateThread()
+void ThreadPool::EnqueuePacketsToHandle(const std::span<PacketInfoFromClient> packet_infos,
+                                        const unsigned int client_id)
 {
-    for (auto& [id, thread] : Get().m_pool)
-    {
-        if (thread.state == ThreadState::WaitingForWork)
-        {
-            SCX_CORE_INFO("Allocated thread {0} for processing.", static_cast<uint64_t>(id));
+    const auto strand = FindStrand(client_id);
 
-            thread.state = ThreadState::Working;
-            return id;
-        }
-    }
+    if (!strand)
+        return;
+
+    const size_t pushed = strand->handling_queue.TryPushBatch(packet_infos.data(), packet_infos.size());
 
-    SCX_CORE_ERROR("No threads available for allocation.");
+    if (pushed < packet_infos.size())
+    {
+        SCX_CORE_WARN("Handling queue is full, dropping {0} packets from client {1}.",
+                      packet_infos.size() - pushed, client_id);
+    }
 
-    return UUID{ 0 };
+    if (pushed > 0)
+        NotifyPending(strand, static_cast<uint32_t>(pushed));
 }
 
-void ThreadPool::TerminateThread(const UUID id)
+void ThreadPool::EnqueuePacketToSend(Packet packet, const unsigned int client_id)
 {
-    const auto it = Get().m_pool.find(id);
+    const auto strand = FindStrand(client_id);
+
+    if (!strand)
+        return;
 
-    if (it == Get().m_pool.end())
+    if (!strand->dispatching_queue.TryPush({ .to_client = client_id, .packet = std::move(packet) }))
     {
-        SCX_CORE_ERROR("Could not find thread with ID {0} in the thread pool.", static_cast<uint64_t>(id));
+        SCX_CORE_WARN("Dispatching queue is full, dropping packet to client {0}.", client_id);
         return;
     }
 
-    SCX_CORE_INFO("Terminating thread {0} for processing.", static_cast<uint64_t>(id));
+    NotifyPending(strand);
+}
 
-    auto& state = it->second.state;
-    state = ThreadState::WaitingForWork;
+unsigned int ThreadPool::GetThreadCount()
+{
+    return static_cast<unsigned int>(Get().m_workers.size());
 }
 
-void ThreadPool::EnqueuePacketToHandle(const Packet& packet, const unsigned int client_id)
+std::vector<WorkerStats> ThreadPool::GetWorkerStats()
 {
-    std::unique_lock guard_lock{ Get().m_handle_guard };
+    std::vector<WorkerStats> stats;
+    stats.reserve(Get().m_workers.size());
 
-    const UUID thread_id = Server::GetClientThreadMap()[client_id];
+    for (unsigned int id = 0; id < Get().m_workers.size(); id++)
+    {
+        const Worker& worker = *Get().m_workers[id];
+
+        stats.push_back({
+            .id = id, .run_queue_depth = worker.run_queue_depth.load(std::memory_order_relaxed),
+            .is_parked = worker.is_parked.load(std::memory_order_relaxed)
+        });
+    }
 
-    const auto it = Get().m_pool.find(thread_id);
+    return stats;
+}
+
+void ThreadPool::Dispose()
+{
+    Get().m_is_running = false;
 
-    if (it == Get().m_pool.end())
+    for (const auto& worker : Get().m_workers)
     {
-        SCX_CORE_ERROR("Could not find thread with ID {0} in the thread pool.", static_cast<uint64_t>(thread_id));
-        return;
+        // Wake each worker so it can observe that the pool is stopping, then wait for it to terminate.
+        Wake(*worker);
+        worker->handle.join();
     }
 
-    const PacketInfoFromClient new_packet_info{
-        .from_client = client_id,
-        .packet = packet
-    };
+    Get().m_workers.clear();
 
-    auto& queue = it->second.handling_queue;
-    queue.push(new_packet_info);
+    std::unique_lock strands_lock{ Get().m_strands_guard };
+    Get().m_strands.clear();
 }
 
-std::optional<PacketInfoFromClient> ThreadPool::DequeuePacketToHandle(const UUID id)
+void ThreadPool::RunWorker(const unsigned int id, const ServerPacketHandler& handler,
+                           const ServerPacketDispatcher& dispatcher)
 {
-    std::unique_lock guard_lock{ Get().m_handle_guard };
+    SCX_CORE_INFO("Thread {0} has been started!", id);
 
-    const auto it = Get().m_pool.find(id);
+    s_current_worker = static_cast<int>(id);
 
-    if (it == Get().m_pool.end())
+    while (Get().m_is_running)
     {
-        SCX_CORE_ERROR("Could not find thread with ID {0} in the thread pool.", static_cast<uint64_t>(id));
-        return std::nullopt;
+        const auto strand = FindWork(id);
+
+        if (strand)
+            RunStrand(strand, handler, dispatcher);
+        else
+            WaitForWork(id);
     }
 
-    auto& queue = it->second.handling_queue;
+    SCX_CORE_INFO("Thread {0} has been terminated!", id);
+}
+
+void ThreadPool::RunStrand(const std::shared_ptr<Strand>& strand, const ServerPacketHandler& handler,
+                           const ServerPacketDispatcher& dispatcher)
+{
+    // Packets are moved out of the queues into these, so no allocation or copying of
+    // optional values is needed per packet.
+    PacketInfoToClient packet_info_to_send{};
+    PacketInfoFromClient packet_info_to_handle{};
+
+    const bool is_closed = strand->is_closed;
+
+    uint32_t processed = 0;
+    while (processed < STRAND_BATCH_SIZE)
+    {
+        bool has_processed = false;
+
+        if (strand->dispatching_queue.TryPop(packet_info_to_send))
+        {
+            if (!is_closed)
+                dispatcher.SendToClient(packet_info_to_send.packet, packet_info_to_send.to_client);
+
+            has_processed = true;
+            processed++;
+        }
+
+        if (strand->handling_queue.TryPop(packet_info_to_handle))
+        {
+            if (!is_closed)
+                handler.Handle(packet_info_to_handle.from_client, packet_info_to_handle.packet, &dispatcher);
 
-    if (queue.empty())
-        return std::nullopt;
+            has_processed = true;
+            processed++;
+        }
+
+        if (!has_processed)
+            break;
+    }
 
-    PacketInfoFromClient value = queue.front();
-    queue.pop();
+    // If packets were enqueued while the strand was running it must run again. Otherwise it
+    // is now idle, and the next enqueue will schedule it.
+    if (strand->pending.fetch_sub(processed, std::memory_order_acq_rel) != processed)
+        Schedule(strand);
+}
 
-    return std::make_optional<PacketInfoFromClient>(value);
+void ThreadPool::NotifyPending(const std::shared_ptr<Strand>& strand, const uint32_t count)
+{
+    if (strand->pending.fetch_add(count, std::memory_order_acq_rel) == 0)
+        Schedule(strand);
 }
 
-void ThreadPool::EnqueuePacketToSend(const Packet& packet, const unsigned int client_id)
+void ThreadPool::Schedule(const std::shared_ptr<Strand>& strand)
 {
-    std::unique_lock guard_lock{ Get().m_dispatch_guard };
+    auto& workers = Get().m_workers;
 
-    const UUID thread_id = Server::GetClientThreadMap()[client_id];
+    // Strands scheduled from a worker stay on that worker, those scheduled from elsewhere
+    // go to their home worker.
+    const unsigned int target = s_current_worker >= 0 ? static_cast<unsigned int>(s_current_worker)
+                                                      : strand->home_worker;
+    Worker& worker = *workers[target];
 
-    const auto it = Get().m_pool.find(thread_id);
+    {
+        std::unique_lock run_queue_lock{ worker.run_queue_guard };
+        worker.run_queue.push_back(strand);
+        worker.run_queue_depth.store(worker.run_queue.size(), std::memory_order_relaxed);
+    }
 
-    if (it == Get().m_pool.end())
+    if (worker.is_parked.load(std::memory_order_acquire))
     {
-        SCX_CORE_ERROR("Could not find thread with ID {0} in the thread pool.", static_cast<uint64_t>(thread_id));
+        Wake(worker);
         return;
     }
 
-    const PacketInfoToClient new_packet_info{
-        .to_client = client_id,
-        .packet = packet
-    };
-
-    auto& queue = it->second.dispatching_queue;
-    queue.push(new_packet_info);
+    // The target worker is busy, so wake a parked worker to steal the strand.
+    for (const auto& other : workers)
+    {
+        if (other->is_parked.load(std::memory_order_acquire))
+        {
+            Wake(*other);
+            return;
+        }
+    }
 }
 
-void ThreadPool::EnqueuePacketToSendToAll(const Packet& packet, const unsigned int except)
+std::shared_ptr<ThreadPool::Strand> ThreadPool::FindWork(const unsigned int id)
 {
-    for (const auto& client_id : Server::GetClientThreadMap() | std::views::keys)
+    auto& workers = Get().m_workers;
+
+    {
+        Worker& worker = *workers[id];
+
+        std::unique_lock run_queue_lock{ worker.run_queue_guard };
+        if (!worker.run_queue.empty())
+        {
+            auto strand = std::move(worker.run_queue.front());
+            worker.run_queue.pop_front();
+            worker.run_queue_depth.store(worker.run_queue.size(), std::memory_order_relaxed);
+            return strand;
+        }
+    }
+
+    // Steal from the back of the other workers' run queues, starting with the next worker
+    // so that thieves spread out over their victims.
+    const auto worker_count = static_cast<unsigned int>(workers.size());
+    for (unsigned int offset = 1; offset < worker_count; offset++)
     {
-        if (client_id == except)
-            continue;
+        Worker& victim = *workers[(id + offset) % worker_count];
 
-        EnqueuePacketToSend(packet, client_id);
+        std::unique_lock run_queue_lock{ victim.run_queue_guard, std::try_to_lock };
+        if (run_queue_lock.owns_lock() && !victim.run_queue.empty())
+        {
+            auto strand = std::move(victim.run_queue.back());
+            victim.run_queue.pop_back();
+            victim.run_queue_depth.store(victim.run_queue.size(), std::memory_order_relaxed);
+            return strand;
+        }
     }
+
+    return nullptr;
 }
 
-std::optional<PacketInfoToClient> ThreadPool::DequeuePacketToSend(const UUID id)
+void ThreadPool::WaitForWork(const unsigned int id)
 {
-    std::unique_lock guard_lock{ Get().m_dispatch_guard };
+    Worker& worker = *Get().m_workers[id];
+
+    std::unique_lock wakeup_lock{ worker.wakeup_guard };
 
-    const auto it = Get().m_pool.find(id);
+    worker.is_parked.store(true, std::memory_order_release);
 
-    if (it == Get().m_pool.end())
+    // Check the run queue again now that the worker is visibly parked, since a strand may
+    // have been scheduled on it without a wakeup in the meantime.
+    bool has_scheduled_strand;
     {
-        SCX_CORE_ERROR("Could not find thread with ID {0} in the thread pool.", static_cast<uint64_t>(id));
-        return std::nullopt;
+        std::unique_lock run_queue_lock{ worker.run_queue_guard };
+        has_scheduled_strand = !worker.run_queue.empty();
     }
 
-    auto& queue = it->second.dispatching_queue;
+    if (!has_scheduled_strand)
+        worker.wakeup.wait(wakeup_lock, [&worker] { return worker.has_work.load(std::memory_order_acquire); });
 
-    if (queue.empty())
-        return std::nullopt;
-
-    PacketInfoToClient value = queue.front();
-    queue.pop();
-
-    return std::make_optional<PacketInfoToClient>(value);
+    // Any work scheduled after this point will set the flag again, so none can be missed.
+    worker.has_work.store(false, std::memory_order_release);
+    worker.is_parked.store(false, std::memory_order_release);
 }
 
-ThreadState ThreadPool::GetThreadState(const UUID id)
+void ThreadPool::Wake(Worker& worker)
 {
-    return Get().m_pool[id].state;
+    // Only the first wake of a parked worker needs to take the lock, later ones are
+    // picked up when the worker next looks for work.
+    if (worker.has_work.exchange(true, std::memory_order_acq_rel))
+        return;
+
+    { std::unique_lock wakeup_lock{ worker.wakeup_guard }; }
+
+    worker.wakeup.notify_one();
 }
 
-void ThreadPool::Dispose()
+std::shared_ptr<ThreadPool::Strand> ThreadPool::FindStrand(const unsigned int client_id)
 {
-    for (auto& thread : Get().m_pool | std::views::values)
+    std::shared_lock strands_lock{ Get().m_strands_guard };
+
+    const auto it = Get().m_strands.find(client_id);
+
+    if (it == Get().m_strands.end())
     {
-        // Mark each thread as done and wait for each them to terminate.
-        thread.state = ThreadState::Done;
-        thread.handle.join();
+        SCX_CORE_ERROR("Could not find a strand for client {0} in the thread pool.", client_id);
+        return nullptr;
     }
+
+    return it->second;
 }
@@ -1,30 +1,51 @@
 #pragma once
 
+#include "ring_buffer.h"
 #include "server_packet_handler.h"
 #include "server_packet_dispatcher.h"
 
 #include <common/networking/packet.h>
 
-#include <common/utils/uuid.h>
-
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
 #include <mutex>
-#include <optional>
-#include <queue>
+#include <shared_mutex>
+#include <span>
 #include <thread>
 #include <unordered_map>
+#include <vector>
+
+constexpr size_t HANDLING_QUEUE_CAPACITY = 256,
+                 DISPATCHING_QUEUE_CAPACITY = 1024;
 
-constexpr unsigned int MAX_THREADS = 4;
+/**
+ * \brief The maximum number of packets a worker processes from a strand before
+ * rescheduling it, so that a busy client cannot starve the others on the same worker.
+ */
+constexpr uint32_t STRAND_BATCH_SIZE = 64;
 
-enum class ThreadState
+/**
+ * \brief A snapshot of the load of a worker thread.
+ */
+struct WorkerStats
 {
-    WaitingForWork,
-    Working,
-    Done
+    unsigned int id;
+    // The number of strands waiting on the worker's run queue.
+    size_t run_queue_depth;
+    bool is_parked;
 };
 
 /**
  * \brief A data structure implemented as a singleton pattern to manage a collection
  * of reusable threads.
+ *
+ * Each client connection is represented by a strand: a pair of packet queues which are
+ * processed serially, so the packets of a client are always handled and sent in order.
+ * Any number of strands are multiplexed over a fixed number of worker threads. A strand
+ * with pending packets is scheduled onto a worker's run queue, and idle workers steal
+ * strands from the run queues of busy ones.
  */
 class ThreadPool
 {
@@ -36,69 +57,56 @@ public:
     ThreadPool& operator=(ThreadPool&&) noexcept = delete;
 
     /**
-     * \brief Initialises each of the threads to be managed by the thread pool.
-     * It specifies the initial state and active status of each created thread.
+     * \brief Initialises each of the worker threads to be managed by the thread pool.
+     * \param handler The packet handler used to process incoming packets, which must outlive
+     * the pool.
+     * \param dispatcher The packet dispatcher used to send outgoing packets, which must outlive
+     * the pool.
+     * \param thread_count The number of worker threads. If 0, the hardware concurrency
+     * of the machine is used.
      */
-    static void Initialise(const ServerPacketHandler& handler, const ServerPacketDispatcher& dispatcher);
+    static void Initialise(const ServerPacketHandler& handler, const ServerPacketDispatcher& dispatcher,
+                           unsigned int thread_count = 0);
 
     /**
-     * \brief Allocates a thread to be used for processing.
-     * \return The identifier for the allocated thread.
+     * \brief Creates the strand used to process the packets of a client.
+     * \param client_id The identifier of the client.
      */
-    static UUID AllocateThread();
+    static void OpenStrand(unsigned int client_id);
 
     /**
-     * \brief Terminates a thread to end its processing.
+     * \brief Removes the strand of a client. Packets which are still queued are discarded.
+     * \param client_id The identifier of the client.
      */
-    static void TerminateThread(UUID id);
+    static void CloseStrand(unsigned int client_id);
 
     /**
-     * \brief Adds a packet to a queue of packets awaiting to be processed by a given
-     * thread.
-     * \param client_id The identifier of the client from which the packet came from.
-     * \param packet The packet to be processed.
+     * \brief Adds a batch of packets from the same client to the queue of packets awaiting to
+     * be processed on its strand, in a single push. Must only be called from the thread polling
+     * for incoming messages.
+     * \param packet_infos The packets to be processed, which are moved from.
+     * \param client_id The identifier of the client from which the packets came from.
      */
-    static void EnqueuePacketToHandle(const Packet& packet, unsigned int client_id);
+    static void EnqueuePacketsToHandle(std::span<PacketInfoFromClient> packet_infos, unsigned int client_id);
 
     /**
-     * \brief Removes and retrieves the next packet from the queue of packets awaiting
-     * to be processed, if one exists.
-     * \param id The identifier of the thread that will process the next packet.
-     * \return An optional packet information value.
-     */
-    static std::optional<PacketInfoFromClient> DequeuePacketToHandle(UUID id);
-
-    /**
-     * \brief Adds a packet to a queue of packets awaiting to be sent by a given thread
-     * to its respective client.
+     * \brief Adds a packet to a queue of packets awaiting to be sent on a client's strand.
      * \param packet The packet to be sent.
      * \param client_id An identifier of the client in which to send the packet to.
      */
-    static void EnqueuePacketToSend(const Packet& packet, unsigned int client_id);
+    static void EnqueuePacketToSend(Packet packet, unsigned int client_id);
 
     /**
-     * \brief Adds a packet to a queue of packets awaiting to sent by each client thread, unless
-     * \code except\endcode is specified, in which case this client will be excluded.
-     * \param packet The packet to be sent.
-     * \param except The client to be excluded from packet transmission. If left to be 0, no clients will
-     * be excluded.
+     * \brief Gets the number of worker threads in the pool.
+     * \return The number of worker threads.
      */
-    static void EnqueuePacketToSendToAll(const Packet& packet, unsigned int except = 0);
+    static unsigned int GetThreadCount();
 
     /**
-     * \brief Removes and retrieves the next packlet from the queue of packets awaiting
-     * to be sent, if one exists.
-     * \param id The identifier of the thread that will process the next packet.
-     * \return An optional packet information value.
+     * \brief Gets a snapshot of the load of each worker. May be called from any thread, and
+     * never blocks the workers.
      */
-    static std::optional<PacketInfoToClient> DequeuePacketToSend(UUID id);
-
-    /**
-     * \brief Gets the state of the thread with the given identifier.
-     * \param id The identifier of the thread.
-     * \return The current state of the thread.
-     */
-    static ThreadState GetThreadState(UUID id);
+    static std::vector<WorkerStats> GetWorkerStats();
 
     /**
      * \brief Gracefully terminate each thread which exists within the pool.
@@ -107,27 +115,106 @@ public:
 
 private:
     /**
-     * \brief Represents a thread as an object with a state and activity status.
-     * Typically, C++ threads do not have associated members, but this allows us
-     * to provide them.
+     * \brief The packet queues of a single client, processed by at most one worker at a time.
+     */
+    struct Strand
+    {
+        unsigned int client_id{ 0 };
+        unsigned int home_worker{ 0 };
+        SpscRingBuffer<PacketInfoFromClient, HANDLING_QUEUE_CAPACITY> handling_queue;
+        MpscRingBuffer<PacketInfoToClient, DISPATCHING_QUEUE_CAPACITY> dispatching_queue;
+
+        /**
+         * \brief The number of packets enqueued but not yet processed. The producer which
+         * raises it from zero schedules the strand, and the worker which lowers it back to
+         * zero leaves it unscheduled, so a strand is never on more than one run queue.
+         */
+        std::atomic<uint32_t> pending{ 0 };
+        std::atomic<bool> is_closed{ false };
+    };
+
+    /**
+     * \brief Represents a worker thread with its own run queue of scheduled strands.
      */
-    struct Thread
+    struct Worker
     {
         std::thread handle;
-        ThreadState state{ ThreadState::WaitingForWork };
-        std::queue<PacketInfoToClient> dispatching_queue{};
-        std::queue<PacketInfoFromClient> handling_queue{};
+        std::mutex run_queue_guard;
+        std::deque<std::shared_ptr<Strand>> run_queue;
+        // The size of the run queue, stored whenever it changes so that it can be read
+        // without taking the run queue's lock.
+        std::atomic<size_t> run_queue_depth{ 0 };
+        std::mutex wakeup_guard;
+        std::condition_variable wakeup;
+        std::atomic<bool> has_work{ false };
+        std::atomic<bool> is_parked{ false };
     };
 
-    std::unordered_map<UUID, Thread> m_pool;
-    unsigned int m_threads_available;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<bool> m_is_running;
 
-    std::mutex m_dispatch_guard;
-    std::mutex m_handle_guard;
+    std::unordered_map<unsigned int, std::shared_ptr<Strand>> m_strands;
+    std::shared_mutex m_strands_guard;
+    unsigned int m_next_home_worker;
 
     ThreadPool();
     ~ThreadPool() = default;
 
     static ThreadPool s_instance;
     static ThreadPool& Get();
+
+    /**
+     * \brief The function run by each worker thread.
+     * \param id The index of the worker.
+     * \param handler The packet handler used to process incoming packets.
+     * \param dispatcher The packet dispatcher used to send outgoing packets.
+     */
+    static void RunWorker(unsigned int id, const ServerPacketHandler& handler,
+                          const ServerPacketDispatcher& dispatcher);
+
+    /**
+     * \brief Processes up to \code STRAND_BATCH_SIZE\endcode packets of a strand, rescheduling
+     * it if it still has packets pending afterwards.
+     */
+    static void RunStrand(const std::shared_ptr<Strand>& strand, const ServerPacketHandler& handler,
+                          const ServerPacketDispatcher& dispatcher);
+
+    /**
+     * \brief Records that packets have been enqueued on a strand, scheduling it if it was idle.
+     * \param strand The strand on which the packets were enqueued.
+     * \param count The number of packets which were enqueued.
+     */
+    static void NotifyPending(const std::shared_ptr<Strand>& strand, uint32_t count = 1);
+
+    /**
+     * \brief Places a strand on a worker's run queue and wakes a worker to process it.
+     */
+    static void Schedule(const std::shared_ptr<Strand>& strand);
+
+    /**
+     * \brief Takes the next strand from a worker's own run queue, or steals one from the
+     * run queue of another worker.
+     * \param id The index of the worker looking for work.
+     * \return The strand to run, or \code nullptr\endcode if there is none.
+     */
+    static std::shared_ptr<Strand> FindWork(unsigned int id);
+
+    /**
+     * \brief Parks a worker until it has been woken.
+     * \param id The index of the worker to park.
+     */
+    static void WaitForWork(unsigned int id);
+
+    /**
+     * \brief Wakes the given worker if it is parked.
+     * \param worker The worker to wake.
+     */
+    static void Wake(Worker& worker);
+
+    /**
+     * \brief Finds the strand of the given client.
+     * \param client_id The identifier of the client.
+     * \return The client's strand, or \code nullptr\endcode if it has none.
+     */
+    static std::shared_ptr<Strand> FindStrand(unsigned int client_id);
 };
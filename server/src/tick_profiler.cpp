@@ -0,0 +1,242 @@
+#include "tick_profiler.h"
+
+#include <common/utils/logging.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+/**
+ * \brief Durations shorter than 2 to the power of this, about a microsecond, share the first
+ * bucket.
+ */
+constexpr int DURATION_MIN_OCTAVE = 10;
+
+TickProfiler TickProfiler::s_instance;
+
+const char* GetTickPhaseName(const TickPhase phase)
+{
+    switch (phase)
+    {
+    case TickPhase::Poll:
+        return "Poll";
+    case TickPhase::Callbacks:
+        return "Callbacks";
+    case TickPhase::Commands:
+        return "Commands";
+    case TickPhase::Players:
+        return "Players";
+    case TickPhase::Projectiles:
+        return "Projectiles";
+    case TickPhase::Collisions:
+        return "Collisions";
+    case TickPhase::Dispatch:
+        return "Dispatch";
+    case TickPhase::Tick:
+        return "Tick";
+    default:
+        return "Unknown";
+    }
+}
+
+void DurationHistogram::Record(const uint64_t ns)
+{
+    counts[GetBucket(ns)]++;
+    count++;
+    total_ns += ns;
+    max_ns = std::max(max_ns, ns);
+}
+
+void DurationHistogram::Merge(const DurationHistogram& other)
+{
+    for (size_t i = 0; i < DURATION_BUCKET_COUNT; i++)
+        counts[i] += other.counts[i];
+
+    count += other.count;
+    total_ns += other.total_ns;
+    max_ns = std::max(max_ns, other.max_ns);
+}
+
+uint64_t DurationHistogram::GetPercentile(const double fraction) const
+{
+    if (count == 0)
+        return 0;
+
+    // The rank of the percentile, counting from 1.
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(count))));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < DURATION_BUCKET_COUNT; i++)
+    {
+        seen += counts[i];
+
+        // The recorded maximum is a tighter bound than the bucket's, and the only bound for the
+        // last bucket, which also holds every longer duration.
+        if (seen >= rank)
+            return i + 1 < DURATION_BUCKET_COUNT ? std::min(GetBucketUpperBound(i), max_ns) : max_ns;
+    }
+
+    return max_ns;
+}
+
+size_t DurationHistogram::GetBucket(const uint64_t ns)
+{
+    if (ns < (uint64_t{ 1 } << DURATION_MIN_OCTAVE))
+        return 0;
+
+    // The octave is the position of the highest set bit, and the sub-bucket is given by the two
+    // bits below it.
+    const int octave = std::bit_width(ns) - 1;
+    const size_t sub_bucket = (ns >> (octave - 2)) & (DURATION_SUB_BUCKETS - 1);
+    const size_t bucket = 1 + static_cast<size_t>(octave - DURATION_MIN_OCTAVE) * DURATION_SUB_BUCKETS + sub_bucket;
+
+    return std::min(bucket, DURATION_BUCKET_COUNT - 1);
+}
+
+uint64_t DurationHistogram::GetBucketUpperBound(const size_t bucket)
+{
+    if (bucket == 0)
+        return uint64_t{ 1 } << DURATION_MIN_OCTAVE;
+
+    const int octave = DURATION_MIN_OCTAVE + static_cast<int>((bucket - 1) / DURATION_SUB_BUCKETS);
+    const uint64_t sub_bucket = (bucket - 1) % DURATION_SUB_BUCKETS;
+
+    return (DURATION_SUB_BUCKETS + sub_bucket + 1) << (octave - 2);
+}
+
+const DurationHistogram& TickProfile::Get(const TickPhase phase) const
+{
+    return phases[static_cast<size_t>(phase)];
+}
+
+TickProfile TickProfile::Since(const TickProfile& earlier) const
+{
+    TickProfile difference{};
+
+    for (size_t phase = 0; phase < TICK_PHASE_COUNT; phase++)
+    {
+        const DurationHistogram& now = phases[phase];
+        const DurationHistogram& then = earlier.phases[phase];
+        DurationHistogram& result = difference.phases[phase];
+
+        for (size_t i = 0; i < DURATION_BUCKET_COUNT; i++)
+        {
+            result.counts[i] = now.counts[i] - then.counts[i];
+
+            if (result.counts[i] > 0)
+                result.max_ns = std::min(DurationHistogram::GetBucketUpperBound(i), now.max_ns);
+        }
+
+        result.count = now.count - then.count;
+        result.total_ns = now.total_ns - then.total_ns;
+    }
+
+    return difference;
+}
+
+void TickProfiler::Record(const TickPhase phase, const std::chrono::nanoseconds duration)
+{
+    ThreadHistograms::Phase& histogram = GetThreadHistograms().phases[static_cast<size_t>(phase)];
+    const auto ns = static_cast<uint64_t>(std::max<int64_t>(0, duration.count()));
+
+    // Only this thread writes to its histograms, so a relaxed load and store is enough to
+    // increment each value.
+    const auto increment = [](std::atomic<uint64_t>& value, const uint64_t amount)
+    {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    };
+
+    increment(histogram.counts[DurationHistogram::GetBucket(ns)], 1);
+    increment(histogram.count, 1);
+    increment(histogram.total_ns, ns);
+
+    if (ns > histogram.max_ns.load(std::memory_order_relaxed))
+        histogram.max_ns.store(ns, std::memory_order_relaxed);
+}
+
+void TickProfiler::RequestLog()
+{
+    Get().m_is_log_requested.store(true, std::memory_order_relaxed);
+}
+
+bool TickProfiler::ConsumeLogRequest()
+{
+    return Get().m_is_log_requested.exchange(false, std::memory_order_relaxed);
+}
+
+TickProfile TickProfiler::GetProfile()
+{
+    TickProfile profile{};
+
+    std::scoped_lock threads_lock{ Get().m_threads_guard };
+
+    for (const auto& thread : Get().m_threads)
+    {
+        for (size_t phase = 0; phase < TICK_PHASE_COUNT; phase++)
+        {
+            const ThreadHistograms::Phase& source = thread->phases[phase];
+            DurationHistogram& dest = profile.phases[phase];
+
+            // The values are read one at a time while they may be changing, so the total count
+            // may briefly disagree with the buckets by the durations being recorded.
+            for (size_t i = 0; i < DURATION_BUCKET_COUNT; i++)
+                dest.counts[i] += source.counts[i].load(std::memory_order_relaxed);
+
+            dest.count += source.count.load(std::memory_order_relaxed);
+            dest.total_ns += source.total_ns.load(std::memory_order_relaxed);
+            dest.max_ns = std::max(dest.max_ns, source.max_ns.load(std::memory_order_relaxed));
+        }
+    }
+
+    return profile;
+}
+
+void TickProfiler::LogProfile(const TickProfile& profile, const char* title)
+{
+    SCX_CORE_INFO("{0}:", title);
+
+    for (size_t phase = 0; phase < TICK_PHASE_COUNT; phase++)
+    {
+        const DurationHistogram& histogram = profile.phases[phase];
+        if (histogram.count == 0)
+            continue;
+
+        SCX_CORE_INFO("  {0:<12} {1:>9} samples  p50 {2:>9.1f} us  p99 {3:>9.1f} us  max {4:>9.1f} us",
+                      GetTickPhaseName(static_cast<TickPhase>(phase)), histogram.count,
+                      static_cast<double>(histogram.GetPercentile(0.50)) / 1000.0,
+                      static_cast<double>(histogram.GetPercentile(0.99)) / 1000.0,
+                      static_cast<double>(histogram.max_ns) / 1000.0);
+    }
+}
+
+TickProfiler& TickProfiler::Get()
+{
+    return s_instance;
+}
+
+TickProfiler::ThreadHistograms& TickProfiler::GetThreadHistograms()
+{
+    thread_local ThreadHistograms* t_p_histograms = nullptr;
+
+    if (t_p_histograms == nullptr)
+    {
+        auto histograms = std::make_unique<ThreadHistograms>();
+        t_p_histograms = histograms.get();
+
+        std::scoped_lock threads_lock{ Get().m_threads_guard };
+        Get().m_threads.push_back(std::move(histograms));
+    }
+
+    return *t_p_histograms;
+}
+
+ScopedPhaseTimer::ScopedPhaseTimer(const TickPhase phase)
+    : m_phase{ phase },
+      m_start{ std::chrono::steady_clock::now() }
+{
+}
+
+ScopedPhaseTimer::~ScopedPhaseTimer()
+{
+    TickProfiler::Record(m_phase, std::chrono::steady_clock::now() - m_start);
+}
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * \brief The phases of the server's loops which are timed.
+ */
+enum class TickPhase
+{
+    // Receiving messages from the poll group and handing them to the strands.
+    Poll,
+    // Running the networking library's callbacks, such as connection state changes.
+    Callbacks,
+    // Applying the commands which clients queued for a room.
+    Commands,
+    // Moving the players of a room and recording their positions.
+    Players,
+    // Expiring and moving the projectiles of a room.
+    Projectiles,
+    // Finding the players and platforms which projectiles have hit.
+    Collisions,
+    // Finding each client's interest and replicating the world to them.
+    Dispatch,
+    // A whole update of a room.
+    Tick,
+    Count
+};
+
+constexpr size_t TICK_PHASE_COUNT = static_cast<size_t>(TickPhase::Count);
+
+/**
+ * \brief Gets the name of a phase.
+ */
+const char* GetTickPhaseName(TickPhase phase);
+
+/**
+ * \brief The number of buckets of each histogram. Durations under a microsecond share the
+ * first bucket, and each doubling of duration after that is split into
+ * \code DURATION_SUB_BUCKETS\endcode buckets, up to about 17 seconds.
+ */
+constexpr size_t DURATION_SUB_BUCKETS = 4;
+constexpr size_t DURATION_OCTAVES = 24;
+constexpr size_t DURATION_BUCKET_COUNT = 1 + DURATION_OCTAVES * DURATION_SUB_BUCKETS;
+
+/**
+ * \brief A fixed-size histogram of durations, whose buckets grow with the duration so that
+ * percentiles are within a quarter of an octave of the true value.
+ */
+struct DurationHistogram
+{
+    std::array<uint64_t, DURATION_BUCKET_COUNT> counts{};
+    uint64_t count = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+
+    /**
+     * \brief Records a duration.
+     * \param ns The duration in nanoseconds.
+     */
+    void Record(uint64_t ns);
+
+    /**
+     * \brief Adds the durations recorded by another histogram to this one.
+     */
+    void Merge(const DurationHistogram& other);
+
+    /**
+     * \brief Estimates a percentile of the recorded durations.
+     * \param fraction The percentile as a fraction, such as 0.99 for the 99th percentile.
+     * \return The upper bound of the bucket which holds the percentile, in nanoseconds, or 0 if
+     * nothing has been recorded.
+     */
+    [[nodiscard]] uint64_t GetPercentile(double fraction) const;
+
+    /**
+     * \brief Gets the bucket which a duration is counted in.
+     * \param ns The duration in nanoseconds.
+     */
+    static size_t GetBucket(uint64_t ns);
+
+    /**
+     * \brief Gets the exclusive upper bound of the durations counted in a bucket.
+     * \param bucket The index of the bucket.
+     * \return The upper bound in nanoseconds.
+     */
+    static uint64_t GetBucketUpperBound(size_t bucket);
+};
+
+/**
+ * \brief The histograms of every phase, merged from every thread.
+ */
+struct TickProfile
+{
+    std::array<DurationHistogram, TICK_PHASE_COUNT> phases{};
+
+    [[nodiscard]] const DurationHistogram& Get(TickPhase phase) const;
+
+    /**
+     * \brief Gets the durations which were recorded since an earlier profile was taken. The
+     * maximum of each phase is estimated from the buckets, as it cannot be subtracted.
+     * \param earlier The earlier profile.
+     */
+    [[nodiscard]] TickProfile Since(const TickProfile& earlier) const;
+};
+
+/**
+ * \brief A data structure implemented as a singleton pattern to time the phases of the
+ * server's loops.
+ *
+ * Each thread records into its own set of histograms, which is allocated the first time the
+ * thread records a duration, so recording never allocates, locks or contends with another
+ * thread. The histograms of every thread are merged when the profile is read, which may be
+ * done from any thread while durations are being recorded.
+ */
+class TickProfiler
+{
+public:
+    TickProfiler(const TickProfiler&) = delete;
+    TickProfiler& operator=(const TickProfiler&) = delete;
+
+    TickProfiler(TickProfiler&&) noexcept = delete;
+    TickProfiler& operator=(TickProfiler&&) noexcept = delete;
+
+    /**
+     * \brief Records how long a phase took on the calling thread.
+     * \param phase The phase.
+     * \param duration How long the phase took.
+     */
+    static void Record(TickPhase phase, std::chrono::nanoseconds duration);
+
+    /**
+     * \brief Requests that the profile is logged by the server's main loop. May be called from
+     * any thread, and from a signal handler.
+     */
+    static void RequestLog();
+
+    /**
+     * \brief Clears a request to log the profile.
+     * \return Whether the profile had been requested since the last call.
+     */
+    static bool ConsumeLogRequest();
+
+    /**
+     * \brief Merges the histograms of every thread. May be called from any thread.
+     * \return The durations recorded since the server started.
+     */
+    static TickProfile GetProfile();
+
+    /**
+     * \brief Logs the count, 50th and 99th percentiles and maximum of each phase which has been
+     * recorded.
+     * \param profile The profile to log.
+     * \param title A title describing the period the profile covers.
+     */
+    static void LogProfile(const TickProfile& profile, const char* title);
+
+private:
+    /**
+     * \brief The histograms recorded by a single thread. Only that thread writes to them, so
+     * each value is updated with a plain load and store rather than an atomic
+     * read-modify-write, and readers on other threads see each value whole.
+     */
+    struct ThreadHistograms
+    {
+        struct Phase
+        {
+            std::array<std::atomic<uint64_t>, DURATION_BUCKET_COUNT> counts{};
+            std::atomic<uint64_t> count{ 0 };
+            std::atomic<uint64_t> total_ns{ 0 };
+            std::atomic<uint64_t> max_ns{ 0 };
+        };
+
+        std::array<Phase, TICK_PHASE_COUNT> phases;
+    };
+
+    /**
+     * \brief The histograms of every thread which has recorded a duration. Histograms are kept
+     * after their thread exits, so that the durations it recorded are not lost.
+     */
+    std::vector<std::unique_ptr<ThreadHistograms>> m_threads;
+    std::mutex m_threads_guard;
+
+    std::atomic<bool> m_is_log_requested{ false };
+
+    TickProfiler() = default;
+    ~TickProfiler() = default;
+
+    static TickProfiler s_instance;
+    static TickProfiler& Get();
+
+    /**
+     * \brief Gets the histograms of the calling thread, creating them on its first call.
+     */
+    static ThreadHistograms& GetThreadHistograms();
+};
+
+/**
+ * \brief Records how long a phase took from its construction to its destruction.
+ */
+class ScopedPhaseTimer
+{
+public:
+    explicit ScopedPhaseTimer(TickPhase phase);
+    ~ScopedPhaseTimer();
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+    ScopedPhaseTimer(ScopedPhaseTimer&&) noexcept = delete;
+    ScopedPhaseTimer& operator=(ScopedPhaseTimer&&) noexcept = delete;
+
+private:
+    TickPhase m_phase;
+    std::chrono::steady_clock::time_point m_start;
+};
@@ -0,0 +1,61 @@
+#include "tick_scheduler.h"
+
+#include <thread>
+
+TickScheduler::TickScheduler(const int tick_rate, const std::chrono::microseconds spin_duration)
+    : m_period{ std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds{ 1 }) / tick_rate },
+      m_spin_duration{ spin_duration },
+      m_lateness{ 0 },
+      m_skipped_ticks{ 0 }
+{
+}
+
+void TickScheduler::Start()
+{
+    m_deadline = std::chrono::steady_clock::now() + m_period;
+    m_lateness = std::chrono::nanoseconds{ 0 };
+    m_skipped_ticks = 0;
+}
+
+int TickScheduler::WaitForNextTick()
+{
+    // Sleeping may wake up later than requested, so the end of the wait can be spun through.
+    std::this_thread::sleep_until(m_deadline - m_spin_duration);
+
+    auto now = std::chrono::steady_clock::now();
+    while (now < m_deadline)
+        now = std::chrono::steady_clock::now();
+
+    m_lateness = now - m_deadline;
+
+    // Every deadline which has passed is due, including those missed while the last tick ran.
+    const int64_t due_ticks = 1 + m_lateness / m_period;
+
+    if (due_ticks > MAX_CATCH_UP_TICKS)
+    {
+        // Rather than trying to run every missed tick, restart the deadlines from now.
+        m_skipped_ticks += static_cast<uint64_t>(due_ticks - MAX_CATCH_UP_TICKS);
+        m_deadline = now + m_period;
+
+        return MAX_CATCH_UP_TICKS;
+    }
+
+    m_deadline += due_ticks * m_period;
+
+    return static_cast<int>(due_ticks);
+}
+
+double TickScheduler::GetFixedDeltaTime() const
+{
+    return std::chrono::duration<double>(m_period).count();
+}
+
+std::chrono::nanoseconds TickScheduler::GetLateness() const
+{
+    return m_lateness;
+}
+
+uint64_t TickScheduler::GetSkippedTicks() const
+{
+    return m_skipped_ticks;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * \brief The maximum number of ticks run to catch up after a single overrun. Any further
+ * ticks which were missed are skipped, so that an overloaded server does not fall further
+ * behind by trying to run every tick it missed.
+ */
+constexpr int MAX_CATCH_UP_TICKS = 4;
+
+/**
+ * \brief Schedules ticks at a fixed rate by waiting for absolute deadlines, so that the time
+ * spent running a tick does not lengthen the tick period.
+ */
+class TickScheduler
+{
+public:
+    /**
+     * \brief Creates a scheduler which has not been started.
+     * \param tick_rate The number of ticks per second.
+     * \param spin_duration How long before each deadline to stop sleeping and spin instead,
+     * trading processor time for a more precise wake up. No spinning is done if zero.
+     */
+    TickScheduler(int tick_rate, std::chrono::microseconds spin_duration);
+    ~TickScheduler() = default;
+
+    TickScheduler(const TickScheduler&) = default;
+    TickScheduler& operator=(const TickScheduler&) = default;
+
+    TickScheduler(TickScheduler&&) noexcept = default;
+    TickScheduler& operator=(TickScheduler&&) noexcept = default;
+
+    /**
+     * \brief Starts the scheduler, making the first tick due one period from now.
+     */
+    void Start();
+
+    /**
+     * \brief Waits until the next tick is due.
+     * \return The number of ticks to run, which is more than one if the deadlines of later
+     * ticks have also passed. This is never more than \code MAX_CATCH_UP_TICKS\endcode.
+     */
+    int WaitForNextTick();
+
+    /**
+     * \brief Gets the fixed time step which each tick should simulate.
+     * \return The length of a tick in seconds.
+     */
+    [[nodiscard]] double GetFixedDeltaTime() const;
+
+    /**
+     * \brief Gets how long after its deadline the last tick started.
+     * \return The lateness of the last tick.
+     */
+    [[nodiscard]] std::chrono::nanoseconds GetLateness() const;
+
+    /**
+     * \brief Gets the number of ticks which were skipped, rather than caught up, since the
+     * scheduler was started.
+     * \return The number of skipped ticks.
+     */
+    [[nodiscard]] uint64_t GetSkippedTicks() const;
+
+private:
+    std::chrono::steady_clock::duration m_period;
+    std::chrono::microseconds m_spin_duration;
+    std::chrono::steady_clock::time_point m_deadline;
+    std::chrono::nanoseconds m_lateness;
+    uint64_t m_skipped_ticks;
+};
@@ -0,0 +1,98 @@
+#define CLOVE_SUITE_NAME ClientRegistryTests
+#include <clove-unit.h>
+
+#include <client_registry.h>
+
+// Test 1
+CLOVE_TEST(TestAddedClientsCanBeFound)
+{
+    /**
+     * This test ensures that each added client can be found by both its connection and its
+     * handle, and that its data is stored at the index which is found.
+     */
+
+    ClientRegistry clients{};
+
+    const ClientHandle first = clients.Add(10, "First");
+    const ClientHandle second = clients.Add(20, "Second");
+
+    CLOVE_INT_EQ(2, static_cast<int>(clients.GetSize()));
+
+    const auto index = clients.Find(HSteamNetConnection{ 20 });
+
+    CLOVE_IS_TRUE(index.has_value());
+    CLOVE_IS_TRUE(clients.Find(second) == index);
+    CLOVE_IS_TRUE(clients.Find(first) == clients.Find(HSteamNetConnection{ 10 }));
+    CLOVE_UINT_EQ(20, clients.GetInfo()[*index].connection);
+    CLOVE_STRING_EQ("Second", clients.GetInfo()[*index].username.c_str());
+    CLOVE_IS_FALSE(clients.Find(HSteamNetConnection{ 30 }).has_value());
+}
+
+// Test 2
+CLOVE_TEST(TestRemovingAClientKeepsOthersFindable)
+{
+    /**
+     * This test ensures that when a client is removed and the last client is moved into its
+     * place, the moved client can still be found by its connection and its handle.
+     */
+
+    ClientRegistry clients{};
+
+    clients.Add(10, "First");
+    clients.Add(20, "Second");
+    const ClientHandle third = clients.Add(30, "Third");
+
+    CLOVE_IS_TRUE(clients.Remove(10));
+    CLOVE_IS_FALSE(clients.Remove(10));
+
+    CLOVE_INT_EQ(2, static_cast<int>(clients.GetSize()));
+    CLOVE_IS_FALSE(clients.Find(HSteamNetConnection{ 10 }).has_value());
+
+    const auto index = clients.Find(HSteamNetConnection{ 30 });
+
+    CLOVE_IS_TRUE(index.has_value());
+    CLOVE_IS_TRUE(clients.Find(third) == index);
+    CLOVE_UINT_EQ(30, clients.GetInfo()[*index].connection);
+    CLOVE_STRING_EQ("Third", clients.GetInfo()[*index].username.c_str());
+}
+
+// Test 3
+CLOVE_TEST(TestStaleHandlesAreNotFound)
+{
+    /**
+     * This test ensures that the handle of a removed client is not found, even once its slot
+     * has been reused by a new client.
+     */
+
+    ClientRegistry clients{};
+
+    const ClientHandle removed = clients.Add(10, "Removed");
+    clients.Remove(10);
+
+    const ClientHandle added = clients.Add(20, "Added");
+
+    CLOVE_UINT_EQ(removed.slot, added.slot);
+    CLOVE_IS_FALSE(clients.Find(removed).has_value());
+    CLOVE_IS_TRUE(clients.Find(added).has_value());
+}
+
+// Test 4
+CLOVE_TEST(TestClearRemovesEveryClient)
+{
+    /**
+     * This test ensures that clearing the registry removes every client and invalidates their
+     * handles.
+     */
+
+    ClientRegistry clients{};
+
+    const ClientHandle handle = clients.Add(10, "First");
+    clients.Add(20, "Second");
+
+    clients.Clear();
+
+    CLOVE_INT_EQ(0, static_cast<int>(clients.GetSize()));
+    CLOVE_IS_TRUE(clients.GetPlayers().empty());
+    CLOVE_IS_FALSE(clients.Find(HSteamNetConnection{ 20 }).has_value());
+    CLOVE_IS_FALSE(clients.Find(handle).has_value());
+}
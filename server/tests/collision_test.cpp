@@ -1,8 +1,23 @@
 #define CLOVE_SUITE_NAME CollisionTests
 #include <clove-unit.h>
 
+#include <physics/batch_kernels.h>
 #include <physics/collision.h>
 
+#include <glm/geometric.hpp>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+/**
+ * \brief Creates an oriented box which is aligned with the axes, from its lower and upper corners.
+ */
+static Collision::Box2d MakeAlignedBox(const glm::vec2 min, const glm::vec2 max)
+{
+    return Collision::MakeBox2d((min + max) / 2.0f, (max - min) / 2.0f, { 1.0f, 0.0f });
+}
+
 // Test 1
 CLOVE_TEST(TestCollisionByDistance)
 {
@@ -86,3 +101,241 @@ CLOVE_TEST(TestAABBtoAABBNoCollision)
 
     CLOVE_IS_FALSE(Collision::AABBtoAABB(aabb1, aabb2));
 }
+
+// Test 7
+CLOVE_TEST(TestOverlapMaskMatchesScalar)
+{
+    /**
+     * This test ensures that Batch::OverlapMask finds the same overlapping boxes as its scalar
+     * equivalent for randomly placed boxes, including the padding of a partial batch.
+     */
+
+    std::mt19937 rng{ 7 };
+    std::uniform_real_distribution<float> coordinate{ -100.0f, 100.0f };
+    std::uniform_real_distribution<float> extent{ 1.0f, 40.0f };
+
+    const auto random_box = [&]
+    {
+        const glm::vec2 min = { coordinate(rng), coordinate(rng) };
+        return Batch::Box{ min, min + glm::vec2{ extent(rng), extent(rng) } };
+    };
+
+    Batch::BoxSet boxes;
+    for (int i = 0; i < 61; i++)
+        boxes.Add(random_box());
+
+    CLOVE_INT_EQ(64, static_cast<int>(boxes.GetPaddedSize()));
+
+    for (int i = 0; i < 100; i++)
+    {
+        const Batch::Box box = random_box();
+
+        for (size_t first = 0; first < boxes.GetPaddedSize(); first += Batch::BOX_BATCH_WIDTH)
+            CLOVE_UINT_EQ(Batch::OverlapMaskScalar(box, boxes, first), Batch::OverlapMask(box, boxes, first));
+    }
+}
+
+// Test 8
+CLOVE_TEST(TestForEachOverlap)
+{
+    /**
+     * This test ensures that Batch::ForEachOverlap visits exactly the boxes which overlap a box,
+     * in increasing order, and does not count boxes which only touch it.
+     */
+
+    Batch::BoxSet boxes;
+    boxes.Add({ { 0.0f, 0.0f }, { 1.0f, 1.0f } });
+    boxes.Add({ { 1.0f, 0.0f }, { 2.0f, 1.0f } });
+    boxes.Add({ { 5.0f, 5.0f }, { 6.0f, 6.0f } });
+    for (int i = 0; i < 8; i++)
+        boxes.Add({ { 0.5f, 0.5f }, { 0.75f, 0.75f } });
+
+    std::vector<size_t> visited;
+    Batch::ForEachOverlap({ { -1.0f, -1.0f }, { 1.0f, 1.0f } }, boxes, [&](const size_t i) { visited.push_back(i); });
+
+    const std::vector<size_t> expected = { 0, 3, 4, 5, 6, 7, 8, 9, 10 };
+    CLOVE_IS_TRUE(visited == expected);
+}
+
+// Test 9
+CLOVE_TEST(TestIntegrateProjectilesMatchesScalar)
+{
+    /**
+     * This test ensures that Batch::IntegrateProjectiles moves, accelerates and rotates
+     * projectiles in the same way as its scalar equivalent, for a count which is not a whole
+     * number of vectors.
+     */
+
+    std::mt19937 rng{ 9 };
+    std::uniform_real_distribution<float> value{ -500.0f, 500.0f };
+
+    for (const size_t count : { 0u, 1u, 3u, 7u, 130u })
+    {
+        std::vector<glm::vec2> positions, velocities;
+        for (size_t i = 0; i < count; i++)
+        {
+            positions.emplace_back(value(rng), value(rng));
+            velocities.emplace_back(value(rng), value(rng));
+        }
+
+        std::vector<glm::vec2> expected_positions = positions, expected_velocities = velocities;
+        std::vector<float> rotations(count), expected_rotations(count);
+
+        for (int step = 0; step < 10; step++)
+        {
+            Batch::IntegrateProjectiles(positions, velocities, rotations, 1.0f / 60.0f, 981.0f);
+            Batch::IntegrateProjectilesScalar(expected_positions, expected_velocities, expected_rotations,
+                                              1.0f / 60.0f, 981.0f);
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            CLOVE_IS_TRUE(glm::length(expected_positions[i] - positions[i]) < 1e-3f);
+            CLOVE_IS_TRUE(glm::length(expected_velocities[i] - velocities[i]) < 1e-3f);
+            CLOVE_IS_TRUE(std::abs(expected_rotations[i] - rotations[i]) < 1e-5f);
+        }
+    }
+}
+
+// Test 10
+CLOVE_TEST(TestAtan2Approximation)
+{
+    /**
+     * This test ensures that Batch::Atan2 stays close to std::atan2 in every quadrant, and
+     * that the angle of a zero vector is zero.
+     */
+
+    for (int i = 0; i < 360; i++)
+    {
+        const float angle = static_cast<float>(i) * 3.14159265f / 180.0f;
+        const float y = std::sin(angle) * 250.0f, x = std::cos(angle) * 250.0f;
+
+        CLOVE_IS_TRUE(std::abs(std::atan2(y, x) - Batch::Atan2(y, x)) < 2e-5f);
+    }
+
+    CLOVE_FLOAT_EQ(0.0f, Batch::Atan2(0.0f, 0.0f));
+}
+
+// Test 11
+CLOVE_TEST(TestSweepBox2dFindsTunnellingHit)
+{
+    /**
+     * This test ensures that Collision::SweepBox2d finds a hit when a small box moves straight
+     * through a thin box in a single step, ending on the far side without overlapping it, with
+     * the normal of the face which was hit.
+     */
+
+    const glm::vec2 displacement = { 100.0f, 0.0f };
+
+    const Collision::Box2d box = MakeAlignedBox({ -2.0f, -1.0f }, { 2.0f, 1.0f });
+    const Collision::Box2d wall = MakeAlignedBox({ 48.0f, -50.0f }, { 52.0f, 50.0f });
+
+    // The box overlaps the wall neither before nor after its movement.
+    CLOVE_IS_FALSE(Collision::AABBtoAABB(Collision::MakeAABB({ 98.0f, -1.0f }, { 102.0f, 1.0f }),
+                                         Collision::MakeAABB({ 48.0f, -50.0f }, { 52.0f, 50.0f })));
+
+    const std::optional<Collision::Contact> contact = Collision::SweepBox2d(box, displacement, wall);
+
+    CLOVE_IS_TRUE(contact.has_value());
+    CLOVE_FLOAT_EQ(0.46f, contact->time);
+    CLOVE_FLOAT_EQ(1.0f, contact->normal.x);
+    CLOVE_FLOAT_EQ(0.0f, contact->normal.y);
+}
+
+// Test 12
+CLOVE_TEST(TestSweepBox2dMisses)
+{
+    /**
+     * This test ensures that Collision::SweepBox2d does not find a hit when a box moves past
+     * another box, stops before reaching it, or only slides along its edge.
+     */
+
+    const Collision::Box2d box = MakeAlignedBox({ 0.0f, 0.0f }, { 1.0f, 1.0f });
+
+    CLOVE_IS_FALSE(Collision::SweepBox2d(box, { 10.0f, 0.0f }, MakeAlignedBox({ 5.0f, 2.0f }, { 6.0f, 3.0f })).has_value());
+    CLOVE_IS_FALSE(Collision::SweepBox2d(box, { 3.0f, 0.0f }, MakeAlignedBox({ 5.0f, 0.0f }, { 6.0f, 1.0f })).has_value());
+    CLOVE_IS_FALSE(Collision::SweepBox2d(box, { 10.0f, 0.0f }, MakeAlignedBox({ 5.0f, 1.0f }, { 6.0f, 2.0f })).has_value());
+    CLOVE_IS_FALSE(Collision::SweepBox2d(box, { 10.0f, 10.0f }, MakeAlignedBox({ 8.0f, 0.0f }, { 9.0f, 1.0f })).has_value());
+}
+
+// Test 13
+CLOVE_TEST(TestSweepBox2dStartingInside)
+{
+    /**
+     * This test ensures that Collision::SweepBox2d finds a hit at the start of the movement
+     * when the boxes already overlap, including when the box does not move.
+     */
+
+    const Collision::Box2d box = MakeAlignedBox({ 0.0f, 0.0f }, { 2.0f, 2.0f });
+    const Collision::Box2d other = MakeAlignedBox({ 1.0f, 1.0f }, { 3.0f, 3.0f });
+
+    const std::optional<Collision::Contact> moving = Collision::SweepBox2d(box, { -5.0f, 3.0f }, other);
+    const std::optional<Collision::Contact> still = Collision::SweepBox2d(box, { 0.0f, 0.0f }, other);
+
+    CLOVE_IS_TRUE(moving.has_value());
+    CLOVE_FLOAT_EQ(0.0f, moving->time);
+    CLOVE_IS_TRUE(still.has_value());
+    CLOVE_FLOAT_EQ(0.0f, still->time);
+}
+
+// Test 14
+CLOVE_TEST(TestSeparateRotatedBoxes)
+{
+    /**
+     * This test ensures that Collision::SeparateBoxes finds a gap between a rotated box and an
+     * axis-aligned box whose bounds overlap, with the normal pointing from the first box
+     * towards the second.
+     */
+
+    const float diagonal = std::sqrt(0.5f);
+    const Collision::Box2d rotated = Collision::MakeBox2d({ 0.0f, 0.0f }, { 4.0f, 1.0f }, { diagonal, diagonal });
+    const Collision::Box2d box = Collision::MakeBox2d({ 3.0f, -2.0f }, { 1.0f, 1.0f }, { 1.0f, 0.0f });
+
+    glm::vec2 min, max;
+    Collision::GetBounds(rotated, min, max);
+    CLOVE_IS_TRUE(max.x > 2.0f && min.y < -1.0f);
+
+    const Collision::Separation separation = Collision::SeparateBoxes(rotated, box);
+
+    CLOVE_IS_TRUE(separation.distance > 0.0f);
+    CLOVE_IS_TRUE(std::abs(separation.normal.x - diagonal) < 1e-5f);
+    CLOVE_IS_TRUE(std::abs(separation.normal.y + diagonal) < 1e-5f);
+}
+
+// Test 15
+CLOVE_TEST(TestSeparateOverlappingBoxes)
+{
+    /**
+     * This test ensures that Collision::SeparateBoxes gives the depth of the overlap of two
+     * overlapping boxes along the axis of least penetration.
+     */
+
+    const Collision::Box2d b1 = Collision::MakeBox2d({ 0.0f, 0.0f }, { 2.0f, 2.0f }, { 1.0f, 0.0f });
+    const Collision::Box2d b2 = Collision::MakeBox2d({ 3.5f, 0.5f }, { 2.0f, 2.0f }, { 1.0f, 0.0f });
+
+    const Collision::Separation separation = Collision::SeparateBoxes(b1, b2);
+
+    CLOVE_FLOAT_EQ(-0.5f, separation.distance);
+    CLOVE_FLOAT_EQ(1.0f, separation.normal.x);
+    CLOVE_FLOAT_EQ(0.0f, separation.normal.y);
+    CLOVE_FLOAT_EQ(-0.5f, FindMinimumSeparation(b1, b2));
+}
+
+// Test 16
+CLOVE_TEST(TestSweepBox2dRotatedPassesCorner)
+{
+    /**
+     * This test ensures that a rotated box moving along its length past the corner of another
+     * box does not hit it, although its axis-aligned bounds would.
+     */
+
+    const float diagonal = std::sqrt(0.5f);
+    const Collision::Box2d rotated = Collision::MakeBox2d({ -18.0f, -22.0f }, { 4.0f, 1.0f }, { diagonal, diagonal });
+    const Collision::Box2d box = Collision::MakeBox2d({ 0.0f, 0.0f }, { 1.0f, 1.0f }, { 1.0f, 0.0f });
+
+    glm::vec2 min, max;
+    Collision::GetBounds(rotated, min, max);
+
+    CLOVE_IS_FALSE(Collision::SweepBox2d(rotated, { 40.0f, 40.0f }, box).has_value());
+    CLOVE_IS_TRUE(Collision::SweepBox2d(MakeAlignedBox(min, max), { 40.0f, 40.0f }, box).has_value());
+}
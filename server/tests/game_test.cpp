@@ -0,0 +1,158 @@
+#define CLOVE_SUITE_NAME GameTests
+#include <clove-unit.h>
+
+#include <game.h>
+#include <room.h>
+
+#include "test_support.h"
+
+#include <memory>
+#include <span>
+
+constexpr double GAME_TEST_DT = 1.0 / 60.0;
+
+CLOVE_SUITE_SETUP_ONCE()
+{
+    InitialiseTestLogging();
+}
+
+// Test 1
+CLOVE_TEST(TestCommandsQueuedWhileDrainingWait)
+{
+    /**
+     * This test ensures that a command queued while the commands are being applied is left
+     * for the next update, so that the commands applied by an update are bounded.
+     */
+
+    const Level level{};
+    FakeTransport transport;
+    auto room = std::make_unique<Room>(0, level, transport);
+
+    // The first join is announced while its command is being applied, which queues another.
+    bool has_queued = false;
+    transport.on_multicast = [&room, &has_queued](const Packet&, std::span<const HSteamNetConnection>,
+                                                      HSteamNetConnection)
+    {
+        if (has_queued)
+            return;
+
+        has_queued = true;
+        room->EnqueueCommand({ .type = GameCommand::Type::Join, .client_id = 2, .text = "Second" });
+    };
+
+    room->EnqueueCommand({ .type = GameCommand::Type::Join, .client_id = 1, .text = "First" });
+
+    room->Update(GAME_TEST_DT, 1);
+    CLOVE_IS_TRUE(has_queued);
+    CLOVE_INT_EQ(1, static_cast<int>(room->GetClients().GetSize()));
+
+    room->Update(GAME_TEST_DT, 1);
+    CLOVE_INT_EQ(2, static_cast<int>(room->GetClients().GetSize()));
+    CLOVE_IS_TRUE(room->GetClients().Find(2).has_value());
+}
+
+// Test 2
+CLOVE_TEST(TestCommandsFromDepartedClientsAreDropped)
+{
+    /**
+     * This test ensures that commands from a client which has left the room, or which never
+     * joined it, are dropped rather than adding the client back.
+     */
+
+    const Level level{};
+    const FakeTransport transport;
+    auto room = std::make_unique<Room>(0, level, transport);
+
+    room->EnqueueCommand({ .type = GameCommand::Type::Join, .client_id = 1, .text = "First" });
+    room->Update(GAME_TEST_DT, 1);
+
+    room->Leave(1);
+    room->Update(GAME_TEST_DT, 1);
+    CLOVE_IS_TRUE(room->IsParked());
+
+    room->EnqueueCommand({ .type = GameCommand::Type::Respawn, .client_id = 1 });
+    room->EnqueueCommand({ .type = GameCommand::Type::ChatMessage, .client_id = 1, .text = "Hello" });
+    room->EnqueueCommand({ .type = GameCommand::Type::Input, .client_id = 3 });
+    room->Update(GAME_TEST_DT, 1);
+
+    CLOVE_INT_EQ(0, static_cast<int>(room->GetClients().GetSize()));
+    CLOVE_IS_TRUE(room->IsParked());
+}
+
+// Test 3
+CLOVE_TEST(TestJoinBeforeLeaveInOneUpdate)
+{
+    /**
+     * This test ensures that a client which joins and leaves before the same update is added
+     * by that update and then removed by it, leaving the room parked.
+     */
+
+    const Level level{};
+    const FakeTransport transport;
+    auto room = std::make_unique<Room>(0, level, transport);
+
+    room->EnqueueCommand({ .type = GameCommand::Type::Join, .client_id = 1, .text = "First" });
+    room->EnqueueCommand({ .type = GameCommand::Type::Input, .client_id = 1, .inputs = { true, false, false, false } });
+    room->Leave(1);
+
+    room->Update(GAME_TEST_DT, 1);
+
+    CLOVE_INT_EQ(0, static_cast<int>(room->GetClients().GetSize()));
+    CLOVE_INT_EQ(0, static_cast<int>(room->GetConnections().size()));
+    CLOVE_IS_TRUE(room->IsParked());
+}
+
+// Test 4
+CLOVE_TEST(TestJoinAfterLeaveIsDiscarded)
+{
+    /**
+     * This test ensures that a join which is only applied after its client has left, as when
+     * it is held up behind a command which has not been published yet, does not add the
+     * client back to the room.
+     */
+
+    const Level level{};
+    const FakeTransport transport;
+    auto room = std::make_unique<Room>(0, level, transport);
+
+    room->Leave(1);
+    room->Update(GAME_TEST_DT, 1);
+
+    room->EnqueueCommand({ .type = GameCommand::Type::Join, .client_id = 1, .text = "First" });
+    room->EnqueueCommand({ .type = GameCommand::Type::Input, .client_id = 1, .inputs = { true, false, false, false } });
+    room->Update(GAME_TEST_DT, 1);
+
+    CLOVE_INT_EQ(0, static_cast<int>(room->GetClients().GetSize()));
+    CLOVE_IS_TRUE(room->IsParked());
+
+    // Only the late join is discarded, so the client can join the room again.
+    room->EnqueueCommand({ .type = GameCommand::Type::Join, .client_id = 1, .text = "First" });
+    room->Update(GAME_TEST_DT, 1);
+
+    CLOVE_INT_EQ(1, static_cast<int>(room->GetClients().GetSize()));
+}
+
+// Test 5
+CLOVE_TEST(TestEnqueueReportsAFullQueue)
+{
+    /**
+     * This test ensures that queuing a command reports whether it was queued, so that a join
+     * which is dropped by a full queue can be undone.
+     */
+
+    const Level level{};
+    const FakeTransport transport;
+    auto room = std::make_unique<Room>(0, level, transport);
+
+    bool has_queued_all = true;
+    for (size_t i = 0; i < GAME_COMMAND_QUEUE_CAPACITY; i++)
+        has_queued_all &= room->EnqueueCommand({ .type = GameCommand::Type::Input, .client_id = 1 });
+
+    CLOVE_IS_TRUE(has_queued_all);
+
+    CLOVE_IS_FALSE(room->EnqueueCommand({ .type = GameCommand::Type::Join, .client_id = 2, .text = "Second" }));
+
+    // Draining the queue makes space for the join.
+    room->Update(GAME_TEST_DT, 1);
+    CLOVE_IS_TRUE(room->EnqueueCommand({ .type = GameCommand::Type::Join, .client_id = 2, .text = "Second" }));
+}
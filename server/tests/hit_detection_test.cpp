@@ -0,0 +1,232 @@
+#define CLOVE_SUITE_NAME HitDetectionTests
+#include <clove-unit.h>
+
+#include <physics/hit_detection.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+constexpr glm::vec2 TEST_PROJECTILE_SCALE = { 15.0f, 3.0f };
+
+/**
+ * \brief Creates targets scattered over a square, some of which cannot be hit.
+ */
+static std::vector<HitTarget> CreateTargets(std::mt19937& engine, const int count, const float extent)
+{
+    std::uniform_real_distribution position{ -extent, extent };
+    std::uniform_real_distribution scale{ 5.0f, 20.0f };
+
+    std::vector<HitTarget> targets;
+    for (int i = 0; i < count; i++)
+    {
+        const float size = scale(engine);
+        targets.push_back({
+            .id = static_cast<unsigned int>(i + 1), .position = { position(engine), position(engine) },
+            .scale = { size, size }, .can_be_hit = i % 7 != 0
+        });
+    }
+
+    return targets;
+}
+
+/**
+ * \brief Creates projectiles scattered over a square, each fired by one of the targets and
+ * moving up to a few target widths in an update.
+ */
+static std::vector<HitProjectile> CreateProjectiles(std::mt19937& engine, const int count, const int owner_count,
+                                                    const float extent)
+{
+    std::uniform_real_distribution position{ -extent, extent };
+    std::uniform_real_distribution angle{ -3.14159f, 3.14159f };
+    std::uniform_int_distribution owner{ 1, owner_count };
+    std::uniform_real_distribution displacement{ -40.0f, 40.0f };
+
+    std::vector<HitProjectile> projectiles;
+    for (int i = 0; i < count; i++)
+    {
+        const float rotation = angle(engine);
+
+        projectiles.push_back({
+            .position = { position(engine), position(engine) },
+            .direction = { std::cos(rotation), std::sin(rotation) },
+            .owner_id = static_cast<unsigned int>(owner(engine)),
+            .displacement = { displacement(engine), displacement(engine) }
+        });
+    }
+
+    return projectiles;
+}
+
+// Test 1
+CLOVE_TEST(TestOwnerIsNotHit)
+{
+    /**
+     * This test ensures that a projectile does not hit the target which fired it, but does
+     * hit another target in the same place.
+     */
+
+    const std::vector<HitTarget> targets = {
+        { .id = 1, .position = { 0.0f, 0.0f }, .scale = { 10.0f, 10.0f }, .can_be_hit = true },
+        { .id = 2, .position = { 0.0f, 0.0f }, .scale = { 10.0f, 10.0f }, .can_be_hit = true }
+    };
+
+    const HitProjectile projectile{ .position = { 8.0f, 0.0f }, .direction = { 1.0f, 0.0f }, .owner_id = 1 };
+
+    HitDetector detector{ 25.0f };
+    detector.Build(targets);
+
+    CLOVE_INT_EQ(1, detector.FindProjectileHit(projectile, TEST_PROJECTILE_SCALE, targets));
+    CLOVE_INT_EQ(1, FindProjectileHit(projectile, TEST_PROJECTILE_SCALE, targets));
+}
+
+// Test 2
+CLOVE_TEST(TestBroadphaseMatchesBruteForce)
+{
+    /**
+     * This test ensures that the hit detector finds the same hit for every projectile as
+     * testing the projectile against every target.
+     */
+
+    std::mt19937 engine{ 12345 };
+
+    const std::vector<HitTarget> targets = CreateTargets(engine, 256, 400.0f);
+    const std::vector<HitProjectile> projectiles = CreateProjectiles(engine, 20000, 256, 420.0f);
+
+    HitDetector detector{ 25.0f };
+    detector.Build(targets);
+
+    int hits = 0;
+    int mismatches = 0;
+
+    for (const auto& projectile : projectiles)
+    {
+        const int expected = FindProjectileHit(projectile, TEST_PROJECTILE_SCALE, targets);
+
+        if (detector.FindProjectileHit(projectile, TEST_PROJECTILE_SCALE, targets) != expected)
+            mismatches++;
+        if (expected != NO_HIT)
+            hits++;
+    }
+
+    CLOVE_INT_GT(hits, 0);
+    CLOVE_INT_EQ(0, mismatches);
+}
+
+// Test 3
+CLOVE_TEST(TestBroadphaseMatchesBruteForceAsTargetsDie)
+{
+    /**
+     * This test ensures that the hit detector matches testing every target when targets stop
+     * being hittable part way through, as happens when a player dies.
+     */
+
+    std::mt19937 engine{ 67890 };
+
+    std::vector<HitTarget> targets = CreateTargets(engine, 64, 100.0f);
+    const std::vector<HitProjectile> projectiles = CreateProjectiles(engine, 5000, 64, 110.0f);
+
+    HitDetector detector{ 25.0f };
+    detector.Build(targets);
+
+    int hits = 0;
+    int mismatches = 0;
+
+    for (const auto& projectile : projectiles)
+    {
+        const int expected = FindProjectileHit(projectile, TEST_PROJECTILE_SCALE, targets);
+        const int actual = detector.FindProjectileHit(projectile, TEST_PROJECTILE_SCALE, targets);
+
+        if (actual != expected)
+            mismatches++;
+
+        // Every target dies from its first hit.
+        if (expected != NO_HIT)
+        {
+            targets[expected].can_be_hit = false;
+            hits++;
+        }
+    }
+
+    CLOVE_INT_GT(hits, 0);
+    CLOVE_INT_EQ(0, mismatches);
+}
+
+// Test 4
+CLOVE_TEST(TestFastProjectileDoesNotTunnel)
+{
+    /**
+     * This test ensures that a projectile which moves through a target in a single update hits
+     * it, even though it does not overlap the target before or after moving.
+     */
+
+    const std::vector<HitTarget> targets = {
+        { .id = 1, .position = { 0.0f, 0.0f }, .scale = { 10.0f, 10.0f }, .can_be_hit = true }
+    };
+
+    const HitProjectile still{ .position = { 60.0f, 0.0f }, .direction = { 1.0f, 0.0f }, .owner_id = 2 };
+    HitProjectile moving = still;
+    moving.displacement = { 100.0f, 0.0f };
+
+    HitDetector detector{ 25.0f };
+    detector.Build(targets);
+
+    float time = -1.0f;
+
+    CLOVE_INT_EQ(NO_HIT, FindProjectileHit(still, TEST_PROJECTILE_SCALE, targets));
+    CLOVE_INT_EQ(0, FindProjectileHit(moving, TEST_PROJECTILE_SCALE, targets, &time));
+    CLOVE_FLOAT_EQ(0.275f, time);
+    CLOVE_INT_EQ(0, detector.FindProjectileHit(moving, TEST_PROJECTILE_SCALE, targets));
+}
+
+// Test 5
+CLOVE_TEST(TestFirstTargetAlongPathIsHit)
+{
+    /**
+     * This test ensures that a projectile which passes through several targets in one update
+     * hits the one it reaches first, rather than the one with the lowest index.
+     */
+
+    const std::vector<HitTarget> targets = {
+        { .id = 1, .position = { 60.0f, 0.0f }, .scale = { 10.0f, 10.0f }, .can_be_hit = true },
+        { .id = 2, .position = { 20.0f, 0.0f }, .scale = { 10.0f, 10.0f }, .can_be_hit = true }
+    };
+
+    const HitProjectile projectile{
+        .position = { 100.0f, 0.0f }, .direction = { 1.0f, 0.0f }, .owner_id = 3, .displacement = { 100.0f, 0.0f }
+    };
+
+    HitDetector detector{ 25.0f };
+    detector.Build(targets);
+
+    CLOVE_INT_EQ(1, FindProjectileHit(projectile, TEST_PROJECTILE_SCALE, targets));
+    CLOVE_INT_EQ(1, detector.FindProjectileHit(projectile, TEST_PROJECTILE_SCALE, targets));
+}
+
+// Test 6
+CLOVE_TEST(TestRotatedProjectileNearCornerMisses)
+{
+    /**
+     * This test ensures that a diagonal projectile beside the corner of a target does not hit
+     * it, even though the axis-aligned bounds of the projectile overlap the target.
+     */
+
+    const std::vector<HitTarget> targets = {
+        { .id = 1, .position = { 0.0f, 0.0f }, .scale = { 10.0f, 10.0f }, .can_be_hit = true }
+    };
+
+    const float diagonal = std::sqrt(0.5f);
+    const HitProjectile projectile{
+        .position = { 10.0f, -10.0f }, .direction = { diagonal, diagonal }, .owner_id = 2
+    };
+
+    glm::vec2 min, max;
+    Collision::GetBounds(GetProjectileBox(projectile, TEST_PROJECTILE_SCALE), min, max);
+
+    HitDetector detector{ 25.0f };
+    detector.Build(targets);
+
+    CLOVE_IS_TRUE(min.x < 5.0f && max.y > -5.0f);
+    CLOVE_INT_EQ(NO_HIT, FindProjectileHit(projectile, TEST_PROJECTILE_SCALE, targets));
+    CLOVE_INT_EQ(NO_HIT, detector.FindProjectileHit(projectile, TEST_PROJECTILE_SCALE, targets));
+}
@@ -0,0 +1,120 @@
+#define CLOVE_SUITE_NAME InterestManagerTests
+#include <clove-unit.h>
+
+#include <interest_manager.h>
+#include <room.h>
+
+#include "test_support.h"
+
+#include <memory>
+#include <vector>
+
+CLOVE_SUITE_SETUP_ONCE()
+{
+    InitialiseTestLogging();
+}
+
+/**
+ * \brief Adds a client to a room whose player has already joined, with the client's identifier
+ * as its connection.
+ */
+static void AddJoinedClient(Room& room, const unsigned int client_id, const glm::vec2 position)
+{
+    const size_t index = room.AddClient(client_id, "Player");
+
+    Player& player = room.GetClients().GetPlayers()[index];
+    player.SetId(client_id);
+    player.SetPosition(position);
+}
+
+// Test 1
+CLOVE_TEST(TestPlayersEnterAndLeaveWithHysteresis)
+{
+    /**
+     * This test ensures that a player is only spawned for a client once it comes within the
+     * enter radius, is kept while it stays within the leave radius, and is despawned once it
+     * passes the leave radius.
+     */
+
+    const Level level{};
+
+    // Record the type of every packet sent to a single client.
+    std::vector<PacketType> sent;
+    FakeTransport transport;
+    transport.on_send = [&sent](const Packet& packet, unsigned int) { sent.push_back(packet.GetType()); };
+
+    auto room = std::make_unique<Room>(0, level, transport);
+    const Room::Scope scope{ *room };
+
+    // The second client's region is centred far away, so only the first client is sent anything.
+    AddJoinedClient(*room, 1, { 0.0f, 0.0f });
+    AddJoinedClient(*room, 2, { 1.0e6f, 0.0f });
+
+    const auto update = [&sent](const float distance)
+    {
+        sent.clear();
+
+        WorldSnapshot world{};
+        world.players = { { .id = 1, .position = { 0.0f, 0.0f } }, { .id = 2, .position = { distance, 0.0f } } };
+
+        InterestManager::Update(world);
+    };
+
+    update(INTEREST_ENTER_RADIUS + 20.0f);
+    CLOVE_IS_TRUE(sent.empty());
+    CLOVE_IS_TRUE(InterestManager::GetPlayerViewers(2).empty());
+
+    update(INTEREST_ENTER_RADIUS - 50.0f);
+    CLOVE_INT_EQ(1, static_cast<int>(sent.size()));
+    CLOVE_IS_TRUE(sent[0] == PacketType::PlayerSpawn);
+
+    update(INTEREST_LEAVE_RADIUS - 30.0f);
+    CLOVE_IS_TRUE(sent.empty());
+    CLOVE_INT_EQ(1, static_cast<int>(InterestManager::GetPlayerViewers(2).size()));
+
+    update(INTEREST_LEAVE_RADIUS + 20.0f);
+    CLOVE_INT_EQ(1, static_cast<int>(sent.size()));
+    CLOVE_IS_TRUE(sent[0] == PacketType::PlayerDespawn);
+    CLOVE_IS_TRUE(InterestManager::GetPlayerViewers(2).empty());
+}
+
+// Test 2
+CLOVE_TEST(TestReusedProjectileSlotMustEnterAgain)
+{
+    /**
+     * This test ensures that a projectile whose slot is reused by a projectile of a later
+     * generation is not seen by the clients which saw the old projectile, unless the new one
+     * comes within the enter radius itself.
+     */
+
+    const Level level{};
+    const FakeTransport transport;
+    auto room = std::make_unique<Room>(0, level, transport);
+    const Room::Scope scope{ *room };
+
+    AddJoinedClient(*room, 1, { 0.0f, 0.0f });
+
+    const UUID first_id{ uint64_t{ 1 } << 32 | 7 };
+    const UUID second_id{ uint64_t{ 2 } << 32 | 7 };
+
+    WorldSnapshot world{};
+    world.players = { { .id = 1, .position = { 0.0f, 0.0f } } };
+    world.projectiles = { { .id = first_id, .position = { INTEREST_ENTER_RADIUS - 50.0f, 0.0f }, .rotation = 0.0f } };
+
+    InterestManager::Update(world);
+    CLOVE_INT_EQ(1, static_cast<int>(InterestManager::GetProjectileViewers(first_id).size()));
+
+    // The first projectile is destroyed, and its slot is reused just outside the enter radius.
+    world.projectiles = { { .id = second_id, .position = { INTEREST_LEAVE_RADIUS - 30.0f, 0.0f }, .rotation = 0.0f } };
+
+    InterestManager::Update(world);
+    CLOVE_IS_TRUE(InterestManager::GetProjectileViewers(first_id).empty());
+    CLOVE_IS_TRUE(InterestManager::GetProjectileViewers(second_id).empty());
+    CLOVE_IS_TRUE(InterestManager::GetView(1, world).projectiles.empty());
+
+    world.projectiles[0].position = { INTEREST_ENTER_RADIUS - 50.0f, 0.0f };
+
+    InterestManager::Update(world);
+    CLOVE_INT_EQ(1, static_cast<int>(InterestManager::GetProjectileViewers(second_id).size()));
+    CLOVE_INT_EQ(1, static_cast<int>(InterestManager::GetView(1, world).projectiles.size()));
+}
@@ -0,0 +1,67 @@
+#define CLOVE_SUITE_NAME MetricsExporterTests
+#include <clove-unit.h>
+
+#include <metrics_exporter.h>
+#include <tick_profiler.h>
+
+#include <common/networking/packet_stats.h>
+
+#include <sstream>
+#include <string>
+
+/**
+ * \brief Gets the value of the sample whose name and labels match a line of the metrics.
+ * \return The value, or -1 if there is no such sample.
+ */
+static double FindSample(const std::string& metrics, const std::string& sample)
+{
+    std::istringstream lines{ metrics };
+    std::string line;
+
+    while (std::getline(lines, line))
+    {
+        if (line.starts_with(sample + ' '))
+            return std::stod(line.substr(sample.size() + 1));
+    }
+
+    return -1.0;
+}
+
+// Test 1
+CLOVE_TEST(TestTickHistogramIsCumulative)
+{
+    /**
+     * This test ensures that each phase's histogram counts every duration in its +Inf bucket,
+     * and counts durations in every bucket whose bound is above them but not those below.
+     */
+
+    TickProfiler::Record(TickPhase::Dispatch, std::chrono::microseconds{ 3 });
+
+    const std::string metrics = MetricsExporter::Render({});
+
+    const double below = FindSample(metrics, R"(scx_tick_phase_seconds_bucket{phase="Dispatch",le="2.048e-06"})");
+    const double above = FindSample(metrics, R"(scx_tick_phase_seconds_bucket{phase="Dispatch",le="4.096e-06"})");
+    const double all = FindSample(metrics, R"(scx_tick_phase_seconds_bucket{phase="Dispatch",le="+Inf"})");
+
+    CLOVE_IS_TRUE(below >= 0.0);
+    CLOVE_IS_TRUE(above >= below + 1.0);
+    CLOVE_IS_TRUE(all >= above);
+    CLOVE_IS_TRUE(all == FindSample(metrics, R"(scx_tick_phase_seconds_count{phase="Dispatch"})"));
+}
+
+// Test 2
+CLOVE_TEST(TestPacketCountersByType)
+{
+    /**
+     * This test ensures that the packets counted for a type are exported under that type.
+     */
+
+    const double before = FindSample(MetricsExporter::Render({}), R"(scx_packets_sent_total{type="PlayerSpawn"})");
+
+    PacketStats::RecordSent(PacketType::PlayerSpawn, 10, 4);
+
+    const std::string metrics = MetricsExporter::Render({});
+
+    CLOVE_IS_TRUE(FindSample(metrics, R"(scx_packets_sent_total{type="PlayerSpawn"})") == before + 4.0);
+    CLOVE_IS_TRUE(FindSample(metrics, "scx_connected_clients") == 0.0);
+}
@@ -2,6 +2,11 @@
 #include <clove-unit.h>
 
 #include <player.h>
+#include <room.h>
+
+#include "test_support.h"
+
+#include <memory>
 
 // Test 1
 CLOVE_TEST(TestLowerBoundHealthClamp)
@@ -11,6 +16,12 @@ CLOVE_TEST(TestLowerBoundHealthClamp)
      * the zero, it is clamped to zero.
      */
 
+    // Health changes are sent to the clients of the current room.
+    const Level level{};
+    const FakeTransport transport;
+    auto room = std::make_unique<Room>(0, level, transport);
+    const Room::Scope scope{ *room };
+
     Player player{};
 
     // Lower health to zero
@@ -30,6 +41,11 @@ CLOVE_TEST(TestUpperBoundHealthClamp)
      * the maximum value, it is clamped to this maximum value.
      */
 
+    const Level level{};
+    const FakeTransport transport;
+    auto room = std::make_unique<Room>(0, level, transport);
+    const Room::Scope scope{ *room };
+
     Player player{};
 
     // Remove 10 health.
@@ -0,0 +1,67 @@
+#define CLOVE_SUITE_NAME PositionHistoryTests
+#include <clove-unit.h>
+
+#include <position_history.h>
+
+// Test 1
+CLOVE_TEST(TestRecordedPositionsCanBeFound)
+{
+    /**
+     * This test ensures that the position recorded at each tick can be found by its tick, and
+     * that a tick which was never recorded is not found.
+     */
+
+    PositionHistory history{};
+
+    for (uint64_t tick = 1; tick <= 10; tick++)
+        history.Record(tick, { static_cast<float>(tick), -static_cast<float>(tick) });
+
+    const auto position = history.GetPosition(4);
+
+    CLOVE_IS_TRUE(position.has_value());
+    CLOVE_FLOAT_EQ(4.0f, position->x);
+    CLOVE_FLOAT_EQ(-4.0f, position->y);
+    CLOVE_IS_FALSE(history.GetPosition(11).has_value());
+    CLOVE_IS_FALSE(history.GetPosition(0).has_value());
+}
+
+// Test 2
+CLOVE_TEST(TestOldPositionsAreReplaced)
+{
+    /**
+     * This test ensures that once more ticks have been recorded than the history holds, the
+     * oldest ticks are no longer found, rather than returning the newer position which has
+     * replaced them.
+     */
+
+    PositionHistory history{};
+
+    const uint64_t last = POSITION_HISTORY_LENGTH + 5;
+    for (uint64_t tick = 1; tick <= last; tick++)
+        history.Record(tick, { static_cast<float>(tick), 0.0f });
+
+    CLOVE_IS_FALSE(history.GetPosition(5).has_value());
+    CLOVE_IS_TRUE(history.GetPosition(6).has_value());
+    CLOVE_FLOAT_EQ(static_cast<float>(last), history.GetPosition(last)->x);
+}
+
+// Test 3
+CLOVE_TEST(TestClearRemovesPositions)
+{
+    /**
+     * This test ensures that clearing the history removes every recorded position, and that
+     * positions can be recorded again afterwards.
+     */
+
+    PositionHistory history{};
+    history.Record(1, { 1.0f, 1.0f });
+    history.Record(2, { 2.0f, 2.0f });
+
+    history.Clear();
+
+    CLOVE_IS_FALSE(history.GetPosition(1).has_value());
+    CLOVE_IS_FALSE(history.GetPosition(2).has_value());
+
+    history.Record(3, { 3.0f, 3.0f });
+    CLOVE_IS_TRUE(history.GetPosition(3).has_value());
+}
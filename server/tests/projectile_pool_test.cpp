@@ -0,0 +1,96 @@
+#define CLOVE_SUITE_NAME ProjectilePoolTests
+#include <clove-unit.h>
+
+#include <projectile_pool.h>
+
+// Test 1
+CLOVE_TEST(TestSpawnedProjectilesCanBeFound)
+{
+    /**
+     * This test ensures that each spawned projectile has a unique identifier which can be used
+     * to find its properties.
+     */
+
+    ProjectilePool pool{};
+
+    const UUID first = pool.Spawn({ 1.0f, 2.0f }, { 10.0f, 0.0f }, 1, 3.0f);
+    const UUID second = pool.Spawn({ 3.0f, 4.0f }, { 0.0f, 10.0f }, 2, 3.0f);
+
+    CLOVE_INT_EQ(2, static_cast<int>(pool.GetSize()));
+    CLOVE_IS_FALSE(first == second);
+
+    const auto index = pool.Find(second);
+
+    CLOVE_IS_TRUE(index.has_value());
+    CLOVE_FLOAT_EQ(3.0f, pool.GetPositions()[*index].x);
+    CLOVE_INT_EQ(2, static_cast<int>(pool.GetOwners()[*index]));
+}
+
+// Test 2
+CLOVE_TEST(TestRemoveMovesLastProjectile)
+{
+    /**
+     * This test ensures that removing a projectile moves the last projectile into its place,
+     * and that the moved projectile can still be found by its identifier.
+     */
+
+    ProjectilePool pool{};
+
+    const UUID first = pool.Spawn({ 1.0f, 0.0f }, { 0.0f, 0.0f }, 1, 3.0f);
+    pool.Spawn({ 2.0f, 0.0f }, { 0.0f, 0.0f }, 1, 3.0f);
+    const UUID last = pool.Spawn({ 3.0f, 0.0f }, { 0.0f, 0.0f }, 1, 3.0f);
+
+    pool.Remove(0);
+
+    CLOVE_INT_EQ(2, static_cast<int>(pool.GetSize()));
+    CLOVE_IS_FALSE(pool.Find(first).has_value());
+    CLOVE_INT_EQ(0, static_cast<int>(*pool.Find(last)));
+    CLOVE_FLOAT_EQ(3.0f, pool.GetPositions()[0].x);
+}
+
+// Test 3
+CLOVE_TEST(TestReusedSlotHasNewIdentifier)
+{
+    /**
+     * This test ensures that the identifier of a removed projectile does not find the
+     * projectile which reuses its slot.
+     */
+
+    ProjectilePool pool{};
+
+    const UUID removed = pool.Spawn({ 0.0f, 0.0f }, { 0.0f, 0.0f }, 1, 3.0f);
+    pool.Remove(0);
+
+    const UUID reused = pool.Spawn({ 0.0f, 0.0f }, { 0.0f, 0.0f }, 1, 3.0f);
+
+    CLOVE_IS_FALSE(removed == reused);
+    CLOVE_IS_FALSE(pool.Find(removed).has_value());
+    CLOVE_IS_TRUE(pool.Find(reused).has_value());
+}
+
+// Test 4
+CLOVE_TEST(TestProjectilesExpireAfterLifetime)
+{
+    /**
+     * This test ensures that a projectile expires once its lifetime has been simulated, or
+     * as soon as it is explicitly expired.
+     */
+
+    ProjectilePool pool{};
+    pool.Spawn({ 0.0f, 0.0f }, { 10.0f, 0.0f }, 1, 1.0f);
+    pool.Spawn({ 0.0f, 0.0f }, { 10.0f, 0.0f }, 1, 5.0f);
+
+    pool.Integrate(0.5f);
+
+    CLOVE_IS_FALSE(pool.HasExpired(0));
+    CLOVE_FLOAT_EQ(5.0f, pool.GetPositions()[0].x);
+
+    pool.Integrate(0.5f);
+
+    CLOVE_IS_TRUE(pool.HasExpired(0));
+    CLOVE_IS_FALSE(pool.HasExpired(1));
+
+    pool.Expire(1);
+
+    CLOVE_IS_TRUE(pool.HasExpired(1));
+}
@@ -0,0 +1,272 @@
+#define CLOVE_SUITE_NAME RingBufferTests
+#include <clove-unit.h>
+
+#include <ring_buffer.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+constexpr size_t STRESS_PRODUCERS = 4;
+constexpr uint64_t STRESS_VALUES_PER_PRODUCER = 100'000;
+
+// Test 1
+CLOVE_TEST(TestSpscPopsInOrderAcrossWraparound)
+{
+    /**
+     * This test ensures that the values of a single producer ring buffer are popped in the
+     * order they were pushed, while its indices wrap around its slots many times.
+     */
+
+    SpscRingBuffer<int, 4> buffer{};
+
+    int next_push = 0, next_pop = 0;
+    for (int round = 0; round < 10; round++)
+    {
+        for (int i = 0; i < 3; i++)
+            CLOVE_IS_TRUE(buffer.TryPush(int{ next_push++ }));
+
+        int value = -1;
+        for (int i = 0; i < 3; i++)
+        {
+            CLOVE_IS_TRUE(buffer.TryPop(value));
+            CLOVE_INT_EQ(next_pop++, value);
+        }
+    }
+
+    CLOVE_INT_EQ(0, static_cast<int>(buffer.Size()));
+}
+
+// Test 2
+CLOVE_TEST(TestSpscFullAndEmpty)
+{
+    /**
+     * This test ensures that a single producer ring buffer refuses pops while empty and pushes
+     * while full, and accepts a push again as soon as a value has been popped.
+     */
+
+    SpscRingBuffer<int, 4> buffer{};
+
+    int value = -1;
+    CLOVE_IS_FALSE(buffer.TryPop(value));
+
+    for (int i = 0; i < 4; i++)
+        CLOVE_IS_TRUE(buffer.TryPush(int{ i }));
+
+    CLOVE_IS_FALSE(buffer.TryPush(4));
+    CLOVE_INT_EQ(4, static_cast<int>(buffer.Size()));
+
+    CLOVE_IS_TRUE(buffer.TryPop(value));
+    CLOVE_INT_EQ(0, value);
+    CLOVE_IS_TRUE(buffer.TryPush(4));
+    CLOVE_IS_FALSE(buffer.TryPush(5));
+
+    for (int i = 1; i <= 4; i++)
+    {
+        CLOVE_IS_TRUE(buffer.TryPop(value));
+        CLOVE_INT_EQ(i, value);
+    }
+
+    CLOVE_IS_FALSE(buffer.TryPop(value));
+}
+
+// Test 3
+CLOVE_TEST(TestSpscBatchPushesWhatFits)
+{
+    /**
+     * This test ensures that a batch larger than the free space of a single producer ring
+     * buffer only pushes its first values, and that a batch which wraps around the slots keeps
+     * its order.
+     */
+
+    SpscRingBuffer<int, 8> buffer{};
+
+    std::array<int, 6> values{ 0, 1, 2, 3, 4, 5 };
+    CLOVE_INT_EQ(6, static_cast<int>(buffer.TryPushBatch(values.data(), values.size())));
+
+    std::array<int, 6> more{ 6, 7, 8, 9, 10, 11 };
+    CLOVE_INT_EQ(2, static_cast<int>(buffer.TryPushBatch(more.data(), more.size())));
+    CLOVE_INT_EQ(0, static_cast<int>(buffer.TryPushBatch(more.data() + 2, more.size() - 2)));
+
+    int value = -1;
+    for (int i = 0; i < 5; i++)
+    {
+        CLOVE_IS_TRUE(buffer.TryPop(value));
+        CLOVE_INT_EQ(i, value);
+    }
+
+    // The rest of the batch wraps around to the start of the slots.
+    CLOVE_INT_EQ(4, static_cast<int>(buffer.TryPushBatch(more.data() + 2, more.size() - 2)));
+
+    for (int i = 5; i < 12; i++)
+    {
+        CLOVE_IS_TRUE(buffer.TryPop(value));
+        CLOVE_INT_EQ(i, value);
+    }
+
+    CLOVE_IS_FALSE(buffer.TryPop(value));
+}
+
+// Test 4
+CLOVE_TEST(TestMpscPopsInOrderAcrossWraparound)
+{
+    /**
+     * This test ensures that the values of a multiple producer ring buffer pushed by one
+     * thread are popped in the order they were pushed, while its indices wrap around its slots
+     * many times.
+     */
+
+    MpscRingBuffer<int, 4> buffer{};
+
+    int next_push = 0, next_pop = 0;
+    for (int round = 0; round < 10; round++)
+    {
+        for (int i = 0; i < 3; i++)
+            CLOVE_IS_TRUE(buffer.TryPush(int{ next_push++ }));
+
+        int value = -1;
+        for (int i = 0; i < 3; i++)
+        {
+            CLOVE_IS_TRUE(buffer.TryPop(value));
+            CLOVE_INT_EQ(next_pop++, value);
+        }
+    }
+
+    CLOVE_INT_EQ(0, static_cast<int>(buffer.Size()));
+}
+
+// Test 5
+CLOVE_TEST(TestMpscFullAndEmpty)
+{
+    /**
+     * This test ensures that a multiple producer ring buffer refuses pops while empty and
+     * pushes while full, and accepts a push again as soon as a value has been popped.
+     */
+
+    MpscRingBuffer<int, 4> buffer{};
+
+    int value = -1;
+    CLOVE_IS_FALSE(buffer.TryPop(value));
+
+    for (int i = 0; i < 4; i++)
+        CLOVE_IS_TRUE(buffer.TryPush(int{ i }));
+
+    CLOVE_IS_FALSE(buffer.TryPush(4));
+
+    CLOVE_IS_TRUE(buffer.TryPop(value));
+    CLOVE_INT_EQ(0, value);
+    CLOVE_IS_TRUE(buffer.TryPush(4));
+    CLOVE_IS_FALSE(buffer.TryPush(5));
+
+    for (int i = 1; i <= 4; i++)
+    {
+        CLOVE_IS_TRUE(buffer.TryPop(value));
+        CLOVE_INT_EQ(i, value);
+    }
+
+    CLOVE_IS_FALSE(buffer.TryPop(value));
+}
+
+// Test 6
+CLOVE_TEST(TestSpscStressLosesNothing)
+{
+    /**
+     * This test ensures that every value a producer thread pushes in batches is popped exactly
+     * once and in order by a consumer thread running alongside it.
+     */
+
+    auto buffer = std::make_unique<SpscRingBuffer<uint64_t, 64>>();
+
+    std::thread producer{ [&buffer]
+    {
+        std::array<uint64_t, 16> batch{};
+        uint64_t next = 0;
+
+        while (next < STRESS_VALUES_PER_PRODUCER)
+        {
+            const size_t count = std::min<uint64_t>(batch.size(), STRESS_VALUES_PER_PRODUCER - next);
+            for (size_t i = 0; i < count; i++)
+                batch[i] = next + i;
+
+            const size_t pushed = buffer->TryPushBatch(batch.data(), count);
+            next += pushed;
+
+            if (pushed < count)
+                std::this_thread::yield();
+        }
+    } };
+
+    bool is_ordered = true;
+    uint64_t value = 0;
+
+    for (uint64_t expected = 0; expected < STRESS_VALUES_PER_PRODUCER; expected++)
+    {
+        while (!buffer->TryPop(value))
+            std::this_thread::yield();
+
+        is_ordered = is_ordered && value == expected;
+    }
+
+    producer.join();
+
+    CLOVE_IS_TRUE(is_ordered);
+    CLOVE_IS_FALSE(buffer->TryPop(value));
+}
+
+// Test 7
+CLOVE_TEST(TestMpscStressLosesNothing)
+{
+    /**
+     * This test ensures that every value pushed by several producer threads at once is popped
+     * exactly once, and that the values of each producer are popped in the order it pushed
+     * them.
+     */
+
+    auto buffer = std::make_unique<MpscRingBuffer<uint64_t, 64>>();
+
+    std::vector<std::thread> producers;
+    for (uint64_t producer = 0; producer < STRESS_PRODUCERS; producer++)
+    {
+        producers.emplace_back([producer, &buffer]
+        {
+            for (uint64_t i = 0; i < STRESS_VALUES_PER_PRODUCER; i++)
+            {
+                while (!buffer->TryPush(producer << 32 | i))
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    // Each producer's values must arrive in order, so the next value expected from each
+    // producer is enough to detect any value which is lost, duplicated or reordered.
+    std::array<uint64_t, STRESS_PRODUCERS> next{};
+    bool is_ordered = true;
+    uint64_t value = 0;
+
+    for (uint64_t popped = 0; popped < STRESS_PRODUCERS * STRESS_VALUES_PER_PRODUCER; popped++)
+    {
+        while (!buffer->TryPop(value))
+            std::this_thread::yield();
+
+        const uint64_t producer = value >> 32;
+        if (producer >= STRESS_PRODUCERS || (value & 0xFFFFFFFF) != next[producer])
+        {
+            is_ordered = false;
+            continue;
+        }
+
+        next[producer]++;
+    }
+
+    for (auto& thread : producers)
+        thread.join();
+
+    CLOVE_IS_TRUE(is_ordered);
+    CLOVE_IS_FALSE(buffer->TryPop(value));
+
+    for (const uint64_t count : next)
+        CLOVE_IS_TRUE(count == STRESS_VALUES_PER_PRODUCER);
+}
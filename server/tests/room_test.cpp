@@ -0,0 +1,170 @@
+#define CLOVE_SUITE_NAME RoomTests
+#include <clove-unit.h>
+
+#include <room.h>
+#include <room_manager.h>
+
+#include "test_support.h"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+CLOVE_SUITE_SETUP_ONCE()
+{
+    InitialiseTestLogging();
+}
+
+// Test 1
+CLOVE_TEST(TestScopeRestoresThePreviousRoom)
+{
+    /**
+     * This test ensures that a scope makes its room the current room of the thread, and that
+     * the previous current room is restored when a nested scope ends.
+     */
+
+    const Level level{};
+    const FakeTransport transport;
+
+    auto outer = std::make_unique<Room>(0, level, transport);
+    auto inner = std::make_unique<Room>(1, level, transport);
+
+    const Room::Scope outer_scope{ *outer };
+    CLOVE_UINT_EQ(0, Room::GetCurrent().GetId());
+
+    {
+        const Room::Scope inner_scope{ *inner };
+        CLOVE_UINT_EQ(1, Room::GetCurrent().GetId());
+    }
+
+    CLOVE_UINT_EQ(0, Room::GetCurrent().GetId());
+}
+
+// Test 2
+CLOVE_TEST(TestRoomIsParkedWithoutClients)
+{
+    /**
+     * This test ensures that a room is parked until a client is added to it, and that each
+     * added client's connection is one of the room's connections.
+     */
+
+    const Level level{};
+    const FakeTransport transport;
+    auto room = std::make_unique<Room>(0, level, transport);
+
+    CLOVE_IS_TRUE(room->IsParked());
+
+    const size_t index = room->AddClient(10, "First");
+
+    CLOVE_IS_FALSE(room->IsParked());
+    CLOVE_UINT_EQ(10, room->GetClients().GetInfo()[index].connection);
+    CLOVE_INT_EQ(1, static_cast<int>(room->GetConnections().size()));
+    CLOVE_UINT_EQ(10, room->GetConnections()[0]);
+}
+
+// Test 3
+CLOVE_TEST(TestPingsAreSampledAtALowRate)
+{
+    /**
+     * This test ensures that the round-trip time of a client is sampled when it is added, and
+     * that the round-trip times of a room's clients are sampled by its first update, but not
+     * again by the updates which closely follow it.
+     */
+
+    const Level level{};
+    const FakeTransport transport{ 30 };
+    auto room = std::make_unique<Room>(0, level, transport);
+
+    const size_t index = room->AddClient(10, "First");
+
+    CLOVE_UINT_EQ(1, transport.GetPingSamples());
+    CLOVE_INT_EQ(30, room->GetClients().GetInfo()[index].ping);
+
+    for (int i = 0; i < 10; i++)
+        room->Update(1.0 / 60.0, 1);
+
+    CLOVE_UINT_EQ(2, transport.GetPingSamples());
+    CLOVE_INT_EQ(30, room->GetClients().GetInfo()[index].ping);
+}
+
+/**
+ * \brief Waits for the rooms' tick threads until a condition on the stats of the rooms holds.
+ * \return A true or false value indicating whether the condition held within a second.
+ */
+template <typename F>
+static bool WaitForRoomStats(F&& condition)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 1 };
+
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (condition(RoomManager::GetRoomStats()))
+            return true;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+    }
+
+    return false;
+}
+
+// Test 4
+CLOVE_TEST(TestClientsArePackedIntoTheBusiestRoom)
+{
+    /**
+     * This test ensures that new clients fill the busiest room which has space, and that a
+     * parked room is only opened once every active room is full.
+     */
+
+    const Level level{};
+    const FakeTransport transport;
+    RoomManager::Initialise(transport, level, 3, 2, 60, std::chrono::microseconds{ 0 });
+
+    for (unsigned int client_id = 1; client_id <= MAX_ROOM_CLIENTS + 1; client_id++)
+        RoomManager::AssignClient(client_id, "Player");
+
+    std::vector<RoomStats> stats = RoomManager::GetRoomStats();
+    CLOVE_UINT_EQ(MAX_ROOM_CLIENTS, stats[0].clients);
+    CLOVE_UINT_EQ(1, stats[1].clients);
+    CLOVE_UINT_EQ(0, stats[2].clients);
+    CLOVE_IS_TRUE(stats[2].is_parked);
+
+    // A slot freed in the busiest room is filled before the emptier active room.
+    RoomManager::RemoveClient(1);
+    RoomManager::AssignClient(MAX_ROOM_CLIENTS + 2, "Player");
+
+    stats = RoomManager::GetRoomStats();
+    CLOVE_UINT_EQ(MAX_ROOM_CLIENTS, stats[0].clients);
+    CLOVE_UINT_EQ(1, stats[1].clients);
+    CLOVE_IS_TRUE(stats[2].is_parked);
+
+    RoomManager::Dispose();
+}
+
+// Test 5
+CLOVE_TEST(TestLeaveBeforeJoinParksTheRoom)
+{
+    /**
+     * This test ensures that a client which leaves before its join has been applied is never
+     * left behind in its room, so the room parks again, and that the client can be assigned
+     * a room afterwards.
+     */
+
+    const Level level{};
+    const FakeTransport transport;
+    RoomManager::Initialise(transport, level, 1, 1, 60, std::chrono::microseconds{ 0 });
+
+    RoomManager::AssignClient(1, "Player");
+    RoomManager::RemoveClient(1);
+
+    CLOVE_IS_TRUE(WaitForRoomStats([](const std::vector<RoomStats>& stats) { return stats[0].is_parked; }));
+
+    RoomManager::AssignClient(1, "Player");
+
+    CLOVE_IS_TRUE(WaitForRoomStats([](const std::vector<RoomStats>& stats)
+    {
+        return stats[0].clients == 1 && !stats[0].is_parked;
+    }));
+
+    RoomManager::Dispose();
+}
@@ -0,0 +1,106 @@
+#define CLOVE_SUITE_NAME SpatialGridTests
+#include <clove-unit.h>
+
+#include <physics/spatial_grid.h>
+
+#include <algorithm>
+#include <vector>
+
+/**
+ * \brief Gets the sorted indices visited by a query of a grid.
+ */
+static std::vector<uint32_t> QueryIndices(const SpatialGrid& grid, const glm::vec2 centre, const float radius)
+{
+    std::vector<uint32_t> indices;
+    grid.Query(centre, radius, [&indices](const uint32_t index) { indices.push_back(index); });
+
+    std::ranges::sort(indices);
+
+    return indices;
+}
+
+// Test 1
+CLOVE_TEST(TestQueryFindsNearbyPoints)
+{
+    /**
+     * This test ensures that a query visits every point within its radius, including points
+     * in neighbouring cells and at negative coordinates.
+     */
+
+    SpatialGrid grid{ 100.0f };
+    grid.Insert(0, { 10.0f, 10.0f });
+    grid.Insert(1, { 150.0f, 10.0f });
+    grid.Insert(2, { -60.0f, -40.0f });
+
+    const std::vector<uint32_t> indices = QueryIndices(grid, { 50.0f, 0.0f }, 110.0f);
+
+    CLOVE_INT_EQ(3, static_cast<int>(indices.size()));
+    CLOVE_INT_EQ(0, static_cast<int>(indices[0]));
+    CLOVE_INT_EQ(1, static_cast<int>(indices[1]));
+    CLOVE_INT_EQ(2, static_cast<int>(indices[2]));
+}
+
+// Test 2
+CLOVE_TEST(TestQuerySkipsDistantPoints)
+{
+    /**
+     * This test ensures that a query does not visit points in cells which do not overlap its
+     * radius.
+     */
+
+    SpatialGrid grid{ 100.0f };
+    grid.Insert(0, { 0.0f, 0.0f });
+    grid.Insert(1, { 1000.0f, 0.0f });
+    grid.Insert(2, { 0.0f, -1000.0f });
+
+    const std::vector<uint32_t> indices = QueryIndices(grid, { 0.0f, 0.0f }, 50.0f);
+
+    CLOVE_INT_EQ(1, static_cast<int>(indices.size()));
+    CLOVE_INT_EQ(0, static_cast<int>(indices[0]));
+}
+
+// Test 3
+CLOVE_TEST(TestClearRemovesPoints)
+{
+    /**
+     * This test ensures that a grid which has been cleared no longer holds any points, and
+     * that points can be added to it again.
+     */
+
+    SpatialGrid grid{ 100.0f };
+    grid.Insert(0, { 0.0f, 0.0f });
+    grid.Clear();
+
+    CLOVE_IS_TRUE(QueryIndices(grid, { 0.0f, 0.0f }, 50.0f).empty());
+
+    grid.Insert(1, { 20.0f, 20.0f });
+
+    const std::vector<uint32_t> indices = QueryIndices(grid, { 0.0f, 0.0f }, 50.0f);
+
+    CLOVE_INT_EQ(1, static_cast<int>(indices.size()));
+    CLOVE_INT_EQ(1, static_cast<int>(indices[0]));
+}
+
+// Test 4
+CLOVE_TEST(TestClearErasesUnusedCells)
+{
+    /**
+     * This test ensures that the cells of a grid whose points keep moving are erased once they
+     * have been left empty, so that the grid does not grow with every cell ever visited.
+     */
+
+    SpatialGrid grid{ 100.0f };
+
+    for (int i = 0; i < 1000; i++)
+    {
+        grid.Clear();
+        grid.Insert(0, { static_cast<float>(i) * 100.0f, 0.0f });
+    }
+
+    CLOVE_IS_TRUE(grid.GetCellCount() <= 2);
+
+    const std::vector<uint32_t> indices = QueryIndices(grid, { 99900.0f, 0.0f }, 50.0f);
+
+    CLOVE_INT_EQ(1, static_cast<int>(indices.size()));
+    CLOVE_INT_EQ(0, static_cast<int>(indices[0]));
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <client_transport.h>
+
+#include <common/utils/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+
+/**
+ * \brief A transport which drops every packet, so that rooms can be updated without a server.
+ * It counts the packets which would have been sent and how often the round-trip times of the
+ * clients are sampled, and calls the observers a test sets with each packet. The observers must
+ * be set before the transport is used, and must be safe to call from every thread which uses it.
+ */
+class FakeTransport final : public IClientTransport
+{
+public:
+    /**
+     * \brief Called with each packet sent to a single client.
+     */
+    std::function<void(const Packet&, unsigned int)> on_send;
+
+    /**
+     * \brief Called with each packet sent to a set of clients, and the client excluded from it.
+     */
+    std::function<void(const Packet&, std::span<const HSteamNetConnection>, HSteamNetConnection)> on_multicast;
+
+    /**
+     * \brief Creates a transport.
+     * \param ping The round-trip time reported for every client, or nothing to report that the
+     * status of every connection is unavailable.
+     */
+    explicit FakeTransport(const std::optional<int> ping = std::nullopt)
+        : m_ping{ ping }
+    {
+    }
+
+    void Send(const Packet& packet, const unsigned int client) const override
+    {
+        m_packets.fetch_add(1, std::memory_order_relaxed);
+
+        if (on_send)
+            on_send(packet, client);
+    }
+
+    void Multicast(const Packet& packet, const std::span<const HSteamNetConnection> clients,
+                   const HSteamNetConnection except) const override
+    {
+        // The excluded client is not sent the packet, as with the server's transport.
+        const auto excluded = std::ranges::count(clients, except);
+        m_packets.fetch_add(clients.size() - static_cast<size_t>(excluded), std::memory_order_relaxed);
+
+        if (on_multicast)
+            on_multicast(packet, clients, except);
+    }
+
+    [[nodiscard]] std::optional<int> GetPing(HSteamNetConnection) const override
+    {
+        m_ping_samples.fetch_add(1, std::memory_order_relaxed);
+        return m_ping;
+    }
+
+    /**
+     * \brief Gets the number of packets which would have been sent to a client.
+     */
+    [[nodiscard]] uint64_t GetPacketCount() const
+    {
+        return m_packets.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Gets the number of times the round-trip time of a client has been sampled.
+     */
+    [[nodiscard]] uint64_t GetPingSamples() const
+    {
+        return m_ping_samples.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::optional<int> m_ping;
+    mutable std::atomic<uint64_t> m_packets{ 0 };
+    mutable std::atomic<uint64_t> m_ping_samples{ 0 };
+};
+
+/**
+ * \brief Creates the core logger with its output turned off, unless another suite already has,
+ * so that the code under test can log.
+ */
+inline void InitialiseTestLogging()
+{
+#ifdef SCX_LOGGING
+    if (!Logging::GetCoreLogger())
+    {
+        Logging::Initialise("TESTS");
+        Logging::GetCoreLogger()->set_level(spdlog::level::off);
+    }
+#endif
+}
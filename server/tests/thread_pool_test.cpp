@@ -0,0 +1,216 @@
+#define CLOVE_SUITE_NAME ThreadPoolTests
+#include <clove-unit.h>
+
+#include <server_packet_dispatcher.h>
+#include <server_packet_handler.h>
+#include <thread_pool.h>
+
+#include <common/networking/packet.h>
+#include <common/networking/packet_stats.h>
+
+#include "test_support.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+constexpr unsigned int STRAND_TEST_CLIENTS = 8;
+constexpr uint32_t STRAND_TEST_PACKETS = 4000;
+
+/**
+ * \brief A dispatcher which records the order of the packets the workers send to each client,
+ * instead of sending them, and whether two workers ever send to the same client at once.
+ */
+class RecordingDispatcher final : public ServerPacketDispatcher
+{
+public:
+    RecordingDispatcher()
+        : ServerPacketDispatcher{ nullptr }
+    {
+    }
+
+    void SendToClient(const Packet& packet, const unsigned int client) const override
+    {
+        Client& recorded = m_clients[client];
+
+        if (recorded.is_sending.exchange(true, std::memory_order_acquire))
+            m_has_overlapped = true;
+
+        // Each packet carries its index among the packets sent to its client.
+        Packet copy = packet;
+        uint32_t index = 0;
+        copy.Read(index);
+
+        if (index != recorded.next_index)
+            m_is_out_of_order = true;
+
+        recorded.next_index = index + 1;
+        recorded.sent.fetch_add(1, std::memory_order_release);
+        recorded.is_sending.store(false, std::memory_order_release);
+    }
+
+    [[nodiscard]] uint32_t GetSent(const unsigned int client) const
+    {
+        return m_clients[client].sent.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] bool HasOverlapped() const
+    {
+        return m_has_overlapped;
+    }
+
+    [[nodiscard]] bool IsOutOfOrder() const
+    {
+        return m_is_out_of_order;
+    }
+
+private:
+    struct Client
+    {
+        std::atomic<bool> is_sending{ false };
+        std::atomic<uint32_t> sent{ 0 };
+        uint32_t next_index{ 0 };
+    };
+
+    mutable std::array<Client, STRAND_TEST_CLIENTS + 1> m_clients{};
+    mutable std::atomic<bool> m_has_overlapped{ false };
+    mutable std::atomic<bool> m_is_out_of_order{ false };
+};
+
+/**
+ * \brief Gets the number of packets of a type which have been handled by the workers.
+ */
+static uint64_t GetHandled(const PacketType type)
+{
+    return PacketStats::GetSnapshot().types[static_cast<size_t>(type)].handled;
+}
+
+CLOVE_SUITE_SETUP_ONCE()
+{
+    InitialiseTestLogging();
+}
+
+// Test 1
+CLOVE_TEST(TestStrandsSendInOrderOneAtATime)
+{
+    /**
+     * This test ensures that the packets queued for each client are all sent, in the order
+     * they were queued, and never by two workers at once, while several workers share the
+     * clients' strands.
+     */
+
+    const ServerPacketHandler handler{};
+    const RecordingDispatcher dispatcher{};
+    ThreadPool::Initialise(handler, dispatcher, 4);
+
+    for (unsigned int client = 1; client <= STRAND_TEST_CLIENTS; client++)
+        ThreadPool::OpenStrand(client);
+
+    for (uint32_t index = 0; index < STRAND_TEST_PACKETS; index++)
+    {
+        for (unsigned int client = 1; client <= STRAND_TEST_CLIENTS; client++)
+        {
+            // Never queue more packets than a strand can hold, so that none are dropped.
+            while (index - dispatcher.GetSent(client) >= DISPATCHING_QUEUE_CAPACITY)
+                std::this_thread::yield();
+
+            Packet packet{ PacketType::PlayerMovement };
+            packet.Write(index);
+
+            ThreadPool::EnqueuePacketToSend(packet, client);
+        }
+    }
+
+    for (unsigned int client = 1; client <= STRAND_TEST_CLIENTS; client++)
+    {
+        while (dispatcher.GetSent(client) < STRAND_TEST_PACKETS)
+            std::this_thread::yield();
+    }
+
+    for (unsigned int client = 1; client <= STRAND_TEST_CLIENTS; client++)
+        ThreadPool::CloseStrand(client);
+
+    ThreadPool::Dispose();
+
+    CLOVE_IS_FALSE(dispatcher.HasOverlapped());
+    CLOVE_IS_FALSE(dispatcher.IsOutOfOrder());
+}
+
+// Test 2
+CLOVE_TEST(TestStrandsHandleEveryBatch)
+{
+    /**
+     * This test ensures that every packet handed to the strands in batches is handled once.
+     */
+
+    const ServerPacketHandler handler{};
+    const RecordingDispatcher dispatcher{};
+    ThreadPool::Initialise(handler, dispatcher, 2);
+
+    for (unsigned int client = 1; client <= STRAND_TEST_CLIENTS; client++)
+        ThreadPool::OpenStrand(client);
+
+    Packet input{ PacketType::PlayerInput };
+    for (int i = 0; i < 4; i++)
+        input.Write(false);
+
+    const uint64_t handled_before = GetHandled(PacketType::PlayerInput);
+
+    // Each client is sent fewer packets than its handling queue holds, so none are dropped.
+    std::vector<PacketInfoFromClient> batch(HANDLING_QUEUE_CAPACITY / 4);
+    for (int round = 0; round < 4; round++)
+    {
+        for (unsigned int client = 1; client <= STRAND_TEST_CLIENTS; client++)
+        {
+            for (auto& packet_info : batch)
+                packet_info = { .from_client = client, .packet = input };
+
+            ThreadPool::EnqueuePacketsToHandle(batch, client);
+        }
+    }
+
+    const uint64_t expected = static_cast<uint64_t>(HANDLING_QUEUE_CAPACITY) * STRAND_TEST_CLIENTS;
+    while (GetHandled(PacketType::PlayerInput) - handled_before < expected)
+        std::this_thread::yield();
+
+    for (unsigned int client = 1; client <= STRAND_TEST_CLIENTS; client++)
+        ThreadPool::CloseStrand(client);
+
+    ThreadPool::Dispose();
+
+    CLOVE_IS_TRUE(GetHandled(PacketType::PlayerInput) - handled_before == expected);
+}
+
+// Test 3
+CLOVE_TEST(TestClosedStrandSendsNothing)
+{
+    /**
+     * This test ensures that packets queued for a client after its strand has been closed are
+     * never sent, while the strands of other clients carry on.
+     */
+
+    const ServerPacketHandler handler{};
+    const RecordingDispatcher dispatcher{};
+    ThreadPool::Initialise(handler, dispatcher, 2);
+
+    ThreadPool::OpenStrand(1);
+    ThreadPool::OpenStrand(2);
+    ThreadPool::CloseStrand(1);
+
+    Packet packet{ PacketType::PlayerMovement };
+    packet.Write(uint32_t{ 0 });
+
+    ThreadPool::EnqueuePacketToSend(packet, 1);
+    ThreadPool::EnqueuePacketToSend(packet, 2);
+
+    while (dispatcher.GetSent(2) < 1)
+        std::this_thread::yield();
+
+    ThreadPool::CloseStrand(2);
+    ThreadPool::Dispose();
+
+    CLOVE_UINT_EQ(0, dispatcher.GetSent(1));
+    CLOVE_UINT_EQ(1, dispatcher.GetSent(2));
+}
@@ -0,0 +1,73 @@
+#define CLOVE_SUITE_NAME TickProfilerTests
+#include <clove-unit.h>
+
+#include <tick_profiler.h>
+
+#include <thread>
+
+// Test 1
+CLOVE_TEST(TestBucketsContainDurations)
+{
+    /**
+     * This test ensures that every duration falls below the upper bound of its bucket and at
+     * or above the upper bound of the bucket before it.
+     */
+
+    for (const uint64_t ns : { 0ull, 1023ull, 1024ull, 1500ull, 16'666'667ull, 1'000'000'000ull })
+    {
+        const size_t bucket = DurationHistogram::GetBucket(ns);
+
+        CLOVE_IS_TRUE(ns < DurationHistogram::GetBucketUpperBound(bucket));
+        if (bucket > 0)
+            CLOVE_IS_TRUE(ns >= DurationHistogram::GetBucketUpperBound(bucket - 1));
+    }
+}
+
+// Test 2
+CLOVE_TEST(TestPercentiles)
+{
+    /**
+     * This test ensures that percentiles are estimated within a bucket of the recorded
+     * durations, and that the maximum is exact.
+     */
+
+    DurationHistogram histogram{};
+
+    // 99 short durations of 10 microseconds, and a single long one of 5 milliseconds.
+    for (int i = 0; i < 99; i++)
+        histogram.Record(10'000);
+    histogram.Record(5'000'000);
+
+    const uint64_t p50 = histogram.GetPercentile(0.50);
+
+    CLOVE_UINT_EQ(100u, static_cast<unsigned int>(histogram.count));
+    CLOVE_IS_TRUE(p50 >= 10'000 && p50 < 12'500);
+    CLOVE_IS_TRUE(histogram.GetPercentile(0.99) < 12'500);
+    CLOVE_UINT_EQ(5'000'000u, static_cast<unsigned int>(histogram.GetPercentile(1.0)));
+    CLOVE_UINT_EQ(5'000'000u, static_cast<unsigned int>(histogram.max_ns));
+}
+
+// Test 3
+CLOVE_TEST(TestMergesThreads)
+{
+    /**
+     * This test ensures that the durations recorded by several threads are merged into the
+     * profile, and that a later profile only differs from an earlier one by the durations
+     * recorded in between.
+     */
+
+    const TickProfile before = TickProfiler::GetProfile();
+
+    std::thread first{ [] { TickProfiler::Record(TickPhase::Collisions, std::chrono::microseconds{ 20 }); } };
+    std::thread second{ [] { TickProfiler::Record(TickPhase::Collisions, std::chrono::microseconds{ 40 }); } };
+    first.join();
+    second.join();
+
+    const TickProfile window = TickProfiler::GetProfile().Since(before);
+    const DurationHistogram& collisions = window.Get(TickPhase::Collisions);
+
+    CLOVE_UINT_EQ(2u, static_cast<unsigned int>(collisions.count));
+    CLOVE_UINT_EQ(60'000u, static_cast<unsigned int>(collisions.total_ns));
+    CLOVE_IS_TRUE(collisions.max_ns >= 40'000);
+    CLOVE_UINT_EQ(0u, static_cast<unsigned int>(window.Get(TickPhase::Dispatch).count));
+}
@@ -0,0 +1,71 @@
+#define CLOVE_SUITE_NAME TickSchedulerTests
+#include <clove-unit.h>
+
+#include <tick_scheduler.h>
+
+#include <thread>
+
+// Test 1
+CLOVE_TEST(TestFixedDeltaTime)
+{
+    /**
+     * This test ensures that the fixed time step is the length of a tick at the given rate.
+     */
+
+    const TickScheduler scheduler{ 50, std::chrono::microseconds{ 0 } };
+
+    CLOVE_FLOAT_EQ(0.02f, static_cast<float>(scheduler.GetFixedDeltaTime()));
+}
+
+// Test 2
+CLOVE_TEST(TestWaitsForDeadline)
+{
+    /**
+     * This test ensures that a tick which is on time is run once, and not before its deadline.
+     */
+
+    TickScheduler scheduler{ 100, std::chrono::microseconds{ 200 } };
+
+    const auto start = std::chrono::steady_clock::now();
+    scheduler.Start();
+
+    CLOVE_INT_EQ(1, scheduler.WaitForNextTick());
+    CLOVE_IS_TRUE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds{ 10 });
+}
+
+// Test 3
+CLOVE_TEST(TestCatchesUpAfterOverrun)
+{
+    /**
+     * This test ensures that the ticks missed by an overrun are run by the next wait, and that
+     * the following tick is due on its original deadline.
+     */
+
+    TickScheduler scheduler{ 20, std::chrono::microseconds{ 0 } };
+    scheduler.Start();
+
+    // Overrun by a little more than two ticks.
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 160 });
+
+    CLOVE_INT_EQ(3, scheduler.WaitForNextTick());
+    CLOVE_IS_TRUE(scheduler.GetLateness() >= std::chrono::milliseconds{ 100 });
+    CLOVE_INT_EQ(1, scheduler.WaitForNextTick());
+}
+
+// Test 4
+CLOVE_TEST(TestCatchUpIsBounded)
+{
+    /**
+     * This test ensures that no more than the maximum number of ticks are run after a long
+     * overrun, and that the rest are skipped.
+     */
+
+    TickScheduler scheduler{ 100, std::chrono::microseconds{ 0 } };
+    scheduler.Start();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 200 });
+
+    CLOVE_INT_EQ(MAX_CATCH_UP_TICKS, scheduler.WaitForNextTick());
+    CLOVE_IS_TRUE(scheduler.GetSkippedTicks() > 0);
+    CLOVE_INT_EQ(1, scheduler.WaitForNextTick());
+}